@@ -40,7 +40,8 @@ void BoxSceneNode::OnComputeStyle() {
   }
 
   if (release) {
-    this->backgroundImage = ImageManager::SafeRelease(this->GetImageManager(), this->backgroundImage, this);
+    this->backgroundImage = ImageManager::SafeRelease(
+        this->GetImageManager(), this->backgroundImage, this, this->scene.Get());
   }
 
   if (acquire) {
@@ -48,6 +49,7 @@ void BoxSceneNode::OnComputeStyle() {
         this->GetImageManager(),
         {boxStyle->GetString(StyleProperty::backgroundImage)},
         this,
+        this->scene.Get(),
         &BoxSceneNode::ImageStatusListener);
   }
 
@@ -122,7 +124,8 @@ void BoxSceneNode::OnFlexBoxLayoutChanged() {
 }
 
 void BoxSceneNode::OnDestroy() {
-  this->backgroundImage = ImageManager::SafeRelease(this->GetImageManager(), this->backgroundImage, this);
+  this->backgroundImage = ImageManager::SafeRelease(
+      this->GetImageManager(), this->backgroundImage, this, this->scene.Get());
 }
 
 void BoxSceneNode::ImageStatusListener(void* owner, Image* image) noexcept {
@@ -29,6 +29,7 @@ class BoxSceneNode final : public SceneNode {
   void OnFlexBoxLayoutChanged() override;
   void OnComputeStyle() override;
   void OnComposite(CompositeContext* ctx) override;
+  bool IsLayoutOnlyCandidate() const noexcept override { return true; }
   void OnDestroy() override;
 
  private:
@@ -0,0 +1,843 @@
+/*
+ * Copyright (c) 2021 Light Source Software, LLC. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on
+ * an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the
+ * specific language governing permissions and limitations under the License.
+ */
+
+#include <lse/CanvasSceneNode.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <stdexcept>
+#include <std20/numbers>
+#include <nanoctx.h>
+#include <lse/Image.h>
+#include <lse/ImageManager.h>
+#include <lse/Scene.h>
+#include <lse/Style.h>
+#include <lse/CompositeContext.h>
+#include <lse/Renderer.h>
+#include <lse/PixelConversion.h>
+
+namespace lse {
+
+static constexpr std::array<int32_t, CanvasCommandCount> kCommandArgCount{{
+  0, // CanvasCommandBeginPath
+  0, // CanvasCommandClosePath
+  2, // CanvasCommandMoveTo
+  2, // CanvasCommandLineTo
+  6, // CanvasCommandBezierCurveTo
+  4, // CanvasCommandQuadraticCurveTo
+  6, // CanvasCommandArc
+  4, // CanvasCommandRect
+  1, // CanvasCommandFill
+  0, // CanvasCommandStroke
+  4, // CanvasCommandFillRect
+  4, // CanvasCommandStrokeRect
+  9, // CanvasCommandDrawImage
+  1, // CanvasCommandSetFillStyle
+  1, // CanvasCommandSetStrokeStyle
+  1, // CanvasCommandSetLineWidth
+  1, // CanvasCommandSetLineCap
+  1, // CanvasCommandSetLineJoin
+  1, // CanvasCommandSetMiterLimit
+  1, // CanvasCommandSetGlobalAlpha
+  0, // CanvasCommandSave
+  0, // CanvasCommandRestore
+  2, // CanvasCommandTranslate
+  1, // CanvasCommandRotate
+  2, // CanvasCommandScale
+  6, // CanvasCommandTransform
+  6, // CanvasCommandSetTransform
+}};
+
+static bool IsIntegral(double value) noexcept {
+  return std::isfinite(value) && std::trunc(value) == value;
+}
+
+/**
+ * Replays a canvas command list into nanosvg shapes.
+ *
+ * Points are transformed when they are added to the path (same as the canvas spec), so the nanosvg transform is
+ * always identity.
+ */
+class CanvasPathRasterizer {
+ public:
+  struct State {
+    // affine transform [a b c d e f]: x' = a*x + c*y + e, y' = b*x + d*y + f
+    std::array<float, 6> transform{{1, 0, 0, 1, 0, 0}};
+    color_t fillStyle{ColorBlack};
+    color_t strokeStyle{ColorBlack};
+    float lineWidth{1};
+    int32_t lineCap{};
+    int32_t lineJoin{};
+    float miterLimit{10};
+    float globalAlpha{1};
+  };
+
+  struct Subpath {
+    // nanosvg cubic layout: start point, followed by (cp1, cp2, end) point triples
+    std::vector<float> points{};
+    bool closed{};
+  };
+
+ public:
+  CanvasPathRasterizer(int32_t width, int32_t height) noexcept : width(width), height(height) {}
+
+  ~CanvasPathRasterizer() noexcept {
+    nctx_delete(this->ctx);
+  }
+
+  State& GetState() noexcept { return this->state; }
+
+  void Save() {
+    this->stack.push_back(this->state);
+  }
+
+  void Restore() {
+    if (!this->stack.empty()) {
+      this->state = this->stack.back();
+      this->stack.pop_back();
+    }
+  }
+
+  void Transform(float a, float b, float c, float d, float e, float f) noexcept {
+    const auto& t{this->state.transform};
+
+    this->state.transform = {{
+      t[0] * a + t[2] * b,
+      t[1] * a + t[3] * b,
+      t[0] * c + t[2] * d,
+      t[1] * c + t[3] * d,
+      t[0] * e + t[2] * f + t[4],
+      t[1] * e + t[3] * f + t[5]
+    }};
+  }
+
+  void BeginPath() noexcept {
+    this->path.clear();
+  }
+
+  void ClosePath() {
+    if (this->path.empty() || this->path.back().points.size() < 2) {
+      return;
+    }
+
+    auto& subpath{this->path.back()};
+
+    subpath.closed = true;
+    this->path.push_back({{subpath.points[0], subpath.points[1]}, false});
+  }
+
+  void MoveTo(float x, float y) {
+    this->path.emplace_back();
+    this->AddPoint(x, y);
+  }
+
+  void LineTo(float x, float y) {
+    if (this->path.empty()) {
+      this->MoveTo(x, y);
+      return;
+    }
+
+    float px, py;
+
+    this->CurrentPoint(px, py);
+    this->ToCanvas(x, y);
+
+    const auto dx{x - px};
+    const auto dy{y - py};
+    auto& points{this->path.back().points};
+
+    points.insert(points.end(), { px + dx / 3.f, py + dy / 3.f, x - dx / 3.f, y - dy / 3.f, x, y });
+  }
+
+  void BezierCurveTo(float cp1x, float cp1y, float cp2x, float cp2y, float x, float y) {
+    if (this->path.empty()) {
+      this->MoveTo(cp1x, cp1y);
+    }
+
+    this->AddPoint(cp1x, cp1y);
+    this->AddPoint(cp2x, cp2y);
+    this->AddPoint(x, y);
+  }
+
+  void QuadraticCurveTo(float cpx, float cpy, float x, float y) {
+    if (this->path.empty()) {
+      this->MoveTo(cpx, cpy);
+    }
+
+    float px, py;
+
+    // elevate to a cubic in canvas space. affine transforms preserve the control point relationship.
+    this->CurrentPoint(px, py);
+    this->ToCanvas(cpx, cpy);
+    this->ToCanvas(x, y);
+
+    auto& points{this->path.back().points};
+
+    points.insert(points.end(), {
+      px + (2.f / 3.f) * (cpx - px), py + (2.f / 3.f) * (cpy - py),
+      x + (2.f / 3.f) * (cpx - x), y + (2.f / 3.f) * (cpy - y),
+      x, y
+    });
+  }
+
+  void Arc(float cx, float cy, float radius, float startAngle, float endAngle, bool counterclockwise) {
+    constexpr auto kTwoPi{2.f * std20::pi_v<float>};
+    constexpr auto kHalfPi{std20::pi_v<float> / 2.f};
+
+    if (radius < 0) {
+      return;
+    }
+
+    auto sweep{endAngle - startAngle};
+
+    if (!counterclockwise) {
+      sweep = (sweep >= kTwoPi) ? kTwoPi : std::fmod(sweep, kTwoPi);
+      if (sweep < 0) {
+        sweep += kTwoPi;
+      }
+    } else {
+      sweep = (sweep <= -kTwoPi) ? -kTwoPi : std::fmod(sweep, kTwoPi);
+      if (sweep > 0) {
+        sweep -= kTwoPi;
+      }
+    }
+
+    const auto startX{cx + radius * std::cos(startAngle)};
+    const auto startY{cy + radius * std::sin(startAngle)};
+
+    if (this->path.empty()) {
+      this->MoveTo(startX, startY);
+    } else {
+      this->LineTo(startX, startY);
+    }
+
+    // approximate with at most 90 degree cubic segments
+    const auto segments{std::max(1, static_cast<int32_t>(std::ceil(std::fabs(sweep) / kHalfPi - 0.001f)))};
+    const auto step{sweep / static_cast<float>(segments)};
+    const auto k{(4.f / 3.f) * std::tan(step / 4.f) * radius};
+    auto angle{startAngle};
+
+    for (int32_t i = 0; i < segments; i++) {
+      const auto cos0{std::cos(angle)};
+      const auto sin0{std::sin(angle)};
+      const auto cos1{std::cos(angle + step)};
+      const auto sin1{std::sin(angle + step)};
+
+      this->BezierCurveTo(
+          cx + radius * cos0 - k * sin0, cy + radius * sin0 + k * cos0,
+          cx + radius * cos1 + k * sin1, cy + radius * sin1 - k * cos1,
+          cx + radius * cos1, cy + radius * sin1);
+
+      angle += step;
+    }
+  }
+
+  void Rect(float x, float y, float w, float h) {
+    this->MoveTo(x, y);
+    this->LineTo(x + w, y);
+    this->LineTo(x + w, y + h);
+    this->LineTo(x, y + h);
+    this->ClosePath();
+  }
+
+  void Fill(int32_t fillRule) {
+    this->EmitPath(this->path);
+    this->FillShape(fillRule);
+  }
+
+  void Stroke() {
+    this->EmitPath(this->path);
+    this->StrokeShape();
+  }
+
+  void FillRect(float x, float y, float w, float h) {
+    this->WithRectPath(x, y, w, h, [this]() { this->FillShape(0); });
+  }
+
+  void StrokeRect(float x, float y, float w, float h) {
+    this->WithRectPath(x, y, w, h, [this]() { this->StrokeShape(); });
+  }
+
+  bool IsEmpty() const noexcept {
+    return this->shapeCount == 0;
+  }
+
+  // Rasterize all shapes added since the last Render() into a RGBA pixel buffer.
+  void Render(uint8_t* pixels, int32_t stride) noexcept {
+    if (this->ctx && pixels) {
+      nctx_render(this->ctx, pixels, this->width, this->height, stride);
+    }
+
+    nctx_delete(this->ctx);
+    this->ctx = nullptr;
+
+    this->shapeCount = 0;
+  }
+
+ private:
+  void AddPoint(float x, float y) {
+    this->ToCanvas(x, y);
+    this->path.back().points.insert(this->path.back().points.end(), { x, y });
+  }
+
+  void CurrentPoint(float& x, float& y) const noexcept {
+    const auto& points{this->path.back().points};
+
+    x = points[points.size() - 2];
+    y = points[points.size() - 1];
+  }
+
+  void ToCanvas(float& x, float& y) const noexcept {
+    const auto& t{this->state.transform};
+    const auto tx{t[0] * x + t[2] * y + t[4]};
+
+    y = t[1] * x + t[3] * y + t[5];
+    x = tx;
+  }
+
+  template<typename Callable>
+  void WithRectPath(float x, float y, float w, float h, const Callable& draw) {
+    // fillRect and strokeRect do not modify the current path
+    std::vector<Subpath> saved;
+
+    saved.swap(this->path);
+    this->Rect(x, y, w, h);
+    this->EmitPath(this->path);
+    draw();
+    this->path.swap(saved);
+  }
+
+  bool EnsureContext() noexcept {
+    if (!this->ctx) {
+      this->ctx = nctx_new(this->width, this->height);
+    }
+
+    return this->ctx != nullptr;
+  }
+
+  void EmitPath(const std::vector<Subpath>& subpaths) noexcept {
+    if (!this->EnsureContext()) {
+      return;
+    }
+
+    for (const auto& subpath : subpaths) {
+      const auto& p{subpath.points};
+
+      // a drawable sub-path has a start point and at least one segment
+      if (p.size() < 8) {
+        continue;
+      }
+
+      nctx_begin_path(this->ctx);
+      nctx_move_to(this->ctx, p[0], p[1]);
+
+      for (std::size_t i = 2; i + 5 < p.size(); i += 6) {
+        nctx_cubic_bezier_to(this->ctx, p[i], p[i + 1], p[i + 2], p[i + 3], p[i + 4], p[i + 5]);
+      }
+
+      if (subpath.closed) {
+        nctx_close_path(this->ctx);
+      } else {
+        nctx_end_path(this->ctx);
+      }
+    }
+  }
+
+  void FillShape(int32_t fillRule) noexcept {
+    if (!this->ctx) {
+      return;
+    }
+
+    nctx_set_fill_color(this->ctx, ToNanoSvgColor(this->state.fillStyle));
+    nctx_set_fill_opacity(this->ctx, ToNanoSvgOpacity(this->state.fillStyle));
+    nctx_set_fill_rule(this->ctx, fillRule);
+    nctx_fill(this->ctx);
+    this->shapeCount++;
+  }
+
+  void StrokeShape() noexcept {
+    if (!this->ctx) {
+      return;
+    }
+
+    const auto& t{this->state.transform};
+    // line width scales with the transform. use the average scale, like nanosvg does for svg transforms.
+    const auto scale{std::sqrt(std::fabs(t[0] * t[3] - t[1] * t[2]))};
+
+    nctx_set_stroke_color(this->ctx, ToNanoSvgColor(this->state.strokeStyle));
+    nctx_set_stroke_opacity(this->ctx, ToNanoSvgOpacity(this->state.strokeStyle));
+    nctx_set_stroke_width(this->ctx, this->state.lineWidth * scale);
+    nctx_set_stroke_line_cap(this->ctx, this->state.lineCap);
+    nctx_set_stroke_line_join(this->ctx, this->state.lineJoin);
+    nctx_set_stroke_miter_limit(this->ctx, this->state.miterLimit);
+    nctx_stroke(this->ctx);
+    this->shapeCount++;
+  }
+
+  // nanosvg colors are 0xBBGGRR
+  static uint32_t ToNanoSvgColor(color_t color) noexcept {
+    return color.r | (color.g << 8u) | (color.b << 16u);
+  }
+
+  float ToNanoSvgOpacity(color_t color) const noexcept {
+    return (static_cast<float>(color.a) / 255.f) * this->state.globalAlpha;
+  }
+
+ private:
+  int32_t width{};
+  int32_t height{};
+  nctx ctx{};
+  int32_t shapeCount{};
+  State state{};
+  std::vector<State> stack{};
+  std::vector<Subpath> path{};
+};
+
+CanvasSceneNode::CanvasSceneNode(Scene* scene) : SceneNode(scene) {
+}
+
+int32_t CanvasSceneNode::GetCommandArgCount(CanvasCommand command) noexcept {
+  if (command < 0 || command >= CanvasCommandCount) {
+    return -1;
+  }
+
+  return kCommandArgCount[command];
+}
+
+void CanvasSceneNode::SetCommands(const double* commands, std::size_t length, std::vector<std::string>&& imageUris) {
+  std::size_t i{0};
+
+  while (i < length) {
+    // Range check before the cast: converting NaN or an out of range double to an integer is undefined.
+    if (!IsIntegral(commands[i]) || commands[i] < 0 || commands[i] >= CanvasCommandCount) {
+      throw std::runtime_error("malformed canvas command list");
+    }
+
+    const auto command{static_cast<int32_t>(commands[i])};
+    const auto argCount{GetCommandArgCount(static_cast<CanvasCommand>(command))};
+
+    if (argCount < 0 || i + 1 + argCount > length) {
+      throw std::runtime_error("malformed canvas command list");
+    }
+
+    for (std::size_t a = i + 1; a <= i + argCount; a++) {
+      if (!std::isfinite(commands[a])) {
+        throw std::runtime_error("canvas command list contains a non-finite value");
+      }
+    }
+
+    switch (command) {
+      case CanvasCommandDrawImage:
+        if (!IsIntegral(commands[i + 1]) || commands[i + 1] < 0
+            || commands[i + 1] >= static_cast<double>(imageUris.size())) {
+          throw std::runtime_error("drawImage references an invalid image");
+        }
+        break;
+      case CanvasCommandSetFillStyle:
+      case CanvasCommandSetStrokeStyle:
+        // Colors are cast to uint32 and enums to int32 when the list is replayed.
+        if (!IsIntegral(commands[i + 1]) || commands[i + 1] < 0 || commands[i + 1] > UINT32_MAX) {
+          throw std::runtime_error("malformed canvas command list");
+        }
+        break;
+      case CanvasCommandFill:
+      case CanvasCommandSetLineCap:
+      case CanvasCommandSetLineJoin:
+        if (!IsIntegral(commands[i + 1]) || commands[i + 1] < 0 || commands[i + 1] > INT32_MAX) {
+          throw std::runtime_error("malformed canvas command list");
+        }
+        break;
+      default:
+        break;
+    }
+
+    i += 1 + argCount;
+  }
+
+  for (auto uri{imageUris.cbegin()}; uri != imageUris.cend(); uri++) {
+    if (std::find(imageUris.cbegin(), uri, *uri) != uri) {
+      throw std::runtime_error("duplicate image uri in canvas command list");
+    }
+  }
+
+  // Acquire the new images. Images that were already referenced by the previous drawing are moved over, so they are
+  // not released (and possibly reloaded).
+  std::vector<Image*> nextImages;
+
+  nextImages.reserve(imageUris.size());
+
+  for (const auto& uri : imageUris) {
+    auto p{std::find_if(this->images.begin(), this->images.end(), [&uri](Image* image) {
+      return image && image->GetRequest().uri == uri;
+    })};
+
+    if (p != this->images.end()) {
+      nextImages.push_back(*p);
+      *p = nullptr;
+    } else {
+      nextImages.push_back(ImageManager::SafeAcquire(
+          this->GetImageManager(), { uri }, this, this->scene.Get(), &CanvasSceneNode::ImageStatusListener));
+    }
+  }
+
+  this->ReleaseImages();
+  this->images.swap(nextImages);
+  this->commands.assign(commands, commands + length);
+  this->isRasterDirty = true;
+  this->RequestPaint();
+  this->MarkCompositeDirty();
+}
+
+void CanvasSceneNode::ClearCommands() noexcept {
+  this->commands.clear();
+  this->layers.clear();
+  this->ReleaseImages();
+  this->DestroySurfaces();
+  this->isRasterDirty = false;
+  this->MarkCompositeDirty();
+}
+
+std::size_t CanvasSceneNode::GetCommandCount() const noexcept {
+  return this->commands.size();
+}
+
+void CanvasSceneNode::OnStylePropertyChanged(StyleProperty property) {
+  switch (property) {
+    case StyleProperty::backgroundColor:
+    case StyleProperty::borderColor:
+      this->MarkCompositeDirty();
+      break;
+    default:
+      SceneNode::OnStylePropertyChanged(property);
+      break;
+  }
+}
+
+void CanvasSceneNode::OnFlexBoxLayoutChanged() {
+  const auto width{static_cast<int32_t>(std::ceil(YGNodeLayoutGetWidth(this->ygNode)))};
+  const auto height{static_cast<int32_t>(std::ceil(YGNodeLayoutGetHeight(this->ygNode)))};
+
+  if (width != this->rasterWidth || height != this->rasterHeight) {
+    this->isRasterDirty = !this->commands.empty();
+  }
+
+  if (this->isRasterDirty) {
+    this->RequestPaint();
+  }
+
+  this->MarkCompositeDirty();
+}
+
+void CanvasSceneNode::OnPaint(Renderer* renderer) {
+  if (this->isRasterDirty) {
+    this->Rasterize(renderer);
+  }
+}
+
+void CanvasSceneNode::OnComposite(CompositeContext* ctx) {
+  this->DrawBackground(ctx, StyleBackgroundClipBorderBox);
+
+  const auto x{ctx->CurrentMatrix().GetTranslateX()};
+  const auto y{ctx->CurrentMatrix().GetTranslateY()};
+  const auto opacity{ctx->CurrentOpacity()};
+
+  for (const auto& layer : this->layers) {
+    if (layer.texture) {
+      ctx->renderer->DrawImage(
+          { x, y, static_cast<float>(this->rasterWidth), static_cast<float>(this->rasterHeight) },
+          { 0, 0, this->rasterWidth, this->rasterHeight },
+          layer.texture,
+          RenderFilter::OfTint(ColorWhite, opacity));
+    } else if (Image::SafeIsReady(layer.image)) {
+      this->DrawImageLayer(ctx, layer, x, y);
+    }
+  }
+
+  this->DrawBorder(ctx);
+}
+
+void CanvasSceneNode::OnAttach() {
+  if (this->isRasterDirty) {
+    this->RequestPaint();
+  }
+}
+
+void CanvasSceneNode::OnDetach() {
+  // textures belong to the renderer. rasterize again on the next paint after attach.
+  this->layers.clear();
+  this->DestroySurfaces();
+  this->isRasterDirty = !this->commands.empty();
+}
+
+void CanvasSceneNode::OnDestroy() {
+  this->commands.clear();
+  this->layers.clear();
+  this->ReleaseImages();
+  this->DestroySurfaces();
+}
+
+void CanvasSceneNode::Rasterize(Renderer* renderer) {
+  this->rasterWidth = static_cast<int32_t>(std::ceil(YGNodeLayoutGetWidth(this->ygNode)));
+  this->rasterHeight = static_cast<int32_t>(std::ceil(YGNodeLayoutGetHeight(this->ygNode)));
+  this->isRasterDirty = false;
+  this->layers.clear();
+
+  const auto hasSurface{this->rasterWidth > 0 && this->rasterHeight > 0};
+  CanvasPathRasterizer rasterizer(this->rasterWidth, this->rasterHeight);
+  auto& state{rasterizer.GetState()};
+  std::size_t surfaceCount{0};
+  const auto flush = [&]() {
+    if (rasterizer.IsEmpty()) {
+      return;
+    }
+
+    auto surface{this->AcquireSurface(renderer, surfaceCount)};
+    TextureLock lock(surface);
+
+    if (lock.IsLocked()) {
+      const auto pixels{lock.GetPixels()};
+      const auto pitch{surface->Pitch()};
+      const auto width{surface->Width()};
+      const auto height{surface->Height()};
+
+      rasterizer.Render(pixels, pitch);
+
+      // Rows can be padded, so convert row by row.
+      for (int32_t y = 0; y < height; y++) {
+        const auto row{reinterpret_cast<color_t*>(pixels + y * pitch)};
+
+        PremultiplyAlpha(row, width);
+        ConvertToFormat(row, width, surface->Format());
+      }
+
+      this->layers.push_back({ surface });
+      surfaceCount++;
+    } else {
+      rasterizer.Render(nullptr, 0);
+    }
+  };
+  const auto f = [this](std::size_t index) { return static_cast<float>(this->commands[index]); };
+  std::size_t i{0};
+
+  while (i < this->commands.size()) {
+    const auto command{static_cast<CanvasCommand>(this->commands[i])};
+    const auto a{i + 1};
+
+    switch (command) {
+      case CanvasCommandBeginPath:
+        rasterizer.BeginPath();
+        break;
+      case CanvasCommandClosePath:
+        rasterizer.ClosePath();
+        break;
+      case CanvasCommandMoveTo:
+        rasterizer.MoveTo(f(a), f(a + 1));
+        break;
+      case CanvasCommandLineTo:
+        rasterizer.LineTo(f(a), f(a + 1));
+        break;
+      case CanvasCommandBezierCurveTo:
+        rasterizer.BezierCurveTo(f(a), f(a + 1), f(a + 2), f(a + 3), f(a + 4), f(a + 5));
+        break;
+      case CanvasCommandQuadraticCurveTo:
+        rasterizer.QuadraticCurveTo(f(a), f(a + 1), f(a + 2), f(a + 3));
+        break;
+      case CanvasCommandArc:
+        rasterizer.Arc(f(a), f(a + 1), f(a + 2), f(a + 3), f(a + 4), this->commands[a + 5] != 0);
+        break;
+      case CanvasCommandRect:
+        rasterizer.Rect(f(a), f(a + 1), f(a + 2), f(a + 3));
+        break;
+      case CanvasCommandFill:
+        if (hasSurface) {
+          rasterizer.Fill(static_cast<int32_t>(this->commands[a]));
+        }
+        break;
+      case CanvasCommandStroke:
+        if (hasSurface) {
+          rasterizer.Stroke();
+        }
+        break;
+      case CanvasCommandFillRect:
+        if (hasSurface) {
+          rasterizer.FillRect(f(a), f(a + 1), f(a + 2), f(a + 3));
+        }
+        break;
+      case CanvasCommandStrokeRect:
+        if (hasSurface) {
+          rasterizer.StrokeRect(f(a), f(a + 1), f(a + 2), f(a + 3));
+        }
+        break;
+      case CanvasCommandDrawImage: {
+        auto image{this->images[static_cast<std::size_t>(this->commands[a])]};
+
+        if (image) {
+          const auto& t{state.transform};
+
+          flush();
+
+          // images are drawn by the renderer, so only the scale and translate parts of the transform are applied
+          this->layers.push_back({
+            nullptr,
+            image,
+            { f(a + 1), f(a + 2), f(a + 3), f(a + 4) },
+            { f(a + 5), f(a + 6), f(a + 7), f(a + 8) },
+            t[0],
+            t[3],
+            t[4],
+            t[5],
+            state.globalAlpha
+          });
+        }
+        break;
+      }
+      case CanvasCommandSetFillStyle:
+        state.fillStyle = static_cast<uint32_t>(this->commands[a]);
+        break;
+      case CanvasCommandSetStrokeStyle:
+        state.strokeStyle = static_cast<uint32_t>(this->commands[a]);
+        break;
+      case CanvasCommandSetLineWidth:
+        if (this->commands[a] > 0) {
+          state.lineWidth = f(a);
+        }
+        break;
+      case CanvasCommandSetLineCap:
+        state.lineCap = static_cast<int32_t>(this->commands[a]);
+        break;
+      case CanvasCommandSetLineJoin:
+        state.lineJoin = static_cast<int32_t>(this->commands[a]);
+        break;
+      case CanvasCommandSetMiterLimit:
+        if (this->commands[a] > 0) {
+          state.miterLimit = f(a);
+        }
+        break;
+      case CanvasCommandSetGlobalAlpha:
+        if (this->commands[a] >= 0 && this->commands[a] <= 1) {
+          state.globalAlpha = f(a);
+        }
+        break;
+      case CanvasCommandSave:
+        rasterizer.Save();
+        break;
+      case CanvasCommandRestore:
+        rasterizer.Restore();
+        break;
+      case CanvasCommandTranslate:
+        rasterizer.Transform(1, 0, 0, 1, f(a), f(a + 1));
+        break;
+      case CanvasCommandRotate:
+        rasterizer.Transform(std::cos(f(a)), std::sin(f(a)), -std::sin(f(a)), std::cos(f(a)), 0, 0);
+        break;
+      case CanvasCommandScale:
+        rasterizer.Transform(f(a), 0, 0, f(a + 1), 0, 0);
+        break;
+      case CanvasCommandTransform:
+        rasterizer.Transform(f(a), f(a + 1), f(a + 2), f(a + 3), f(a + 4), f(a + 5));
+        break;
+      case CanvasCommandSetTransform:
+        state.transform = {{ f(a), f(a + 1), f(a + 2), f(a + 3), f(a + 4), f(a + 5) }};
+        break;
+      default:
+        break;
+    }
+
+    i = a + kCommandArgCount[command];
+  }
+
+  flush();
+
+  // release surfaces that are no longer used by this drawing
+  while (this->surfaces.size() > surfaceCount) {
+    Texture::SafeDestroy(this->surfaces.back());
+    this->surfaces.pop_back();
+  }
+}
+
+Texture* CanvasSceneNode::AcquireSurface(Renderer* renderer, std::size_t index) {
+  if (index < this->surfaces.size()) {
+    auto surface{this->surfaces[index]};
+
+    if (surface && surface->Width() == this->rasterWidth && surface->Height() == this->rasterHeight) {
+      return surface;
+    }
+
+    Texture::SafeDestroy(surface);
+    this->surfaces[index] = renderer->CreateTexture(this->rasterWidth, this->rasterHeight, Texture::Lockable);
+
+    return this->surfaces[index];
+  }
+
+  this->surfaces.push_back(renderer->CreateTexture(this->rasterWidth, this->rasterHeight, Texture::Lockable));
+
+  return this->surfaces.back();
+}
+
+void CanvasSceneNode::DrawImageLayer(CompositeContext* ctx, const Layer& layer, float x, float y) const noexcept {
+  auto image{layer.image};
+  auto src{layer.src.width < 0 ? Rect{ 0, 0, image->WidthF(), image->HeightF() } : layer.src};
+  auto dest{layer.dest};
+
+  if (dest.width < 0) {
+    dest.width = src.width;
+    dest.height = src.height;
+  }
+
+  ctx->renderer->DrawImage(
+      {
+        x + layer.translateX + dest.x * layer.scaleX,
+        y + layer.translateY + dest.y * layer.scaleY,
+        dest.width * layer.scaleX,
+        dest.height * layer.scaleY
+      },
+      {
+        static_cast<int32_t>(src.x),
+        static_cast<int32_t>(src.y),
+        static_cast<int32_t>(src.width),
+        static_cast<int32_t>(src.height)
+      },
+      image->GetTexture(),
+      RenderFilter::OfTint(ColorWhite, ctx->CurrentOpacity() * layer.alpha));
+}
+
+void CanvasSceneNode::DestroySurfaces() noexcept {
+  for (auto surface : this->surfaces) {
+    Texture::SafeDestroy(surface);
+  }
+
+  this->surfaces.clear();
+}
+
+void CanvasSceneNode::ReleaseImages() noexcept {
+  for (auto image : this->images) {
+    ImageManager::SafeRelease(this->GetImageManager(), image, this, this->scene.Get());
+  }
+
+  this->images.clear();
+}
+
+void CanvasSceneNode::ImageStatusListener(void* owner, Image* image) noexcept {
+  switch (image->GetState()) {
+    case ImageState::Ready:
+    case ImageState::Error:
+      image->RemoveListener(owner);
+      static_cast<CanvasSceneNode*>(owner)->MarkCompositeDirty();
+      break;
+    default:
+      break;
+  }
+}
+
+} // namespace lse
@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) 2021 Light Source Software, LLC. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on
+ * an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the
+ * specific language governing permissions and limitations under the License.
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <lse/Rect.h>
+#include <lse/SceneNode.h>
+
+namespace lse {
+
+class Image;
+
+/**
+ * Drawing commands of a CanvasSceneNode. In the command buffer, each command is followed by a fixed number of
+ * arguments (see CanvasSceneNode::GetCommandArgCount()).
+ */
+enum CanvasCommand : int32_t {
+  CanvasCommandBeginPath,
+  CanvasCommandClosePath,
+  CanvasCommandMoveTo,
+  CanvasCommandLineTo,
+  CanvasCommandBezierCurveTo,
+  CanvasCommandQuadraticCurveTo,
+  CanvasCommandArc,
+  CanvasCommandRect,
+  CanvasCommandFill,
+  CanvasCommandStroke,
+  CanvasCommandFillRect,
+  CanvasCommandStrokeRect,
+  CanvasCommandDrawImage,
+  CanvasCommandSetFillStyle,
+  CanvasCommandSetStrokeStyle,
+  CanvasCommandSetLineWidth,
+  CanvasCommandSetLineCap,
+  CanvasCommandSetLineJoin,
+  CanvasCommandSetMiterLimit,
+  CanvasCommandSetGlobalAlpha,
+  CanvasCommandSave,
+  CanvasCommandRestore,
+  CanvasCommandTranslate,
+  CanvasCommandRotate,
+  CanvasCommandScale,
+  CanvasCommandTransform,
+  CanvasCommandSetTransform,
+  CanvasCommandCount
+};
+
+/**
+ * Scene node that draws a retained list of Canvas 2D style drawing commands.
+ *
+ * The command list is recorded in javascript and set in a single call. Paths are rasterized on the CPU (nanosvg) into
+ * textures only when the command list or the node size changes; otherwise, compositing just draws the cached
+ * textures. drawImage commands split the command list into layers, so images keep their order relative to paths.
+ */
+class CanvasSceneNode final : public SceneNode {
+ public:
+  explicit CanvasSceneNode(Scene* scene);
+  ~CanvasSceneNode() override = default;
+
+  bool IsLeaf() const noexcept override { return true; }
+
+  /**
+   * Replace the drawing with a new command list.
+   *
+   * @param commands Flat list of CanvasCommand values, each followed by its arguments.
+   * @param length Number of values in commands.
+   * @param imageUris Image uris referenced, by index, in CanvasCommandDrawImage commands.
+   * @throws std::runtime_error if the command list is malformed
+   */
+  void SetCommands(const double* commands, std::size_t length, std::vector<std::string>&& imageUris);
+  void ClearCommands() noexcept;
+  std::size_t GetCommandCount() const noexcept;
+
+  void OnStylePropertyChanged(StyleProperty property) override;
+  void OnFlexBoxLayoutChanged() override;
+  void OnComposite(CompositeContext* ctx) override;
+  void OnPaint(Renderer* renderer) override;
+  void OnAttach() override;
+  void OnDetach() override;
+  void OnDestroy() override;
+
+  static int32_t GetCommandArgCount(CanvasCommand command) noexcept;
+
+ private:
+  // Output of rasterization. Either a texture containing a run of path commands or an image draw.
+  struct Layer {
+    Texture* texture{};
+    Image* image{};
+    // source rect in image pixels. negative width means the whole image.
+    Rect src{};
+    // destination rect in canvas coordinates. negative width means the natural size of the image.
+    Rect dest{};
+    float scaleX{1.f};
+    float scaleY{1.f};
+    float translateX{};
+    float translateY{};
+    float alpha{1.f};
+  };
+
+  void Rasterize(Renderer* renderer);
+  Texture* AcquireSurface(Renderer* renderer, std::size_t index);
+  void DrawImageLayer(CompositeContext* ctx, const Layer& layer, float x, float y) const noexcept;
+  void DestroySurfaces() noexcept;
+  void ReleaseImages() noexcept;
+  static void ImageStatusListener(void* owner, Image* image) noexcept;
+
+ private:
+  std::vector<double> commands{};
+  std::vector<Image*> images{};
+  std::vector<Layer> layers{};
+  std::vector<Texture*> surfaces{};
+  int32_t rasterWidth{};
+  int32_t rasterHeight{};
+  bool isRasterDirty{};
+};
+
+} // namespace lse
@@ -44,6 +44,11 @@ static constexpr std::array<const char*, 5> kImageExtensions{{
 
 namespace lse {
 
+// stb reports the channel count of the source file: 1 (grey), 2 (grey, alpha), 3 (rgb) or 4 (rgba).
+static bool HasAlphaChannel(int32_t components) noexcept {
+  return components == 2 || components == 4;
+}
+
 bool ScaleSvg(
     NSVGimagePtr& svg, int32_t scaleWidth, int32_t scaleHeight,
     float* scaleX, float* scaleY, int32_t* renderWidth, int32_t* renderHeight) noexcept {
@@ -145,6 +150,7 @@ ImageBytes DecodeImageFromFile(const std17::filesystem::path& path, int32_t resi
   ImageBytes::Deleter deleter;
   int32_t width{};
   int32_t height{};
+  bool isOpaque{};
 
   if (EndsWith(path.c_str(), ".*")) {
     // Handle the '.*' extension search recursively.
@@ -180,9 +186,10 @@ ImageBytes DecodeImageFromFile(const std17::filesystem::path& path, int32_t resi
     }
 
     deleter = &DeleteStbBytes;
+    isOpaque = !HasAlphaChannel(components);
   }
 
-  return { bytes, deleter, width, height, width * 4 };
+  return { bytes, deleter, width, height, width * 4, isOpaque };
 }
 
 std::shared_ptr<unsigned char> DecodeBase64DataUri(const char* rawBase64, size_t* decodedLen = nullptr) {
@@ -204,6 +211,7 @@ ImageBytes DecodeImageFromDataUri(const std::string& uri, int32_t resizeWidth, i
   ImageBytes::Deleter deleter;
   int32_t width{};
   int32_t height{};
+  bool isOpaque{};
 
   if (StartsWith(uri, kDataUriSvgUtf8) && uri.size() > kDataUriSvgUtf8Len) {
     auto xml{ uri.substr(kDataUriSvgUtf8Len) };
@@ -230,11 +238,12 @@ ImageBytes DecodeImageFromDataUri(const std::string& uri, int32_t resizeWidth, i
     }
 
     deleter = &DeleteStbBytes;
+    isOpaque = !HasAlphaChannel(components);
   } else {
     throw std::runtime_error(Format("Unsupported data uri: %s", uri));
   }
 
-  return { bytes, deleter, width, height, width * 4 };
+  return { bytes, deleter, width, height, width * 4, isOpaque };
 }
 
 } // namespace lse
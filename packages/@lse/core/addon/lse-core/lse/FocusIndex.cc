@@ -0,0 +1,264 @@
+/*
+ * Copyright (c) 2021 Light Source Software, LLC. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on
+ * an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the
+ * specific language governing permissions and limitations under the License.
+ */
+
+#include <lse/FocusIndex.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <std17/algorithm>
+
+namespace lse {
+
+// Layout rects of adjacent nodes can overlap by rounding error.
+constexpr float kEdgeTolerance{0.5f};
+constexpr float kCrossAxisWeight{2.f};
+// Grid size limit per axis. Bounds memory when rects vary widely in size.
+constexpr int32_t kMaxGridSize{128};
+
+static bool IsHorizontal(FocusDirection direction) noexcept {
+  return direction == FocusDirectionLeft || direction == FocusDirectionRight;
+}
+
+static bool IsForward(FocusDirection direction) noexcept {
+  return direction == FocusDirectionRight || direction == FocusDirectionDown;
+}
+
+// Score the move from origin to rect. Returns false if rect is not in direction.
+static bool Score(const Rect& origin, const Rect& rect, FocusDirection direction, float* score, float* alignment) {
+  float distance;
+  float gap;
+
+  switch (direction) {
+    case FocusDirectionLeft:
+      distance = origin.x - (rect.x + rect.width);
+      break;
+    case FocusDirectionRight:
+      distance = rect.x - (origin.x + origin.width);
+      break;
+    case FocusDirectionUp:
+      distance = origin.y - (rect.y + rect.height);
+      break;
+    case FocusDirectionDown:
+      distance = rect.y - (origin.y + origin.height);
+      break;
+    default:
+      return false;
+  }
+
+  if (distance < -kEdgeTolerance) {
+    return false;
+  }
+
+  if (IsHorizontal(direction)) {
+    gap = std::max(rect.y - (origin.y + origin.height), origin.y - (rect.y + rect.height));
+    *alignment = std::fabs((rect.y + rect.height / 2.f) - (origin.y + origin.height / 2.f));
+  } else {
+    gap = std::max(rect.x - (origin.x + origin.width), origin.x - (rect.x + rect.width));
+    *alignment = std::fabs((rect.x + rect.width / 2.f) - (origin.x + origin.width / 2.f));
+  }
+
+  *score = std::max(distance, 0.f) + kCrossAxisWeight * std::max(gap, 0.f);
+
+  return true;
+}
+
+void FocusIndex::Clear() noexcept {
+  this->entries.clear();
+  this->cellStart.clear();
+  this->cellEntries.clear();
+  this->visited.clear();
+  this->columns = this->rows = 0;
+}
+
+void FocusIndex::Insert(SceneNode* node, const Rect& rect, uint32_t order) {
+  assert(this->entries.empty() || this->entries.back().order < order);
+  this->entries.push_back({ node, rect, order });
+}
+
+void FocusIndex::Build() {
+  const auto count{ this->entries.size() };
+
+  this->cellStart.clear();
+  this->cellEntries.clear();
+  this->visited.assign(count, 0);
+  this->stamp = 0;
+
+  if (count == 0) {
+    this->columns = this->rows = 0;
+    return;
+  }
+
+  auto left{ this->entries[0].rect.x };
+  auto top{ this->entries[0].rect.y };
+  auto right{ left };
+  auto bottom{ top };
+  float totalWidth{ 0 };
+  float totalHeight{ 0 };
+
+  for (const auto& entry : this->entries) {
+    left = std::min(left, entry.rect.x);
+    top = std::min(top, entry.rect.y);
+    right = std::max(right, entry.rect.x + entry.rect.width);
+    bottom = std::max(bottom, entry.rect.y + entry.rect.height);
+    totalWidth += entry.rect.width;
+    totalHeight += entry.rect.height;
+  }
+
+  // Cells about the size of the average rect, so a cell holds a few entries and an entry spans a few cells.
+  const auto averageWidth{ std::max(totalWidth / static_cast<float>(count), 1.f) };
+  const auto averageHeight{ std::max(totalHeight / static_cast<float>(count), 1.f) };
+
+  this->bounds = { left, top, right - left, bottom - top };
+  this->columns = std17::clamp(static_cast<int32_t>(std::ceil(this->bounds.width / averageWidth)), 1, kMaxGridSize);
+  this->rows = std17::clamp(static_cast<int32_t>(std::ceil(this->bounds.height / averageHeight)), 1, kMaxGridSize);
+  this->cellWidth = std::max(this->bounds.width / static_cast<float>(this->columns), 1.f);
+  this->cellHeight = std::max(this->bounds.height / static_cast<float>(this->rows), 1.f);
+  this->cellStart.assign(static_cast<std::size_t>(this->columns * this->rows) + 1, 0);
+
+  auto forEachCell = [this](const Rect& rect, auto&& func) {
+    const auto c0{ this->ToColumn(rect.x) };
+    const auto c1{ this->ToColumn(rect.x + rect.width) };
+    const auto r0{ this->ToRow(rect.y) };
+    const auto r1{ this->ToRow(rect.y + rect.height) };
+
+    for (auto r{ r0 }; r <= r1; r++) {
+      for (auto c{ c0 }; c <= c1; c++) {
+        func(static_cast<std::size_t>(r * this->columns + c));
+      }
+    }
+  };
+
+  for (const auto& entry : this->entries) {
+    forEachCell(entry.rect, [this](std::size_t cell) { this->cellStart[cell + 1]++; });
+  }
+
+  for (std::size_t i = 1; i < this->cellStart.size(); i++) {
+    this->cellStart[i] += this->cellStart[i - 1];
+  }
+
+  std::vector<uint32_t> cellEnd(this->cellStart.begin(), this->cellStart.end() - 1);
+
+  this->cellEntries.resize(this->cellStart.back());
+
+  for (uint32_t i = 0; i < count; i++) {
+    forEachCell(this->entries[i].rect, [this, &cellEnd, i](std::size_t cell) {
+      this->cellEntries[cellEnd[cell]++] = i;
+    });
+  }
+}
+
+SceneNode* FocusIndex::Find(
+    const Rect& origin, FocusDirection direction, uint32_t begin, uint32_t end, const SceneNode* exclude) {
+  if (this->entries.empty() || direction < FocusDirectionLeft || direction > FocusDirectionDown) {
+    return nullptr;
+  }
+
+  const auto horizontal{ IsHorizontal(direction) };
+  const auto forward{ IsForward(direction) };
+  // The edge of origin the search moves away from.
+  float edge;
+
+  switch (direction) {
+    case FocusDirectionLeft:
+      edge = origin.x;
+      break;
+    case FocusDirectionRight:
+      edge = origin.x + origin.width;
+      break;
+    case FocusDirectionUp:
+      edge = origin.y;
+      break;
+    default:
+      edge = origin.y + origin.height;
+      break;
+  }
+
+  // Lines are the columns (horizontal moves) or rows (vertical moves) of cells, visited moving away from the edge.
+  const auto lineCount{ horizontal ? this->columns : this->rows };
+  const auto crossCount{ horizontal ? this->rows : this->columns };
+  const auto lineSize{ horizontal ? this->cellWidth : this->cellHeight };
+  const auto lineOrigin{ horizontal ? this->bounds.x : this->bounds.y };
+  const auto startEdge{ forward ? edge - kEdgeTolerance : edge + kEdgeTolerance };
+  const int32_t step{ forward ? 1 : -1 };
+  const Entry* best{};
+  float bestScore{};
+  float bestAlignment{};
+
+  if (++this->stamp == 0) {
+    std::fill(this->visited.begin(), this->visited.end(), 0);
+    this->stamp = 1;
+  }
+
+  for (auto line{ horizontal ? this->ToColumn(startEdge) : this->ToRow(startEdge) };
+       line >= 0 && line < lineCount;
+       line += step) {
+    if (best) {
+      // Unvisited entries start in this line or beyond, so their distance to the edge is at least the line's.
+      const auto lineStart{ lineOrigin + static_cast<float>(line) * lineSize };
+      const auto distance{ forward ? lineStart - edge : edge - (lineStart + lineSize) };
+
+      if (distance > bestScore) {
+        break;
+      }
+    }
+
+    for (int32_t k = 0; k < crossCount; k++) {
+      const auto cell{ static_cast<std::size_t>(horizontal ? k * this->columns + line : line * this->columns + k) };
+
+      for (auto i{ this->cellStart[cell] }; i < this->cellStart[cell + 1]; i++) {
+        const auto index{ this->cellEntries[i] };
+
+        if (this->visited[index] == this->stamp) {
+          continue;
+        }
+
+        this->visited[index] = this->stamp;
+
+        const auto& entry{ this->entries[index] };
+        float score;
+        float alignment;
+
+        if (entry.node == exclude || entry.order < begin || entry.order >= end
+            || !Score(origin, entry.rect, direction, &score, &alignment)) {
+          continue;
+        }
+
+        if (!best || score < bestScore || (score == bestScore && alignment < bestAlignment)) {
+          best = &entry;
+          bestScore = score;
+          bestAlignment = alignment;
+        }
+      }
+    }
+  }
+
+  return best ? best->node : nullptr;
+}
+
+SceneNode* FocusIndex::First(uint32_t begin, uint32_t end) const noexcept {
+  auto p{ std::lower_bound(this->entries.begin(), this->entries.end(), begin,
+                           [](const Entry& entry, uint32_t order) { return entry.order < order; }) };
+
+  return (p != this->entries.end() && p->order < end) ? p->node : nullptr;
+}
+
+int32_t FocusIndex::ToColumn(float x) const noexcept {
+  return std17::clamp(static_cast<int32_t>(std::floor((x - this->bounds.x) / this->cellWidth)), 0, this->columns - 1);
+}
+
+int32_t FocusIndex::ToRow(float y) const noexcept {
+  return std17::clamp(static_cast<int32_t>(std::floor((y - this->bounds.y) / this->cellHeight)), 0, this->rows - 1);
+}
+
+} // namespace lse
@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2021 Light Source Software, LLC. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on
+ * an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the
+ * specific language governing permissions and limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <lse/Rect.h>
+
+namespace lse {
+
+class SceneNode;
+
+/**
+ * Directions of a focus move. Values match Direction in src/input/Direction.mjs.
+ */
+enum FocusDirection : int32_t {
+  FocusDirectionLeft = 1,
+  FocusDirectionRight = 2,
+  FocusDirectionUp = 3,
+  FocusDirectionDown = 4,
+};
+
+/**
+ * Spatial index over the absolute layout rects of focusable nodes, used to resolve directional (arrow key, d-pad)
+ * focus moves.
+ *
+ * Rects are binned in a uniform grid with cells about the size of the average rect. A query walks the grid away from
+ * the origin rect, one row or column of cells at a time, and stops when the remaining cells cannot beat the best
+ * candidate found. A move in a large grid of items visits the cells near the origin rather than every focusable node.
+ *
+ * Entries are inserted in paint order, with their index in the Scene's flat tree, so queries can be restricted to a
+ * subtree: the subtree of a node is a contiguous range of flat tree indices.
+ */
+class FocusIndex {
+ public:
+  void Clear() noexcept;
+
+  /**
+   * Add a node. Nodes must be inserted in ascending order. Call Build() after the last insert.
+   */
+  void Insert(SceneNode* node, const Rect& rect, uint32_t order);
+  void Build();
+
+  bool IsEmpty() const noexcept { return this->entries.empty(); }
+
+  /**
+   * Find the nearest node to origin in direction.
+   *
+   * Candidates are nodes entirely past the origin's edge in direction. Candidates are ranked by the distance along the
+   * direction plus twice the gap on the cross axis, so an aligned node is preferred over a diagonal one at a similar
+   * distance.
+   *
+   * @param begin first order, inclusive, of the nodes to consider
+   * @param end last order, exclusive, of the nodes to consider
+   * @param exclude node to skip (the origin node)
+   * @return the nearest node; nullptr if there are no candidates
+   */
+  SceneNode* Find(
+      const Rect& origin, FocusDirection direction, uint32_t begin, uint32_t end, const SceneNode* exclude);
+
+  /**
+   * @return the first node, in insertion order, in the range [begin, end); nullptr if there is none
+   */
+  SceneNode* First(uint32_t begin, uint32_t end) const noexcept;
+
+ private:
+  struct Entry {
+    SceneNode* node;
+    Rect rect;
+    uint32_t order;
+  };
+
+  int32_t ToColumn(float x) const noexcept;
+  int32_t ToRow(float y) const noexcept;
+
+ private:
+  std::vector<Entry> entries;
+  // Grid cells in CSR layout: the entries of cell i are cellEntries[cellStart[i]..cellStart[i + 1]). An entry is
+  // listed in every cell its rect overlaps.
+  std::vector<uint32_t> cellStart;
+  std::vector<uint32_t> cellEntries;
+  // Query stamp of the last query that visited an entry. Entries spanning several cells are scored once per query.
+  std::vector<uint32_t> visited;
+  uint32_t stamp{};
+  Rect bounds{};
+  float cellWidth{1};
+  float cellHeight{1};
+  int32_t columns{};
+  int32_t rows{};
+};
+
+} // namespace lse
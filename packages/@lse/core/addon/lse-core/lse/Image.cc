@@ -129,6 +129,13 @@ void Image::Attach(Renderer* renderer) {
 
   this->renderer = renderer;
   this->rendererTextureFormat = renderer->GetTextureFormat();
+
+  // Upload the shadow, or pixels decoded while detached, rather than loading the image again.
+  if (this->state == ImageState::Init && this->bytes.Bytes()) {
+    this->UploadTexture();
+    this->RetainOrReleaseBytes();
+    this->NotifyListeners();
+  }
 }
 
 void Image::Detach(Renderer* renderer) {
@@ -144,12 +151,68 @@ void Image::Detach(Renderer* renderer) {
   }
 }
 
+void Image::SetShadowBudget(ImageShadowBudget* budget) noexcept {
+  if (!budget) {
+    this->ReleaseShadow();
+  }
+
+  this->shadowBudget = budget;
+}
+
+bool Image::HasShadow() const noexcept {
+  return this->hasShadow;
+}
+
+void Image::ReleaseShadow() noexcept {
+  if (!this->hasShadow) {
+    return;
+  }
+
+  this->shadowBudget->used -= static_cast<std::size_t>(this->bytes.Pitch()) * this->bytes.Height();
+  this->shadowBudget->count--;
+  this->hasShadow = false;
+  // If detached, the image will be loaded again on attach.
+  this->bytes.Release();
+}
+
+void Image::UploadTexture() {
+  this->bytes.SyncFormat(this->rendererTextureFormat);
+  this->texture = this->renderer->CreateTexture(this->bytes.Width(), this->bytes.Height(), Texture::Updatable);
+
+  if (this->texture && this->texture->Update(this->bytes.Bytes())) {
+    this->texture->SetOpaque(this->bytes.IsOpaque());
+    this->state = ImageState::Ready;
+  } else {
+    this->texture = Texture::SafeDestroy(this->texture);
+    this->errorMessage = "Failed to create texture";
+    this->state = ImageState::Error;
+  }
+}
+
+void Image::RetainOrReleaseBytes() noexcept {
+  if (this->hasShadow) {
+    return;
+  }
+
+  const auto size{ static_cast<std::size_t>(this->bytes.Pitch()) * this->bytes.Height() };
+  auto budget{ this->shadowBudget };
+
+  if (this->state == ImageState::Ready && budget && budget->used + size <= budget->limit) {
+    budget->used += size;
+    budget->count++;
+    this->hasShadow = true;
+  } else {
+    this->bytes.Release();
+  }
+}
+
 bool Image::IsAttached() const noexcept {
   return this->renderer != nullptr;
 }
 
 void Image::Destroy() {
   // TODO: clean up?
+  this->SetShadowBudget(nullptr);
   this->isDestroyed = true;
 }
 
@@ -161,6 +224,8 @@ void Image::OnLoadImageAsync() noexcept {
       this->bytes = DecodeImageFromFile(this->request.uri, this->request.width, this->request.height);
     }
 
+    // Do the per pixel work here, on the worker thread, rather than at texture upload on the main thread.
+    this->bytes.PremultiplyAlpha();
     this->bytes.SyncFormat(this->rendererTextureFormat);
   } catch (const std::exception& e) {
     this->errorMessage = e.what();
@@ -179,27 +244,16 @@ void Image::OnLoadImageAsyncComplete() noexcept {
   this->width = this->bytes.Width();
   this->height = this->bytes.Height();
 
-  if (this->IsAttached()) {
-    if (!this->bytes.Bytes()) {
-      this->state = ImageState::Error;
-    } else {
-      this->bytes.SyncFormat(this->rendererTextureFormat);
-      this->texture = this->renderer->CreateTexture(
-          this->bytes.Width(), this->bytes.Height(), Texture::Updatable);
-
-      if (this->texture && this->texture->Update(this->bytes.Bytes())) {
-        this->state = ImageState::Ready;
-      } else {
-        this->texture = Texture::SafeDestroy(this->texture);
-        this->errorMessage = "Failed to create texture";
-        this->state = ImageState::Error;
-      }
-    }
-
-    this->bytes.Release();
+  if (!this->bytes.Bytes()) {
+    this->state = ImageState::Error;
+    this->NotifyListeners();
+  } else if (this->IsAttached()) {
+    this->UploadTexture();
+    this->RetainOrReleaseBytes();
     this->NotifyListeners();
   } else {
-    // TODO: wait for attach...
+    // Attach() uploads the decoded pixels.
+    this->state = ImageState::Init;
   }
 }
 
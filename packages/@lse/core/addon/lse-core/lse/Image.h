@@ -31,6 +31,17 @@ struct ImageRequest {
   int32_t height{};
 };
 
+/**
+ * Memory limit of the CPU shadows kept by a group of images. Shared by the images of an ImageManager.
+ */
+struct ImageShadowBudget {
+  // Limit in bytes. 0 disables shadows.
+  std::size_t limit{};
+  // Bytes held by shadows.
+  std::size_t used{};
+  std::size_t count{};
+};
+
 enum class ImageState {
   Init = 0,
   Loading,
@@ -74,6 +85,15 @@ class Image : public Reference {
   bool IsAttached() const noexcept;
   void Destroy();
 
+  /**
+   * Keep a CPU shadow of the decoded pixels after texture upload, if it fits in budget. When the image is attached
+   * again, the texture is uploaded from the shadow rather than loaded and decoded from the source. nullptr disables
+   * shadows and releases the shadow, if any.
+   */
+  void SetShadowBudget(ImageShadowBudget* budget) noexcept;
+  bool HasShadow() const noexcept;
+  void ReleaseShadow() noexcept;
+
   void OnLoadImageAsync() noexcept;
   void OnLoadImageAsyncComplete() noexcept;
 
@@ -86,6 +106,10 @@ class Image : public Reference {
   };
 
   void NotifyListeners();
+  // Upload bytes to a new texture. Sets the state to Ready or Error.
+  void UploadTexture();
+  // Keep bytes as the shadow, if the budget allows, or release them.
+  void RetainOrReleaseBytes() noexcept;
 
  private:
   static int32_t nextResourceId;
@@ -96,7 +120,10 @@ class Image : public Reference {
   Texture* texture{};
   ImageState state{ImageState::Init};
   std::vector<ListenerEntry> listeners{};
+  // Decoded pixels waiting for upload or, if hasShadow, the CPU shadow of the texture.
   ImageBytes bytes{};
+  ImageShadowBudget* shadowBudget{};
+  bool hasShadow{};
   Renderer* renderer{};
   bool isDestroyed{};
   std::string errorMessage{};
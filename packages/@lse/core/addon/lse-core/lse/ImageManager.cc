@@ -14,6 +14,10 @@
 #include "ImageManager.h"
 
 #include <lse/Image.h>
+#include <lse/Renderer.h>
+#include <lse/Texture.h>
+#include <algorithm>
+#include <stdexcept>
 
 namespace lse {
 
@@ -21,27 +25,40 @@ ImageManager::ImageManager(LoadImageAsync&& loadImageAsync) noexcept
 : loadImageAsync(std::move(loadImageAsync)) {
 }
 
-void ImageManager::Attach(Renderer* renderer) noexcept {
+void ImageManager::Attach(Renderer* renderer) {
   if (this->isAttached) {
+    if (renderer != this->renderer) {
+      throw std::runtime_error("image manager is attached to another renderer");
+    }
+
+    this->attachCount++;
     return;
   }
 
+  this->attachUploadCount = 0;
+  this->attachLoadCount = 0;
+
   for (auto& entry : this->imagesById) {
     auto image{entry.second};
+    const auto needsUpload{ image->GetState() == ImageState::Init };
 
     image->Attach(renderer);
 
     if (image->GetState() == ImageState::Init) {
       this->loadImageAsync(image);
+      this->attachLoadCount++;
+    } else if (needsUpload) {
+      this->attachUploadCount++;
     }
   }
 
   this->renderer = renderer;
   this->isAttached = true;
+  this->attachCount = 1;
 }
 
 void ImageManager::Detach() noexcept {
-  if (!this->isAttached) {
+  if (!this->isAttached || --this->attachCount > 0) {
     return;
   }
 
@@ -49,10 +66,20 @@ void ImageManager::Detach() noexcept {
     entry.second->Detach(this->renderer);
   }
 
+  // Text textures are not backed up. The text blocks of the detached scenes release their entries on detach.
+  for (auto& entry : this->textTextures) {
+    Texture::SafeDestroy(entry.second.texture);
+  }
+
+  this->textTextures.clear();
   this->renderer = nullptr;
   this->isAttached = false;
 }
 
+bool ImageManager::IsAttached() const noexcept {
+  return this->isAttached;
+}
+
 void ImageManager::Destroy() noexcept {
   if (this->isDestroyed) {
     return;
@@ -67,10 +94,18 @@ void ImageManager::Destroy() noexcept {
 
   this->imagesById.clear();
   this->imagesByUri.clear();
+  this->pendingShares.clear();
+  this->scopesById.clear();
+
+  for (auto& entry : this->textTextures) {
+    Texture::SafeDestroy(entry.second.texture);
+  }
+
+  this->textTextures.clear();
   this->isDestroyed = true;
 }
 
-Image* ImageManager::Acquire(const ImageRequest& request) {
+Image* ImageManager::Acquire(const ImageRequest& request, const void* scope) {
   if (this->isDestroyed || request.uri.empty()) {
     return {};
   }
@@ -78,8 +113,22 @@ Image* ImageManager::Acquire(const ImageRequest& request) {
   auto p{this->imagesByUri.find(request.uri)};
 
   if (p != this->imagesByUri.end()) {
-    p->second->Ref();
-    return p->second;
+    auto image{p->second};
+
+    this->stats.acquireCount++;
+
+    if (AddScope(this->scopesById[image->GetId()], scope)) {
+      this->stats.shareCount++;
+
+      if (image->HasDimensions()) {
+        this->stats.savedBytes += static_cast<std::size_t>(image->Width()) * image->Height() * 4;
+      } else {
+        this->pendingShares[image->GetId()]++;
+      }
+    }
+
+    image->Ref();
+    return image;
   }
 
   if (request.uri.front() == '@') {
@@ -93,34 +142,167 @@ Image* ImageManager::Acquire(const ImageRequest& request) {
   }
 
   image->Ref();
+  image->SetShadowBudget(&this->shadowBudget);
 
   this->loadImageAsync(image);
   this->imagesById[image->GetId()] = image;
   this->imagesByUri[request.uri] = image;
+  this->scopesById[image->GetId()] = { { scope, 1 } };
+  this->stats.acquireCount++;
 
   return image;
 }
 
-void ImageManager::Release(Image* image) {
+void ImageManager::Release(Image* image, const void* scope) {
   if (this->isDestroyed) {
     return;
   }
 
   if (image) {
+    RemoveScope(this->scopesById[image->GetId()], scope);
     image->Unref();
 
     if (image->RefCount() == 1) {
       this->imagesById.erase(image->GetId());
+      this->pendingShares.erase(image->GetId());
+      this->scopesById.erase(image->GetId());
       // TODO: this may not work with alias feature
       this->imagesByUri.erase(image->GetRequest().uri);
+      image->SetShadowBudget(nullptr);
       image->Unref();
     }
   }
 }
 
+Texture* ImageManager::AcquireTextTexture(
+    const std::string& key, int32_t width, int32_t height, const void* scope, bool* isNew) {
+  *isNew = false;
+
+  if (this->isDestroyed || !this->renderer || key.empty()) {
+    return {};
+  }
+
+  auto p{this->textTextures.find(key)};
+
+  if (p != this->textTextures.end()) {
+    if (AddScope(p->second.scopes, scope)) {
+      this->stats.textShareCount++;
+      this->stats.textSavedBytes +=
+          static_cast<std::size_t>(p->second.texture->Width()) * p->second.texture->Height() * 4;
+    }
+
+    return p->second.texture;
+  }
+
+  auto texture{this->renderer->CreateTexture(width, height, Texture::Lockable)};
+
+  if (!texture) {
+    return {};
+  }
+
+  this->textTextures[key] = { texture, { { scope, 1 } } };
+  *isNew = true;
+
+  return texture;
+}
+
+void ImageManager::ReleaseTextTexture(const std::string& key, const void* scope) noexcept {
+  auto p{this->textTextures.find(key)};
+
+  if (p == this->textTextures.end()) {
+    return;
+  }
+
+  RemoveScope(p->second.scopes, scope);
+
+  if (p->second.scopes.empty()) {
+    Texture::SafeDestroy(p->second.texture);
+    this->textTextures.erase(p);
+  }
+}
+
+bool ImageManager::AddScope(ScopeCounts& scopes, const void* scope) {
+  auto p{std::find_if(scopes.begin(), scopes.end(), [scope](const auto& e) { return e.first == scope; })};
+
+  if (p != scopes.end()) {
+    p->second++;
+    return false;
+  }
+
+  scopes.emplace_back(scope, 1);
+
+  return scopes.size() > 1;
+}
+
+void ImageManager::RemoveScope(ScopeCounts& scopes, const void* scope) noexcept {
+  auto p{std::find_if(scopes.begin(), scopes.end(), [scope](const auto& e) { return e.first == scope; })};
+
+  if (p != scopes.end() && --p->second <= 0) {
+    scopes.erase(p);
+  }
+}
+
+const ImageManagerStats& ImageManager::GetStats() noexcept {
+  // Count the shares of images that finished loading since the last call.
+  for (auto p{ this->pendingShares.begin() }; p != this->pendingShares.end();) {
+    auto image{ this->imagesById.find(p->first) };
+
+    if (image == this->imagesById.end() || image->second->HasDimensions()) {
+      if (image != this->imagesById.end()) {
+        this->stats.savedBytes +=
+            static_cast<std::size_t>(image->second->Width()) * image->second->Height() * 4 * p->second;
+      }
+
+      p = this->pendingShares.erase(p);
+    } else {
+      p++;
+    }
+  }
+
+  return this->stats;
+}
+
+std::size_t ImageManager::GetImageCount() const noexcept {
+  return this->imagesById.size();
+}
+
+Image* ImageManager::FindByTexture(const Texture* texture) const noexcept {
+  for (const auto& entry : this->imagesById) {
+    if (texture && entry.second->GetTexture() == texture) {
+      return entry.second;
+    }
+  }
+
+  return nullptr;
+}
+
+void ImageManager::SetShadowLimit(std::size_t limit) noexcept {
+  this->shadowBudget.limit = limit;
+
+  for (auto& entry : this->imagesById) {
+    if (this->shadowBudget.used <= limit) {
+      break;
+    }
+
+    entry.second->ReleaseShadow();
+  }
+}
+
+const ImageShadowBudget& ImageManager::GetShadowBudget() const noexcept {
+  return this->shadowBudget;
+}
+
+int32_t ImageManager::GetAttachUploadCount() const noexcept {
+  return this->attachUploadCount;
+}
+
+int32_t ImageManager::GetAttachLoadCount() const noexcept {
+  return this->attachLoadCount;
+}
+
 Image* ImageManager::SafeAcquire(ImageManager* imageManager, const ImageRequest& request,
-    void* owner, Image::Listener listener) noexcept {
-  auto image{imageManager->Acquire(request)};
+    void* owner, const void* scope, Image::Listener listener) noexcept {
+  auto image{imageManager->Acquire(request, scope)};
 
   if (image) {
     switch (image->GetState()) {
@@ -137,10 +319,10 @@ Image* ImageManager::SafeAcquire(ImageManager* imageManager, const ImageRequest&
   return image;
 }
 
-Image* ImageManager::SafeRelease(ImageManager* imageManager, Image* image, void* owner) noexcept {
+Image* ImageManager::SafeRelease(ImageManager* imageManager, Image* image, void* owner, const void* scope) noexcept {
   if (image) {
     image->RemoveListener(owner);
-    imageManager->Release(image);
+    imageManager->Release(image, scope);
   }
 
   return {};
@@ -14,12 +14,42 @@
 #pragma once
 
 #include <functional>
+#include <string>
+#include <vector>
 #include <phmap.h>
 #include <lse/Reference.h>
 #include <lse/Image.h>
 
 namespace lse {
 
+/**
+ * Sharing counters of an ImageManager.
+ */
+struct ImageManagerStats {
+  // Acquire() calls that returned an image.
+  std::size_t acquireCount{};
+  // Acquire() calls served by an image already loaded or loading for another scope (scene). Repeated uris within one
+  // scope are not counted.
+  std::size_t shareCount{};
+  // Decoded bytes not loaded (and textures not uploaded) thanks to shared images. Shares of images whose dimensions
+  // are not known yet (still loading) count when the dimensions are known.
+  std::size_t savedBytes{};
+  // AcquireTextTexture() calls served by a text texture already painted for another scope (scene).
+  std::size_t textShareCount{};
+  // Texture bytes not allocated (and text not painted) thanks to shared text textures.
+  std::size_t textSavedBytes{};
+};
+
+/**
+ * Loads and caches images by uri.
+ *
+ * An ImageManager is shared by the scenes drawing to one renderer (graphics context). Images are shared by all owners
+ * of the same uri, across scenes, and text textures are shared by all text blocks with the same key. Attach() and
+ * Detach() are reference counted: the manager is attached while any scene is attached.
+ *
+ * The scope passed to Acquire() and AcquireTextTexture() (the scene) identifies the sharer for stats, so only shares
+ * across scenes are counted.
+ */
 class ImageManager : public Reference {
  public:
   using LoadImageAsync = std::function<void(Image*)>;
@@ -28,26 +58,87 @@ class ImageManager : public Reference {
   ImageManager(LoadImageAsync&& loadImageAsync) noexcept;
   ~ImageManager() override = default;
 
-  void Attach(Renderer* renderer) noexcept;
+  /**
+   * Attach to renderer. Textures are not shareable between renderers, so attaching a manager that is already attached
+   * to another renderer throws.
+   */
+  void Attach(Renderer* renderer);
   void Detach() noexcept;
   void Destroy() noexcept;
+  bool IsAttached() const noexcept;
+
+  Image* Acquire(const ImageRequest& request, const void* scope);
+  void Release(Image* image, const void* scope);
+
+  /**
+   * Get the text texture identified by key, creating a width x height lockable texture if no scope has acquired it.
+   * isNew is set when the returned texture was created and must be painted by the caller.
+   *
+   * @return the texture; nullptr if the manager is not attached or the texture could not be created
+   */
+  Texture* AcquireTextTexture(const std::string& key, int32_t width, int32_t height, const void* scope, bool* isNew);
+  // Release a texture acquired by AcquireTextTexture(). The texture is destroyed when the last scope releases it.
+  void ReleaseTextTexture(const std::string& key, const void* scope) noexcept;
+
+  /**
+   * @return the image whose texture is texture; nullptr if texture does not belong to an image of this manager
+   */
+  Image* FindByTexture(const Texture* texture) const noexcept;
 
-  Image* Acquire(const ImageRequest& request);
-  void Release(Image* image);
+  /**
+   * Set the memory limit, in bytes, of the CPU shadows kept by images for fast reattach. Shadows over the new limit
+   * are released. 0 (the default) disables shadows.
+   */
+  void SetShadowLimit(std::size_t limit) noexcept;
+  const ImageShadowBudget& GetShadowBudget() const noexcept;
+
+  // Number of images uploaded from shadows by the last Attach().
+  int32_t GetAttachUploadCount() const noexcept;
+  // Number of images queued for load (and decode) by the last Attach().
+  int32_t GetAttachLoadCount() const noexcept;
+
+  const ImageManagerStats& GetStats() noexcept;
+  // Number of images currently cached.
+  std::size_t GetImageCount() const noexcept;
 
   static Image* SafeAcquire(ImageManager* imageManager,
                             const ImageRequest& request,
                             void* owner,
+                            const void* scope,
                             Image::Listener listener) noexcept;
 
   static Image* SafeRelease(ImageManager* imageManager,
                             Image* image,
-                            void* owner) noexcept;
+                            void* owner,
+                            const void* scope) noexcept;
+
+ private:
+  // Number of acquires per scope.
+  using ScopeCounts = std::vector<std::pair<const void*, int32_t>>;
+
+  struct TextTexture {
+    Texture* texture{};
+    ScopeCounts scopes{};
+  };
+
+ private:
+  // Count an acquire by scope. Returns true if the acquire is the first of scope and other scopes hold acquires.
+  static bool AddScope(ScopeCounts& scopes, const void* scope);
+  static void RemoveScope(ScopeCounts& scopes, const void* scope) noexcept;
 
  private:
   LoadImageAsync loadImageAsync{};
   phmap::flat_hash_map<int32_t, Image*> imagesById{};
   phmap::flat_hash_map<std::string, Image*> imagesByUri{};
+  ImageShadowBudget shadowBudget{};
+  int32_t attachUploadCount{};
+  int32_t attachLoadCount{};
+  ImageManagerStats stats{};
+  // Shares of images acquired before their dimensions were known.
+  phmap::flat_hash_map<int32_t, std::size_t> pendingShares{};
+  phmap::flat_hash_map<int32_t, ScopeCounts> scopesById{};
+  phmap::flat_hash_map<std::string, TextTexture> textTextures{};
+  int32_t attachCount{};
   bool isAttached{};
   bool isDestroyed{};
   Renderer* renderer{};
@@ -79,7 +79,6 @@ void ImageSceneNode::OnComposite(CompositeContext* ctx) {
   if (Image::SafeIsReady(this->image)) {
 //    auto box{YGNodeGetBox(this->ygNode)};
     const auto& transform{ctx->CurrentRenderTransform()};
-    auto imageStyle{Style::Or(this->style)};
 
 //    box.width *= ctx->CurrentMatrix().GetScaleX();
 //    box.height *= ctx->CurrentMatrix().GetScaleY();
@@ -90,7 +89,7 @@ void ImageSceneNode::OnComposite(CompositeContext* ctx) {
         Translate(this->imageRect.dest, ctx->CurrentMatrix().GetTranslateX(), ctx->CurrentMatrix().GetTranslateY()),
         this->imageRect.src,
         this->image->GetTexture(),
-        this->GetStyleContext()->ComputeFilter(imageStyle, ColorWhite, ctx->CurrentOpacity()));
+        this->GetFilter(ColorWhite, ctx->CurrentOpacity()));
   }
 
   this->DrawBorder(ctx);
@@ -115,8 +114,9 @@ void ImageSceneNode::SetSource(const ImageRequest& request) noexcept {
     YGNodeMarkDirty(this->ygNode);
   }
 
-  ImageManager::SafeRelease(imageManager, this->image, this);
-  this->image = ImageManager::SafeAcquire(imageManager, request, this, &ImageSceneNode::ImageStatusListener);
+  ImageManager::SafeRelease(imageManager, this->image, this, this->scene.Get());
+  this->image = ImageManager::SafeAcquire(
+      imageManager, request, this, this->scene.Get(), &ImageSceneNode::ImageStatusListener);
 }
 
 void ImageSceneNode::ResetSource() noexcept {
@@ -124,7 +124,7 @@ void ImageSceneNode::ResetSource() noexcept {
     YGNodeMarkDirty(this->ygNode);
   }
 
-  this->image = ImageManager::SafeRelease(this->GetImageManager(), this->image, this);
+  this->image = ImageManager::SafeRelease(this->GetImageManager(), this->image, this, this->scene.Get());
 }
 
 bool ImageSceneNode::HasImageStatusCallback() const noexcept {
@@ -136,7 +136,7 @@ void ImageSceneNode::SetImageStatusCallback(std::unique_ptr<ImageStatusCallback>
 }
 
 void ImageSceneNode::OnDestroy() {
-  this->image = ImageManager::SafeRelease(this->GetImageManager(), this->image, this);
+  this->image = ImageManager::SafeRelease(this->GetImageManager(), this->image, this, this->scene.Get());
   this->imageStatusCallback = nullptr;
 }
 
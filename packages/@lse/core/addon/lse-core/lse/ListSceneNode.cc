@@ -0,0 +1,141 @@
+/*
+ * Copyright (c) 2021 Light Source Software, LLC. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on
+ * an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the
+ * specific language governing permissions and limitations under the License.
+ */
+
+#include <lse/ListSceneNode.h>
+
+#include <algorithm>
+#include <cmath>
+#include <std17/algorithm>
+#include <lse/Scene.h>
+#include <lse/yoga-ext.h>
+
+namespace lse {
+
+ListSceneNode::ListSceneNode(Scene* scene) : SceneNode(scene) {
+}
+
+void ListSceneNode::SetItemCount(int32_t value) noexcept {
+  value = std::max(value, 0);
+
+  if (value != this->itemCount) {
+    this->itemCount = value;
+    // Keep the offset in range when the list shrinks.
+    this->SetScrollOffset(this->scrollOffset);
+    this->UpdateRange();
+  }
+}
+
+void ListSceneNode::SetItemExtent(float value) noexcept {
+  value = std::isfinite(value) ? std::max(value, 0.f) : 0.f;
+
+  if (value != this->itemExtent) {
+    this->itemExtent = value;
+    this->SetScrollOffset(this->scrollOffset);
+    this->UpdateRange();
+  }
+}
+
+void ListSceneNode::SetOverscan(int32_t value) noexcept {
+  value = std::max(value, 0);
+
+  if (value != this->overscan) {
+    this->overscan = value;
+    this->UpdateRange();
+  }
+}
+
+void ListSceneNode::SetHorizontal(bool value) noexcept {
+  if (value != this->horizontal) {
+    this->horizontal = value;
+    this->SetScrollOffset(this->scrollOffset);
+    this->UpdateRange();
+  }
+}
+
+void ListSceneNode::SetScrollOffset(float value) noexcept {
+  value = std17::clamp(std::isfinite(value) ? value : 0.f, 0.f, this->GetMaxScrollOffset());
+
+  if (value != this->scrollOffset) {
+    this->scrollOffset = value;
+    this->MarkCompositeDirty();
+    this->scene->InvalidateGeometry(this);
+    this->UpdateRange();
+  }
+}
+
+float ListSceneNode::GetMaxScrollOffset() const noexcept {
+  return std::max(static_cast<float>(this->itemCount) * this->itemExtent - this->GetViewportExtent(), 0.f);
+}
+
+bool ListSceneNode::HasRangeCallback() const noexcept {
+  return this->rangeCallback != nullptr;
+}
+
+void ListSceneNode::SetRangeCallback(std::unique_ptr<ListRangeCallback>&& callback) noexcept {
+  this->rangeCallback = std::move(callback);
+}
+
+Point ListSceneNode::GetContentOffset() const noexcept {
+  return this->horizontal ? Point{ -this->scrollOffset, 0 } : Point{ 0, -this->scrollOffset };
+}
+
+void ListSceneNode::OnComputeStyle() {
+  // The viewport size changed. The range callback is invoked outside of layout, as it is expected to change the
+  // style and children of realized items. This runs inside Scene::Update(), so the JS side records the range and
+  // binds the items before the frame is painted.
+  this->SetScrollOffset(this->scrollOffset);
+  this->UpdateRange();
+}
+
+void ListSceneNode::OnFlexBoxLayoutChanged() {
+  this->MarkComputeStyleDirty();
+}
+
+void ListSceneNode::OnDestroy() {
+  this->rangeCallback = nullptr;
+}
+
+float ListSceneNode::GetViewportExtent() const noexcept {
+  if (!this->ygNode) {
+    return 0;
+  }
+
+  return this->horizontal ? YGNodeLayoutGetWidth(this->ygNode) : YGNodeLayoutGetHeight(this->ygNode);
+}
+
+void ListSceneNode::UpdateRange() noexcept {
+  int32_t first{0};
+  int32_t last{0};
+
+  if (this->itemExtent > 0 && this->itemCount > 0) {
+    const auto viewport{ std::max(this->GetViewportExtent(), 0.f) };
+
+    first = static_cast<int32_t>(std::floor(this->scrollOffset / this->itemExtent)) - this->overscan;
+    last = static_cast<int32_t>(std::ceil((this->scrollOffset + viewport) / this->itemExtent)) + this->overscan;
+    first = std17::clamp(first, 0, this->itemCount);
+    last = std17::clamp(last, first, this->itemCount);
+  }
+
+  if (first == this->firstIndex && last == this->lastIndex) {
+    return;
+  }
+
+  this->firstIndex = first;
+  this->lastIndex = last;
+
+  if (this->rangeCallback) {
+    this->rangeCallback->Invoke(first, last);
+  }
+}
+
+} // namespace lse
@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2021 Light Source Software, LLC. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on
+ * an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the
+ * specific language governing permissions and limitations under the License.
+ */
+
+#pragma once
+
+#include <memory>
+#include <lse/SceneNode.h>
+
+namespace lse {
+
+class ListRangeCallback;
+
+/**
+ * Container for long lists (menus, media libraries, settings, etc) that only realizes the items near the viewport.
+ *
+ * Items have a fixed extent along the main axis (height of a vertical list, width of a horizontal list), so the
+ * visible range follows from the scroll offset without measuring items. The children of the list are the realized
+ * items, positioned by the application at index * itemExtent. The list scrolls by translating its children at
+ * composite time, so scrolling does not relayout, and the children are clipped to the list's box.
+ *
+ * The realized range is the visible range padded by overscan items on each side. When the range changes, the range
+ * callback is invoked so the application can bind items entering the range, recycling the subtrees of items that
+ * left it. A list of any length costs about as much as its realized range.
+ */
+class ListSceneNode final : public SceneNode {
+ public:
+  explicit ListSceneNode(Scene* scene);
+  ~ListSceneNode() override = default;
+
+  int32_t GetItemCount() const noexcept { return this->itemCount; }
+  void SetItemCount(int32_t value) noexcept;
+
+  float GetItemExtent() const noexcept { return this->itemExtent; }
+  void SetItemExtent(float value) noexcept;
+
+  int32_t GetOverscan() const noexcept { return this->overscan; }
+  void SetOverscan(int32_t value) noexcept;
+
+  bool IsHorizontal() const noexcept { return this->horizontal; }
+  void SetHorizontal(bool value) noexcept;
+
+  float GetScrollOffset() const noexcept { return this->scrollOffset; }
+
+  /**
+   * Scroll the list. The offset is clamped to [0, GetMaxScrollOffset()].
+   */
+  void SetScrollOffset(float value) noexcept;
+  float GetMaxScrollOffset() const noexcept;
+
+  // Realized range of item indices: [first, last)
+  int32_t GetFirstIndex() const noexcept { return this->firstIndex; }
+  int32_t GetLastIndex() const noexcept { return this->lastIndex; }
+
+  bool HasRangeCallback() const noexcept;
+  void SetRangeCallback(std::unique_ptr<ListRangeCallback>&& callback) noexcept;
+
+  bool IsScrollContainer() const noexcept override { return true; }
+  Point GetContentOffset() const noexcept override;
+
+  void OnComputeStyle() override;
+  void OnFlexBoxLayoutChanged() override;
+  void OnDestroy() override;
+
+ private:
+  float GetViewportExtent() const noexcept;
+  void UpdateRange() noexcept;
+
+ private:
+  int32_t itemCount{};
+  float itemExtent{};
+  int32_t overscan{2};
+  bool horizontal{};
+  float scrollOffset{};
+  int32_t firstIndex{};
+  int32_t lastIndex{};
+  std::unique_ptr<ListRangeCallback> rangeCallback{};
+};
+
+class ListRangeCallback {
+ public:
+  virtual ~ListRangeCallback() = default;
+  virtual void Invoke(int32_t first, int32_t last) = 0;
+};
+
+} // namespace lse
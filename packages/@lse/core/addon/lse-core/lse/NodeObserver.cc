@@ -0,0 +1,193 @@
+/*
+ * Copyright (c) 2021 Light Source Software, LLC. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on
+ * an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the
+ * specific language governing permissions and limitations under the License.
+ */
+
+#include "NodeObserver.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <std17/algorithm>
+#include <lse/Scene.h>
+#include <lse/SceneNode.h>
+
+namespace lse {
+
+// Threshold index of a target that has not been reported yet.
+constexpr int32_t kThresholdIndexUnreported{-2};
+
+// Index of the highest threshold that ratio reaches; -1 if the node is not intersecting.
+static int32_t GetThresholdIndex(const std::vector<float>& thresholds, bool isIntersecting, float ratio) noexcept {
+  int32_t index{-1};
+
+  if (!isIntersecting) {
+    return index;
+  }
+
+  for (std::size_t i = 0; i < thresholds.size(); i++) {
+    if (ratio >= thresholds[i]) {
+      index = static_cast<int32_t>(i);
+    }
+  }
+
+  return index;
+}
+
+NodeObserverSet::~NodeObserverSet() noexcept {
+  this->Clear();
+}
+
+void NodeObserverSet::Add(uint32_t id, NodeObserverType type, std::vector<float>&& thresholds) {
+  if (this->observers.contains(id)) {
+    throw std::runtime_error("observer id already in use");
+  }
+
+  if (type == NodeObserverTypeIntersection) {
+    if (thresholds.empty()) {
+      thresholds.push_back(0);
+    }
+
+    for (auto& threshold : thresholds) {
+      threshold = std17::clamp(threshold, 0.f, 1.f);
+    }
+
+    std::sort(thresholds.begin(), thresholds.end());
+  } else if (type != NodeObserverTypeResize) {
+    throw std::runtime_error("invalid observer type");
+  }
+
+  this->observers[id] = { type, std::move(thresholds), {} };
+}
+
+void NodeObserverSet::Remove(uint32_t id) noexcept {
+  auto p{ this->observers.find(id) };
+
+  if (p != this->observers.end()) {
+    ReleaseTargets(&p->second);
+    this->observers.erase(p);
+  }
+
+  auto it{ std::remove_if(this->records.begin(), this->records.end(),
+      [id](const NodeObserverRecord& record) { return record.observerId == id; }) };
+
+  this->records.erase(it, this->records.end());
+}
+
+void NodeObserverSet::Clear() noexcept {
+  for (auto& p : this->observers) {
+    ReleaseTargets(&p.second);
+  }
+
+  this->observers.clear();
+  this->records.clear();
+  this->isDirty = false;
+}
+
+bool NodeObserverSet::Observe(uint32_t id, SceneNode* node) {
+  auto p{ this->observers.find(id) };
+
+  if (p == this->observers.end() || !node) {
+    return false;
+  }
+
+  auto& targets{ p->second.targets };
+  auto exists{ std::any_of(targets.begin(), targets.end(), [node](const Target& t) { return t.node == node; }) };
+
+  if (!exists) {
+    constexpr auto nan{ std::numeric_limits<float>::quiet_NaN() };
+
+    targets.push_back({ node, nan, nan, kThresholdIndexUnreported });
+    node->Ref();
+    this->isDirty = true;
+  }
+
+  return true;
+}
+
+void NodeObserverSet::Unobserve(uint32_t id, SceneNode* node) noexcept {
+  auto p{ this->observers.find(id) };
+
+  if (p == this->observers.end()) {
+    return;
+  }
+
+  auto& targets{ p->second.targets };
+  auto it{ std::find_if(targets.begin(), targets.end(), [node](const Target& t) { return t.node == node; }) };
+
+  if (it != targets.end()) {
+    targets.erase(it);
+    node->Unref();
+  }
+}
+
+void NodeObserverSet::Update(const GeometryLookup& geometry) {
+  for (auto& p : this->observers) {
+    auto observerId{ p.first };
+    auto& observer{ p.second };
+
+    for (auto& target : observer.targets) {
+      auto g{ geometry(target.node) };
+
+      if (observer.type == NodeObserverTypeResize) {
+        // Nodes outside of the scene graph have no layout to report.
+        if (!g) {
+          continue;
+        }
+
+        auto width{ target.node->GetWidth() };
+        auto height{ target.node->GetHeight() };
+
+        if (width != target.width || height != target.height) {
+          target.width = width;
+          target.height = height;
+          this->records.push_back({ observerId, target.node->GetId(), { 0, 0, width, height }, 1.f, true });
+        }
+      } else {
+        Rect bounds{ g ? g->bounds : Rect{} };
+        bool isIntersecting;
+        float ratio;
+
+        // Hidden and zero area nodes have empty bounds and are never intersecting.
+        if (!g || lse::IsEmpty(bounds)) {
+          isIntersecting = false;
+          ratio = 0;
+        } else {
+          // The clip is the viewport narrowed by the overflow hidden and scroll container ancestors.
+          auto visible{ Intersect(bounds, g->clip) };
+
+          isIntersecting = !lse::IsEmpty(visible);
+          ratio = isIntersecting ? (visible.width * visible.height) / (bounds.width * bounds.height) : 0.f;
+        }
+
+        auto index{ GetThresholdIndex(observer.thresholds, isIntersecting, ratio) };
+
+        if (index != target.thresholdIndex) {
+          target.thresholdIndex = index;
+          this->records.push_back({ observerId, target.node->GetId(), bounds, ratio, isIntersecting });
+        }
+      }
+    }
+  }
+
+  this->isDirty = false;
+}
+
+void NodeObserverSet::ReleaseTargets(Observer* observer) noexcept {
+  for (auto& target : observer->targets) {
+    target.node->Unref();
+  }
+
+  observer->targets.clear();
+}
+
+} // namespace lse
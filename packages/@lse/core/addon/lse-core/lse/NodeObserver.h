@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2021 Light Source Software, LLC. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on
+ * an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the
+ * specific language governing permissions and limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+#include <phmap.h>
+#include <lse/Rect.h>
+
+namespace lse {
+
+class SceneNode;
+struct NodeGeometry;
+
+/**
+ * Kinds of node observers. Values match the observer classes in src/scene/SceneObserver.mjs.
+ */
+enum NodeObserverType : int32_t {
+  // Reports changes of a node's layout size.
+  NodeObserverTypeResize = 1,
+  // Reports when the visible fraction of a node's screen bounds crosses a threshold.
+  NodeObserverTypeIntersection = 2,
+};
+
+/**
+ * Change of an observed node, queued for delivery to the observer.
+ */
+struct NodeObserverRecord {
+  uint32_t observerId;
+  uint32_t nodeId;
+  // Resize: the layout box. Intersection: the screen bounds.
+  Rect rect;
+  // Intersection: fraction of the bounds within the clip of the node (see NodeGeometry), 0 to 1. Resize: 1.
+  float ratio;
+  // Intersection: is any part of the node within the viewport and not clipped by an ancestor? Resize: true.
+  bool isIntersecting;
+};
+
+/**
+ * Resize and intersection observers of a Scene's nodes.
+ *
+ * Observers are evaluated against the Scene's cached node geometry after layout, so observing a node costs nothing
+ * on frames where geometry does not change. Changes are queued as records; the Scene's owner drains the records once
+ * per frame, delivering them to JS in a batch.
+ */
+class NodeObserverSet {
+ public:
+  using GeometryLookup = std::function<const NodeGeometry*(SceneNode*)>;
+
+  ~NodeObserverSet() noexcept;
+
+  /**
+   * Add an observer.
+   *
+   * @param thresholds intersection observers: visible fractions, 0 to 1, that trigger a record when crossed
+   */
+  void Add(uint32_t id, NodeObserverType type, std::vector<float>&& thresholds);
+  void Remove(uint32_t id) noexcept;
+  void Clear() noexcept;
+
+  /**
+   * Observe a node. The first evaluation after observe always queues a record for the node.
+   *
+   * @return false if there is no observer with id
+   */
+  bool Observe(uint32_t id, SceneNode* node);
+  void Unobserve(uint32_t id, SceneNode* node) noexcept;
+
+  bool IsEmpty() const noexcept { return this->observers.empty(); }
+  // Were nodes observed since the last Update()?
+  bool IsDirty() const noexcept { return this->isDirty; }
+
+  /**
+   * Evaluate all observed nodes and queue records for the changes.
+   *
+   * @param geometry returns the cached geometry of a node; nullptr if the node is not in the scene graph
+   */
+  void Update(const GeometryLookup& geometry);
+
+  const std::vector<NodeObserverRecord>& GetRecords() const noexcept { return this->records; }
+  void ClearRecords() noexcept { this->records.clear(); }
+
+ private:
+  struct Target {
+    SceneNode* node;
+    // Resize: last reported size; NaN before the first record.
+    float width;
+    float height;
+    // Intersection: last reported threshold index; -1 when not intersecting, -2 before the first record.
+    int32_t thresholdIndex;
+  };
+
+  struct Observer {
+    NodeObserverType type;
+    std::vector<float> thresholds;
+    std::vector<Target> targets;
+  };
+
+  static void ReleaseTargets(Observer* observer) noexcept;
+
+  phmap::flat_hash_map<uint32_t, Observer> observers;
+  std::vector<NodeObserverRecord> records;
+  bool isDirty{};
+};
+
+} // namespace lse
@@ -0,0 +1,208 @@
+/*
+ * Copyright (c) 2021 Light Source Software, LLC. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on
+ * an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the
+ * specific language governing permissions and limitations under the License.
+ */
+
+#include <lse/PixelSceneNode.h>
+
+#include <cstring>
+#include <stdexcept>
+#include <lse/Scene.h>
+#include <lse/Style.h>
+#include <lse/StyleContext.h>
+#include <lse/CompositeContext.h>
+#include <lse/Renderer.h>
+#include <lse/PixelConversion.h>
+#include <lse/yoga-ext.h>
+
+namespace lse {
+
+PixelSceneNode::PixelSceneNode(Scene* scene) : SceneNode(scene) {
+  // set up the yoga node to call SceneNode::OnMeasure() when a measure is requested.
+  YGNodeSetMeasureFunc(this->ygNode, SceneNode::YogaMeasureCallback);
+}
+
+bool PixelSceneNode::SetFrame(const uint8_t* pixels, int32_t width, int32_t height, int32_t pitch, PixelFormat format) {
+  if (!pixels || width <= 0 || height <= 0) {
+    throw std::runtime_error("invalid frame dimensions");
+  }
+
+  const auto rowSize{width * 4};
+
+  if (pitch < rowSize) {
+    throw std::runtime_error("frame pitch is less than width * 4");
+  }
+
+  if (GetComponentCount(format) != 4) {
+    throw std::runtime_error("frame format must be a 4 channel pixel format");
+  }
+
+  auto renderer{this->scene->GetRenderer()};
+
+  if (!renderer) {
+    return false;
+  }
+
+  const auto textureFormat{renderer->GetTextureFormat()};
+
+  if (format != PixelFormatRGBA && format != textureFormat) {
+    throw std::runtime_error("frame format must be RGBA or the renderer's texture format");
+  }
+
+  if (width != this->frameWidth || height != this->frameHeight) {
+    this->DestroyTextures();
+    this->frameWidth = width;
+    this->frameHeight = height;
+    YGNodeMarkDirty(this->ygNode);
+    this->MarkComputeStyleDirty();
+  }
+
+  const auto back{this->front ^ 1};
+
+  if (!this->textures[back]) {
+    this->textures[back] = renderer->CreateTexture(width, height, Texture::Lockable);
+  }
+
+  auto texture{this->textures[back]};
+  TextureLock lock(texture);
+
+  if (!lock.IsLocked()) {
+    return false;
+  }
+
+  auto dest{lock.GetPixels()};
+  const auto destPitch{texture->Pitch()};
+
+  if (format == textureFormat && pitch == destPitch) {
+    std::memcpy(dest, pixels, static_cast<std::size_t>(pitch) * static_cast<std::size_t>(height));
+  } else {
+    // RGBA as the destination format is a plain copy.
+    const auto rowFormat{format == textureFormat ? PixelFormatRGBA : textureFormat};
+
+    for (int32_t y = 0; y < height; y++) {
+      ConvertToFormat(
+          reinterpret_cast<const color_t*>(pixels + y * pitch),
+          reinterpret_cast<color_t*>(dest + y * destPitch),
+          width,
+          rowFormat);
+    }
+  }
+
+  this->hasBackFrame = true;
+  this->MarkCompositeDirty();
+
+  return true;
+}
+
+void PixelSceneNode::ClearFrame() noexcept {
+  if (this->frameWidth != 0 || this->frameHeight != 0) {
+    this->frameWidth = this->frameHeight = 0;
+    YGNodeMarkDirty(this->ygNode);
+  }
+
+  this->DestroyTextures();
+  this->MarkCompositeDirty();
+}
+
+PixelFormat PixelSceneNode::GetTextureFormat() const noexcept {
+  auto renderer{this->scene->GetRenderer()};
+
+  return renderer ? renderer->GetTextureFormat() : PixelFormatUnknown;
+}
+
+void PixelSceneNode::OnStylePropertyChanged(StyleProperty property) {
+  switch (property) {
+    case StyleProperty::objectFit:
+    case StyleProperty::objectPositionX:
+    case StyleProperty::objectPositionY:
+      this->MarkComputeStyleDirty();
+      break;
+    case StyleProperty::filter:
+    case StyleProperty::backgroundColor:
+    case StyleProperty::borderColor:
+      this->MarkCompositeDirty();
+      break;
+    default:
+      SceneNode::OnStylePropertyChanged(property);
+      break;
+  }
+}
+
+void PixelSceneNode::OnFlexBoxLayoutChanged() {
+  this->MarkComputeStyleDirty();
+}
+
+void PixelSceneNode::OnComputeStyle() {
+  if (this->frameWidth <= 0 || this->frameHeight <= 0) {
+    return;
+  }
+
+  const auto bounds{YGNodeGetPaddingBox(this->ygNode)};
+  const auto frameWidthF{static_cast<float>(this->frameWidth)};
+  const auto frameHeightF{static_cast<float>(this->frameHeight)};
+  auto frameDest{this->GetStyleContext()->ComputeObjectFit(Style::Or(this->style), bounds, frameWidthF, frameHeightF)};
+
+  this->frameRect = ClipImage(bounds, frameDest, frameWidthF, frameHeightF);
+  this->MarkCompositeDirty();
+}
+
+void PixelSceneNode::OnComposite(CompositeContext* ctx) {
+  this->DrawBackground(ctx, StyleBackgroundClipBorderBox);
+
+  if (this->hasBackFrame) {
+    this->front ^= 1;
+    this->hasFrontFrame = true;
+    this->hasBackFrame = false;
+  }
+
+  auto texture{this->textures[this->front]};
+
+  if (this->hasFrontFrame && texture) {
+    ctx->renderer->DrawImage(
+        ctx->CurrentRenderTransform(),
+        { 0, 0 },
+        Translate(this->frameRect.dest, ctx->CurrentMatrix().GetTranslateX(), ctx->CurrentMatrix().GetTranslateY()),
+        this->frameRect.src,
+        texture,
+        this->GetFilter(ColorWhite, ctx->CurrentOpacity()));
+  }
+
+  this->DrawBorder(ctx);
+}
+
+YGSize PixelSceneNode::OnMeasure(float width, YGMeasureMode widthMode, float height, YGMeasureMode heightMode) {
+  if (this->frameWidth > 0 && this->frameHeight > 0) {
+    return { static_cast<float>(this->frameWidth), static_cast<float>(this->frameHeight) };
+  }
+
+  return SceneNode::OnMeasure(width, widthMode, height, heightMode);
+}
+
+void PixelSceneNode::OnDetach() {
+  // textures belong to the renderer. the producer's next frame repopulates them after attach.
+  this->DestroyTextures();
+}
+
+void PixelSceneNode::OnDestroy() {
+  this->DestroyTextures();
+}
+
+void PixelSceneNode::DestroyTextures() noexcept {
+  for (auto& texture : this->textures) {
+    texture = Texture::SafeDestroy(texture);
+  }
+
+  this->front = 0;
+  this->hasFrontFrame = false;
+  this->hasBackFrame = false;
+}
+
+} // namespace lse
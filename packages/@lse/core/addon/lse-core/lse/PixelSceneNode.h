@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2021 Light Source Software, LLC. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on
+ * an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the
+ * specific language governing permissions and limitations under the License.
+ */
+
+#pragma once
+
+#include <array>
+#include <lse/Rect.h>
+#include <lse/PixelFormat.h>
+#include <lse/SceneNode.h>
+
+namespace lse {
+
+/**
+ * Scene node that displays a stream of raw pixel frames produced by the application (emulators, video decoders,
+ * procedural effects, etc).
+ *
+ * Frames are copied directly from the caller's memory into a streaming (Lockable) texture in a single pass, with the
+ * pixel format conversion, if any, fused into the copy. Two textures are used: frames are written to the back
+ * texture while the front texture is drawn, and the textures are swapped on the next composite. Writing to a
+ * texture the renderer is not reading avoids stalling the GPU pipeline on slow devices.
+ */
+class PixelSceneNode final : public SceneNode {
+ public:
+  explicit PixelSceneNode(Scene* scene);
+  ~PixelSceneNode() override = default;
+
+  bool IsLeaf() const noexcept override { return true; }
+
+  /**
+   * Upload a frame.
+   *
+   * If called more than once between frames, the last frame wins.
+   *
+   * @param pixels Frame pixels. 4 bytes per pixel, premultiplied alpha (opaque frames need no special handling).
+   * @param width Width of the frame in pixels.
+   * @param height Height of the frame in pixels.
+   * @param pitch Number of bytes per row of the pixels buffer.
+   * @param format Format of pixels. Must be PixelFormatRGBA or the texture format of the renderer.
+   * @return true if the frame was uploaded; false if the scene is not attached to a renderer
+   * @throws std::runtime_error if dimensions or format are invalid
+   */
+  bool SetFrame(const uint8_t* pixels, int32_t width, int32_t height, int32_t pitch, PixelFormat format);
+  void ClearFrame() noexcept;
+
+  int32_t GetFrameWidth() const noexcept { return this->frameWidth; }
+  int32_t GetFrameHeight() const noexcept { return this->frameHeight; }
+
+  /**
+   * Pixel format of the textures. Frames in this format are uploaded with a plain copy.
+   */
+  PixelFormat GetTextureFormat() const noexcept;
+
+  void OnStylePropertyChanged(StyleProperty property) override;
+  void OnFlexBoxLayoutChanged() override;
+  void OnComputeStyle() override;
+  void OnComposite(CompositeContext* ctx) override;
+  YGSize OnMeasure(float width, YGMeasureMode widthMode, float height, YGMeasureMode heightMode) override;
+  void OnDetach() override;
+  void OnDestroy() override;
+
+ private:
+  void DestroyTextures() noexcept;
+
+ private:
+  std::array<Texture*, 2> textures{};
+  std::size_t front{};
+  bool hasFrontFrame{};
+  bool hasBackFrame{};
+  int32_t frameWidth{};
+  int32_t frameHeight{};
+  ImageRect frameRect{};
+};
+
+} // namespace lse
@@ -20,21 +20,70 @@
 #include <lse/math-ext.h>
 #include <lse/Style.h>
 #include <lse/RootSceneNode.h>
+#include <lse/SceneNodePool.h>
+#include <lse/SceneSnapshot.h>
 #include <lse/yoga-ext.h>
 #include <lse/StyleContext.h>
+#include <lse/ThreadPool.h>
 #include <lse/Timer.h>
+#include <lse/string-ext.h>
 
 namespace lse {
 
+// Composite style batches of at least this many nodes are resolved on the thread pool, in chunks.
+constexpr std::size_t kParallelComputeStyleMinNodes{ 1024 };
+constexpr std::size_t kParallelComputeStyleChunkSize{ 256 };
+
+// Nodes that clip their children to their box.
+static bool IsClipping(const SceneNode* node, Style* boxStyle) noexcept {
+  return node->IsScrollContainer() || boxStyle->GetEnum(StyleProperty::overflow) == YGOverflowHidden;
+}
+
+static bool Contains(const Rect& rect, float x, float y) noexcept {
+  return x >= rect.x && y >= rect.y && x < rect.x + rect.width && y < rect.y + rect.height;
+}
+
+static bool Intersects(const Rect& a, const Rect& b) noexcept {
+  return a.x < b.x + b.width && b.x < a.x + a.width && a.y < b.y + b.height && b.y < a.y + a.height;
+}
+
+// Screen-space bounding box of a width x height box mapped by transform.
+static Rect TransformBounds(const Matrix& m, float width, float height) noexcept {
+  const float xs[]{ 0, width, 0, width };
+  const float ys[]{ 0, 0, height, height };
+  auto left{ m.x };
+  auto top{ m.y };
+  auto right{ m.x };
+  auto bottom{ m.y };
+
+  for (auto i = 1; i < 4; i++) {
+    const auto x{ m.a * xs[i] + m.b * ys[i] + m.x };
+    const auto y{ m.c * xs[i] + m.d * ys[i] + m.y };
+
+    left = std::min(left, x);
+    top = std::min(top, y);
+    right = std::max(right, x);
+    bottom = std::max(bottom, y);
+  }
+
+  return { left, top, right - left, bottom - top };
+}
+
 Scene::Scene(Stage* stage, FontManager* fontManager, ImageManager* imageManager, GraphicsContext* context)
-: stage(stage), fontManager(fontManager), imageManager(imageManager), graphicsContext(context) {
+: stage(stage), fontManager(fontManager), imageManager(imageManager), graphicsContext(context),
+  nodePool(new SceneNodePool()) {
   this->paintRequests.reserve(32);
+  this->paintQueue.reserve(32);
+  this->computeStyleRequests.reserve(256);
+  this->computeStyleQueue.reserve(256);
 }
 
 Scene::~Scene() {
   if (this->isAttached) {
     LOG_WARN("scene is still attached");
   }
+
+  this->nodePool->Unref();
 }
 
 void Scene::SetRoot(RootSceneNode* root) {
@@ -42,9 +91,121 @@ void Scene::SetRoot(RootSceneNode* root) {
 
   root->Ref();
   this->root = root;
+  // The layer of root shares the scene's reference to root.
+  this->layers.push_back({ root, 0, false, true, nullptr, 0, 0 });
+  this->SortLayers();
+  this->InvalidateFlatTree();
+}
+
+void Scene::AddLayer(SceneNode* root, int32_t zIndex) {
+  if (!root || root->GetParent() || this->IsLayerRoot(root)) {
+    throw std::runtime_error("layer root must be a node without a parent");
+  }
+
+  root->Ref();
+  this->layers.push_back({ root, zIndex, false, true, nullptr, 0, 0 });
+  this->SortLayers();
+  this->InvalidateFlatTree();
+  this->MarkCompositeDirty();
+}
+
+void Scene::RemoveLayer(SceneNode* root) noexcept {
+  auto p{ std::find_if(this->layers.begin(), this->layers.end(),
+                       [root](const Layer& layer) { return layer.root == root; }) };
+
+  // The layer of the scene root lives as long as the scene.
+  if (p == this->layers.end() || root == this->root) {
+    return;
+  }
+
+  Texture::SafeDestroy(p->texture);
+  this->layers.erase(p);
+  this->InvalidateFlatTree();
+  this->MarkCompositeDirty();
+  root->Unref();
+}
+
+void Scene::SetLayerZIndex(SceneNode* root, int32_t zIndex) {
+  auto layer{ this->FindLayer(root) };
+
+  if (!layer) {
+    throw std::runtime_error("node is not a layer root");
+  }
+
+  if (layer->zIndex != zIndex) {
+    layer->zIndex = zIndex;
+    this->SortLayers();
+    this->InvalidateFlatTree();
+    this->MarkCompositeDirty();
+  }
+}
+
+void Scene::SetLayerCached(SceneNode* root, bool cached) {
+  auto layer{ this->FindLayer(root) };
+
+  if (!layer) {
+    throw std::runtime_error("node is not a layer root");
+  }
+
+  if (layer->cached != cached) {
+    layer->cached = cached;
+    layer->texture = Texture::SafeDestroy(layer->texture);
+    layer->dirty = true;
+    this->isCompositeDirty = true;
+  }
+}
+
+bool Scene::IsLayerRoot(SceneNode* node) const noexcept {
+  return std::any_of(this->layers.begin(), this->layers.end(),
+                     [node](const Layer& layer) { return layer.root == node; });
+}
+
+Scene::Layer* Scene::FindLayer(SceneNode* root) noexcept {
+  for (auto& layer : this->layers) {
+    if (layer.root == root) {
+      return &layer;
+    }
+  }
+
+  return nullptr;
+}
+
+void Scene::SortLayers() {
+  std::stable_sort(this->layers.begin(), this->layers.end(),
+                   [](const Layer& a, const Layer& b) { return a.zIndex < b.zIndex; });
+}
+
+void Scene::DestroyLayerTextures() noexcept {
+  for (auto& layer : this->layers) {
+    layer.texture = Texture::SafeDestroy(layer.texture);
+    layer.dirty = true;
+  }
+}
+
+void Scene::MarkCompositeDirty() noexcept {
+  for (auto& layer : this->layers) {
+    layer.dirty = true;
+  }
+
+  this->isCompositeDirty = true;
+}
+
+void Scene::MarkCompositeDirty(SceneNode* node) noexcept {
+  auto top{ node };
+
+  while (auto parent = top->GetParent()) {
+    top = parent;
+  }
+
+  if (auto layer = this->FindLayer(top)) {
+    layer->dirty = true;
+    this->isCompositeDirty = true;
+  }
 }
 
 void Scene::Attach() {
+  const auto start{ std::chrono::steady_clock::now() };
+
   this->graphicsContext->Attach();
 
   const auto w{ this->graphicsContext->GetWidth() };
@@ -62,33 +223,61 @@ void Scene::Attach() {
   this->isAttached = true;
   this->MarkCompositeDirty();
 
-  this->imageManager->Attach(renderer);
+  // The image manager is shared by the scenes of one graphics context; it throws if attached to another renderer.
+  try {
+    this->imageManager->Attach(renderer);
+  } catch (...) {
+    this->isAttached = false;
+    this->graphicsContext->Detach();
+    throw;
+  }
 
   if (!this->isAttached) {
     return;
   }
 
   if (this->root) {
-    SceneNode::Visit(this->root, [](SceneNode* node){ node->OnAttach(); });
+    for (const auto& entry : this->GetFlatTree()) {
+      entry.node->OnAttach();
+    }
   }
+
+  this->attachTime = static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - start).count());
 }
 
 void Scene::Detach() {
-  this->imageManager->Detach();
+  // The image manager may be shared with other scenes. Its attach is reference counted.
+  if (this->isAttached) {
+    this->imageManager->Detach();
+  }
 
   if (this->root) {
-    SceneNode::Visit(this->root, [](SceneNode* node){ node->OnDetach(); });
+    for (const auto& entry : this->GetFlatTree()) {
+      entry.node->OnDetach();
+    }
   }
 
+  // Render targets do not survive the graphics context.
+  this->DestroyLayerTextures();
   this->graphicsContext->Detach();
   this->isAttached = false;
 }
 
 void Scene::Frame() {
+  this->Update();
+  this->Render();
+}
+
+void Scene::Update() {
   if (!this->isAttached) {
     return;
   }
 
+  if (this->frameStart == std::chrono::steady_clock::time_point{}) {
+    this->frameStart = std::chrono::steady_clock::now();
+  }
+
   // TODO: load textures
 
   // media changes, root font size and/or viewport change
@@ -98,8 +287,25 @@ void Scene::Frame() {
   // flex box
   this->ComputeFlexBoxLayout();
 
+  // transforms, opacity and filters of the nodes queued for compute style. Resolved before the observers, as their
+  // geometry pass would otherwise resolve the queued nodes serially.
+  this->UpdateCompositeStyles();
+
+  // resize and intersection observers
+  this->UpdateObservers();
+
   // compute
   this->ComputeStyle();
+}
+
+void Scene::Render() {
+  if (!this->isAttached) {
+    return;
+  }
+
+  if (this->frameStart == std::chrono::steady_clock::time_point{}) {
+    this->frameStart = std::chrono::steady_clock::now();
+  }
 
   this->Paint();
 
@@ -107,22 +313,138 @@ void Scene::Frame() {
   this->Composite();
 
   // TODO: image deletes
+
+  auto renderer{ this->GetRenderer() };
+  const auto& renderStats{ renderer->GetStats() };
+  auto& stats{ this->frameStats };
+
+  stats.frame = ++this->frameCount;
+  stats.drawCalls = renderStats.drawCalls;
+  stats.textureUploads = renderStats.textureUploads;
+  stats.stateChanges = renderStats.stateChanges;
+  stats.frameTime = static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - this->frameStart).count());
+
+  this->frameStatsHistory[(this->frameCount - 1) % kFrameStatsCount] = stats;
+  stats = {};
+  this->frameStart = {};
+  renderer->ResetStats();
+}
+
+std::size_t Scene::GetFrameStatsCount() const noexcept {
+  return std::min<std::size_t>(this->frameCount, kFrameStatsCount);
+}
+
+const FrameStats& Scene::GetFrameStats(std::size_t index) const noexcept {
+  const auto count{ this->GetFrameStatsCount() };
+  const auto oldest{ this->frameCount - count };
+
+  assert(index < count);
+
+  return this->frameStatsHistory[(oldest + index) % kFrameStatsCount];
+}
+
+uint32_t Scene::GetAttachTime() const noexcept {
+  return this->attachTime;
+}
+
+std::vector<uint8_t> Scene::SaveSnapshot() {
+  if (this->width <= 0 || this->height <= 0) {
+    throw std::runtime_error("scene snapshot requires an attached scene");
+  }
+
+  this->SyncGeometry();
+
+  auto snapshot{ SceneSnapshot::Record(this->width, this->height, this->imageManager, [this](Renderer* renderer) {
+    this->compositeContext.Reset(renderer);
+
+    for (const auto& layer : this->layers) {
+      this->CompositePreOrder(&this->compositeContext, layer.begin, layer.end);
+    }
+  })};
+
+  return snapshot.Encode();
+}
+
+void Scene::LoadSnapshot(const uint8_t* data, std::size_t size) {
+  auto snapshot{ std::make_unique<SceneSnapshot>(SceneSnapshot::Decode(data, size)) };
+
+  this->ReleaseSnapshot();
+  this->snapshot = std::move(snapshot);
+  this->snapshot->AcquireImages(this->imageManager, this, &Scene::SnapshotImageListener);
+  this->isCompositeDirty = true;
+}
+
+void Scene::ReleaseSnapshot() noexcept {
+  if (!this->snapshot) {
+    return;
+  }
+
+  this->snapshot->ReleaseImages(this->imageManager, this);
+  this->snapshot = nullptr;
+  this->MarkCompositeDirty();
+}
+
+bool Scene::HasSnapshot() const noexcept {
+  return this->snapshot != nullptr;
+}
+
+void Scene::SnapshotImageListener(void* owner, Image* image) noexcept {
+  switch (image->GetState()) {
+    case ImageState::Ready:
+    case ImageState::Error:
+      image->RemoveListener(owner);
+      static_cast<Scene*>(owner)->isCompositeDirty = true;
+      break;
+    default:
+      break;
+  }
 }
 
 void Scene::Destroy() noexcept {
+  if (this->isAttached && this->imageManager) {
+    this->imageManager->Detach();
+  }
+
   this->isAttached = false;
+  this->ReleaseSnapshot();
+
+  for (auto node : this->computeStyleRequests) {
+    node->flags.reset(SceneNode::FlagComputeStyleQueued);
+    node->Unref();
+  }
+
+  this->computeStyleRequests.clear();
+  this->observers.Clear();
 
-  if (this->imageManager) {
-    this->imageManager->Destroy();
-    this->imageManager = nullptr;
+  for (auto node : this->paintRequests) {
+    node->Unref();
+  }
+
+  this->paintRequests.clear();
+
+  this->flatTree.clear();
+  this->InvalidateFlatTree();
+  this->focusIndex.Clear();
+  this->geometry.clear();
+  this->DestroyLayerTextures();
+
+  for (const auto& layer : this->layers) {
+    if (layer.root != this->root) {
+      layer.root->Unref();
+    }
   }
 
+  this->layers.clear();
+
   if (this->root) {
     this->root->Unref();
     this->root = nullptr;
   }
 
   this->fontManager = nullptr;
+  // Owned by the stage and may be shared with other scenes.
+  this->imageManager = nullptr;
   this->graphicsContext = nullptr;
   this->stage = nullptr;
 }
@@ -156,48 +478,288 @@ void Scene::DispatchMediaChange() {
 
   this->SyncStyleContext();
 
-  SceneNode::Visit(this->root, [this](SceneNode* node) {
-    if (node->style != nullptr) {
-      node->style->OnMediaChange(this->isRootFontSizeDirty, this->isViewportSizeDirty);
+  for (const auto& entry : this->GetFlatTree()) {
+    if (entry.node->style != nullptr) {
+      entry.node->style->OnMediaChange(this->isRootFontSizeDirty, this->isViewportSizeDirty);
+    }
+
+    // Transform functions can be in viewport or rem units, but they do not send change events.
+    if (entry.node->HasTransform()) {
+      entry.node->MarkCompositeStyleDirty();
     }
-  });
+  }
 
+  // Transforms can be in viewport or rem units.
+  this->InvalidateGeometry();
+  // The render targets of cached layers are viewport sized.
+  this->MarkCompositeDirty();
   this->isViewportSizeDirty = this->isRootFontSizeDirty = false;
 }
 
+uint32_t Scene::RegisterNode(SceneNode* node) {
+  const auto id{this->nextNodeId++};
+
+  this->nodesById[id] = node;
+
+  return id;
+}
+
+void Scene::UnregisterNode(uint32_t id) noexcept {
+  this->nodesById.erase(id);
+}
+
+SceneNode* Scene::GetNode(uint32_t id) const noexcept {
+  auto p{this->nodesById.find(id)};
+
+  return p == this->nodesById.end() ? nullptr : p->second;
+}
+
+void Scene::ApplyCommands(const uint32_t* commands, std::size_t length) {
+  if (length % kSceneCommandSize != 0) {
+    throw std::runtime_error("malformed scene command list");
+  }
+
+  auto toNode = [this](uint32_t id) {
+    auto node{this->GetNode(id)};
+
+    if (!node) {
+      throw std::runtime_error(Format("scene command refers to an unknown node id: %u", id));
+    }
+
+    return node;
+  };
+
+  for (std::size_t i = 0; i < length; i += kSceneCommandSize) {
+    const auto args{commands + i + 1};
+
+    switch (commands[i]) {
+      case SceneCommandAppendChild:
+        toNode(args[0])->AppendChild(toNode(args[1]));
+        break;
+      case SceneCommandInsertBefore:
+        toNode(args[0])->InsertBefore(toNode(args[1]), toNode(args[2]));
+        break;
+      case SceneCommandRemoveChild:
+        toNode(args[0])->RemoveChild(toNode(args[1]));
+        break;
+      case SceneCommandSetHidden:
+        toNode(args[0])->SetHidden(args[1] != 0);
+        break;
+      case SceneCommandDestroy:
+        toNode(args[0])->Destroy();
+        break;
+      case SceneCommandSetFocusable:
+        toNode(args[0])->SetFocusable(args[1] != 0);
+        break;
+      default:
+        throw std::runtime_error(Format("unknown scene command: %u", commands[i]));
+    }
+  }
+}
+
+void Scene::RequestComputeStyle(SceneNode* node) noexcept {
+  // A node is queued once, whether compute style, composite style or both are dirty. A node queued twice would be
+  // updated by two workers of UpdateCompositeStyleParallel() at the same time.
+  if (node->flags.test(SceneNode::FlagComputeStyleQueued)) {
+    return;
+  }
+
+  node->flags.set(SceneNode::FlagComputeStyleQueued);
+  node->Ref();
+  this->computeStyleRequests.push_back(node);
+}
+
 void Scene::ComputeStyle() {
-  if (this->isComputeStyleDirty) {
-    ComputeStylePostOrder(this->root);
+  if (this->computeStyleRequests.empty()) {
+    return;
+  }
+
+  // Nodes requested while processing the queue (by OnComputeStyle(), for example) are processed next frame.
+  std::swap(this->computeStyleRequests, this->computeStyleQueue);
+
+  // Parents before children, in flat tree order, as the descendants queued by an inherited property change read the
+  // computed style of their ancestors. Nodes outside of the scene graph go last.
+  this->GetFlatTree();
+
+  const auto flatOrder = [this](SceneNode* node) noexcept {
+    return this->IsInFlatTree(node) ? node->flatIndex : UINT32_MAX;
+  };
+
+  std::stable_sort(
+      this->computeStyleQueue.begin(),
+      this->computeStyleQueue.end(),
+      [&flatOrder](SceneNode* a, SceneNode* b) noexcept { return flatOrder(a) < flatOrder(b); });
+
+  for (auto node : this->computeStyleQueue) {
+    // Cleared first, so a node marked dirty by its own OnComputeStyle() is queued for the next frame.
+    node->flags.reset(SceneNode::FlagComputeStyleQueued);
+
+    // Skip nodes that were destroyed while queued.
+    if (node->ygNode) {
+      // No-op unless the composite style changed after UpdateCompositeStyles().
+      node->UpdateCompositeStyle();
+
+      // Nodes can be queued for a composite style update only.
+      if (node->IsComputeStyleDirty()) {
+        node->OnComputeStyle();
+        node->flags.set(SceneNode::FlagComputeStyleDirty, false);
+      }
+
+      this->frameStats.computeStyleCount++;
+    }
+
+    node->Unref();
   }
+
+  this->computeStyleQueue.clear();
 }
 
-void Scene::ComputeStylePostOrder(SceneNode* node) {
-  if (!node->IsLeaf()) {
-    auto count{ node->GetChildCount() };
+void Scene::UpdateCompositeStyles() {
+  const auto& nodes{ this->computeStyleRequests };
+
+  if (nodes.size() >= kParallelComputeStyleMinNodes) {
+    this->UpdateCompositeStyleParallel(nodes);
+    return;
+  }
+
+  for (auto node : nodes) {
+    if (node->ygNode) {
+      node->UpdateCompositeStyle();
+    }
+  }
+}
 
-    for (uint32_t i = 0; i < count; i++) {
-      ComputeStylePostOrder(node->GetChildAt(i));
+void Scene::UpdateCompositeStyleParallel(const std::vector<SceneNode*>& nodes) {
+  // UpdateCompositeStyle() reads the node's style, layout box and the style context, and writes only the node's own
+  // composite state. RequestComputeStyle() queues a node once, so the nodes of a batch are distinct and independent.
+  // The batch runs on the thread pool shared by the scenes of the stage. The main thread waits for the batch (and
+  // takes a chunk itself), so nothing mutates the scene graph while workers read it. This runs after layout, ahead of
+  // the geometry and compute style passes, which then find the nodes clean. OnComputeStyle() touches the image and
+  // font managers and stays on the main thread.
+  auto threadPool{ this->stage->GetThreadPool() };
+  auto update = [&nodes](std::size_t begin, std::size_t end) {
+    for (auto i{ begin }; i < end; i++) {
+      if (nodes[i]->ygNode) {
+        nodes[i]->UpdateCompositeStyle();
+      }
     }
+  };
+  const auto count{ nodes.size() };
+  std::vector<std::future<void>> tasks;
+
+  tasks.reserve(count / kParallelComputeStyleChunkSize);
+
+  for (auto begin{ kParallelComputeStyleChunkSize }; begin < count; begin += kParallelComputeStyleChunkSize) {
+    const auto end{ std::min(begin + kParallelComputeStyleChunkSize, count) };
+
+    tasks.push_back(threadPool->Submit<void>([update, begin, end]() { update(begin, end); }));
   }
 
-  if (node->IsComputeStyleDirty()) {
-    node->OnComputeStyle();
-    node->flags.set(SceneNode::FlagComputeStyleDirty, false);
+  update(0, std::min(kParallelComputeStyleChunkSize, count));
+
+  for (auto& task : tasks) {
+    task.wait();
   }
 }
 
 void Scene::ComputeFlexBoxLayout() {
-  if (YGNodeIsDirty(this->root->ygNode)) {
-    YGNodeCalculateLayout(this->root->ygNode, this->width, this->height, YGDirectionLTR);
-    YGTraversePreOrder(this->root->ygNode, [](YGNodeRef node) { node->setHasNewLayout(false); });
+  auto& stack{ this->layoutStack };
+
+  // Each layer is laid out against the viewport. Clean layers are skipped.
+  for (auto& layer : this->layers) {
+    if (YGNodeIsDirty(layer.root->ygNode)) {
+      YGNodeCalculateLayout(layer.root->ygNode, this->width, this->height, YGDirectionLTR);
+      stack.push_back(layer.root->ygNode);
+      layer.dirty = true;
+      this->isCompositeDirty = true;
+    }
+  }
+
+  if (stack.empty()) {
+    return;
   }
+
+  // Yoga flags the nodes it laid out with hasNewLayout. Descendants of a node without a new layout were not visited
+  // by the layout pass, so the walk prunes those subtrees rather than visiting the whole tree.
+
+  while (!stack.empty()) {
+    auto ygNode{ stack.back() };
+
+    stack.pop_back();
+
+    if (!ygNode->getHasNewLayout()) {
+      continue;
+    }
+
+    auto node{ YGNodeGetContextAs<SceneNode>(ygNode) };
+
+    ygNode->setHasNewLayout(false);
+    this->InvalidateGeometry(node);
+    node->OnFlexBoxLayoutChanged();
+    this->frameStats.layoutCount++;
+
+    // The transform origin and percent translations are relative to the box.
+    if (node->HasTransform()) {
+      node->MarkCompositeStyleDirty();
+    }
+
+    for (auto child : ygNode->getChildren()) {
+      stack.push_back(child);
+    }
+  }
+}
+
+void Scene::RequestPaint(SceneNode* node) noexcept {
+  node->Ref();
+  this->paintRequests.push_back(node);
+}
+
+void Scene::SetPaintBudget(float milliseconds) noexcept {
+  this->paintBudget = std::chrono::microseconds(milliseconds > 0 ? static_cast<int64_t>(milliseconds * 1000) : 0);
+}
+
+float Scene::GetPaintBudget() const noexcept {
+  return static_cast<float>(this->paintBudget.count()) / 1000.f;
 }
 
 void Scene::Paint() {
-  for (auto node : this->paintRequests) {
-    this->compositeContext.Reset(this->GetRenderer());
-    node->Paint(&this->compositeContext);
+  if (this->paintRequests.empty()) {
+    return;
+  }
+
+  using Clock = std::chrono::steady_clock;
+  const auto hasBudget{this->paintBudget.count() > 0};
+  const auto deadline{Clock::now() + this->paintBudget};
+  std::size_t i{0};
+
+  // Nodes requested while painting are painted next frame.
+  std::swap(this->paintRequests, this->paintQueue);
+
+  for (; i < this->paintQueue.size(); i++) {
+    if (hasBudget && i > 0 && Clock::now() >= deadline) {
+      break;
+    }
+
+    auto node{this->paintQueue[i]};
+
+    // Skip nodes that were destroyed while queued.
+    if (node->ygNode) {
+      this->compositeContext.Reset(this->GetRenderer());
+      node->Paint(&this->compositeContext);
+      // Painted textures are drawn by the composite.
+      this->MarkCompositeDirty(node);
+      this->frameStats.paintCount++;
+    }
+
+    node->Unref();
+  }
+
+  // Requests over budget go back to the front of the line, ahead of new requests.
+  if (i < this->paintQueue.size()) {
+    this->paintRequests.insert(this->paintRequests.begin(), this->paintQueue.begin() + i, this->paintQueue.end());
   }
+
+  this->paintQueue.clear();
 }
 
 void Scene::Composite() {
@@ -208,52 +770,463 @@ void Scene::Composite() {
   this->isCompositeDirty = false;
 
   auto renderer{ this->GetRenderer() };
+  const Rect screen{ 0, 0, static_cast<float>(this->width), static_cast<float>(this->height) };
+  const IntRect screenSource{ 0, 0, this->width, this->height };
+
+  // A loaded snapshot stands in for the scene graph. Layers stay dirty until the snapshot is released.
+  if (this->snapshot) {
+    renderer->Reset();
+    this->snapshot->Draw(renderer, this->width, this->height);
+    renderer->Present();
+    return;
+  }
+
+  this->UpdateGeometry();
+
+  // Bring the render targets of dirty cached layers up to date before drawing to the screen.
+  for (auto& layer : this->layers) {
+    if (layer.cached && layer.dirty && this->CompositeLayerTexture(&layer)) {
+      layer.dirty = false;
+    }
+  }
 
   renderer->Reset();
   this->compositeContext.Reset(renderer);
-  this->CompositePreOrder(this->root, &this->compositeContext);
+
+  for (auto& layer : this->layers) {
+    if (layer.cached && layer.texture && !layer.dirty) {
+      renderer->DrawImage(screen, screenSource, layer.texture, {});
+    } else {
+      this->CompositePreOrder(&this->compositeContext, layer.begin, layer.end);
+      layer.dirty = false;
+    }
+  }
+
   renderer->Present();
 }
 
-void Scene::CompositePreOrder(SceneNode* node, CompositeContext* context) {
-  if (node->IsHidden()) {
-    return;
+bool Scene::CompositeLayerTexture(Layer* layer) {
+  auto renderer{ this->GetRenderer() };
+
+  if (layer->texture && (layer->texture->Width() != this->width || layer->texture->Height() != this->height)) {
+    layer->texture = Texture::SafeDestroy(layer->texture);
   }
 
-  const auto boxStyle{ Style::Or(node->style) };
-  const auto box{ YGNodeGetBox(node->ygNode) };
-  const auto clip{ boxStyle->GetEnum(StyleProperty::overflow) == YGOverflowHidden };
+  if (!layer->texture) {
+    layer->texture = renderer->CreateTexture(this->width, this->height, Texture::RenderTarget);
+  }
 
-  if (boxStyle->IsEmpty(StyleProperty::transform)) {
-    context->PushMatrix(Matrix::Translate(box.x, box.y));
-  } else {
-    context->PushMatrix(Matrix::Translate(box.x, box.y)
-                            * this->GetStyleContext()->ComputeTransform(boxStyle, box));
+  if (!layer->texture) {
+    return false;
   }
 
-  context->PushOpacity(GetStyleContext()->ComputeOpacity(boxStyle));
+  renderer->Reset();
+  renderer->SetRenderTarget(layer->texture);
+  renderer->Clear(ColorTransparent);
+  this->compositeContext.Reset(renderer);
+  this->CompositePreOrder(&this->compositeContext, layer->begin, layer->end);
+
+  return true;
+}
+
+void Scene::CompositePreOrder(CompositeContext* context, uint32_t begin, uint32_t end) {
+  const auto& nodes{ this->GetFlatTree() };
+  auto& scopes{ this->compositeScopes };
+  auto popScope = [context, &scopes]() {
+    if (scopes.back().layoutOnly) {
+      scopes.pop_back();
+      return;
+    }
+
+    if (scopes.back().scroll) {
+      context->PopMatrix();
+    }
+
+    if (scopes.back().clip) {
+      context->PopClipRect();
+    }
+
+    context->PopOpacity();
+    context->PopMatrix();
+    scopes.pop_back();
+  };
+  const Rect viewport{ 0, 0, static_cast<float>(this->width), static_cast<float>(this->height) };
+  uint32_t i{ begin };
+
+  while (i < end) {
+    // Restore the context state of the subtrees that end here.
+    while (!scopes.empty() && i >= scopes.back().end) {
+      popScope();
+    }
+
+    const auto& entry{ nodes[i] };
+    auto node{ entry.node };
+
+    if (node->IsHidden()) {
+      this->frameStats.culledCount += entry.subtreeSize;
+      i += entry.subtreeSize;
+      continue;
+    }
+
+    const auto box{ YGNodeGetBox(node->ygNode) };
+    const auto offset{ scopes.empty() ? Point{} : scopes.back().offset };
+
+    // Normally a no-op: the compute style phase updates the composite style. Catches nodes styled during that phase.
+    node->UpdateCompositeStyle();
+
+    // Layout-only nodes have nothing to draw, cull or push: pass their position down to their children.
+    if (node->IsLayoutOnly()) {
+      node->flags.set(SceneNode::FlagCompositeDirty, false);
+      scopes.push_back({ i + entry.subtreeSize, false, false, true, { offset.x + box.x, offset.y + box.y } });
+      this->frameStats.layoutOnlyCount++;
+      i++;
+      continue;
+    }
+
+    const auto boxStyle{ Style::Or(node->style) };
+    const auto scroll{ node->IsScrollContainer() };
+    const auto clip{ IsClipping(node, boxStyle) };
+    const auto onScreen{ Intersects(this->geometry[i].bounds, viewport) };
+
+    // Cull off screen nodes using the cached geometry. The children of a clipping node cannot be drawn outside of it.
+    if (clip && !onScreen) {
+      this->frameStats.culledCount += entry.subtreeSize;
+      i += entry.subtreeSize;
+      continue;
+    }
+
+    const auto translate{ Matrix::Translate(offset.x + box.x, offset.y + box.y) };
+
+    if (node->HasTransform()) {
+      context->PushMatrix(translate * node->GetTransform());
+    } else {
+      context->PushMatrix(translate);
+    }
+
+    context->PushOpacity(node->GetOpacity());
+
+    if (clip) {
+      context->PushClipRect(box);
+    }
+
+    if (onScreen && !IsEmpty(box)) {
+      node->Composite(context);
+      node->flags.set(SceneNode::FlagCompositeDirty, false);
+      this->frameStats.compositeCount++;
+    } else {
+      this->frameStats.culledCount++;
+    }
+
+    if (scroll) {
+      const auto offset{ node->GetContentOffset() };
+
+      context->PushMatrix(Matrix::Translate(offset.x, offset.y));
+    }
+
+    scopes.push_back({ i + entry.subtreeSize, clip, scroll, false, {} });
+    i++;
+  }
 
-  if (clip) {
-    context->PushClipRect(box);
+  while (!scopes.empty()) {
+    popScope();
   }
+}
+
+const std::vector<Scene::FlatNode>& Scene::GetFlatTree() {
+  if (this->isFlatTreeDirty) {
+    this->flatTree.clear();
+
+    for (auto& layer : this->layers) {
+      layer.begin = static_cast<uint32_t>(this->flatTree.size());
+      this->FlattenPreOrder(layer.root);
+      layer.end = static_cast<uint32_t>(this->flatTree.size());
+    }
 
-  if (!IsEmpty(box)) {
-    node->Composite(context);
-    node->flags.set(SceneNode::FlagCompositeDirty, false);
+    this->isFlatTreeDirty = false;
   }
 
+  return this->flatTree;
+}
+
+void Scene::FlattenPreOrder(SceneNode* node) {
+  const auto index{ this->flatTree.size() };
+
+  node->flatIndex = static_cast<uint32_t>(index);
+  this->flatTree.push_back({ node, 1 });
+
   if (node->HasChildren()) {
-    for (auto child : node->GetChildrenOrderedByZIndex()) {
-      CompositePreOrder(child, context);
+    node->VisitChildrenInZOrder([this](SceneNode* child) {
+      this->FlattenPreOrder(child);
+    });
+  }
+
+  this->flatTree[index].subtreeSize = static_cast<uint32_t>(this->flatTree.size() - index);
+}
+
+bool Scene::IsInFlatTree(SceneNode* node) const noexcept {
+  return node && node->flatIndex < this->flatTree.size() && this->flatTree[node->flatIndex].node == node;
+}
+
+SceneNode* Scene::FindFocus(SceneNode* from, FocusDirection direction, SceneNode* within) {
+  if (!this->root) {
+    return nullptr;
+  }
+
+  this->SyncGeometry();
+  this->UpdateFocusIndex();
+
+  uint32_t begin{ 0 };
+  auto end{ static_cast<uint32_t>(this->flatTree.size()) };
+
+  if (within) {
+    if (!this->IsInFlatTree(within)) {
+      return nullptr;
+    }
+
+    begin = within->flatIndex;
+    end = begin + this->flatTree[begin].subtreeSize;
+  }
+
+  if (!this->IsInFlatTree(from) || IsEmpty(this->geometry[from->flatIndex].bounds)) {
+    return this->focusIndex.First(begin, end);
+  }
+
+  return this->focusIndex.Find(this->geometry[from->flatIndex].bounds, direction, begin, end, from);
+}
+
+const NodeGeometry* Scene::GetGeometry(SceneNode* node) {
+  if (!this->root) {
+    return nullptr;
+  }
+
+  this->SyncGeometry();
+
+  return this->IsInFlatTree(node) ? &this->geometry[node->flatIndex] : nullptr;
+}
+
+SceneNode* Scene::HitTest(float x, float y) {
+  if (!this->root) {
+    return nullptr;
+  }
+
+  this->SyncGeometry();
+
+  const auto count{ static_cast<uint32_t>(this->flatTree.size()) };
+  SceneNode* hit{};
+  uint32_t i{ 0 };
+
+  // The last node hit in paint order is the top most.
+  while (i < count) {
+    const auto& entry{ this->flatTree[i] };
+    const auto inside{ Contains(this->geometry[i].bounds, x, y) };
+
+    if (entry.node->IsHidden() || (!inside && IsClipping(entry.node, Style::Or(entry.node->style)))) {
+      i += entry.subtreeSize;
+      continue;
+    }
+
+    if (inside) {
+      hit = entry.node;
+    }
+
+    i++;
+  }
+
+  return hit;
+}
+
+void Scene::SyncGeometry() {
+  this->ComputeFlexBoxLayout();
+  this->UpdateGeometry();
+}
+
+void Scene::InvalidateGeometry(SceneNode* node) noexcept {
+  this->isFocusIndexDirty = true;
+
+  // Flat tree changes invalidate all geometry, so the recorded indices stay valid until the next UpdateGeometry().
+  if (this->isGeometryDirty || !this->IsInFlatTree(node)) {
+    return;
+  }
+
+  this->geometryRequests.push_back(node->flatIndex);
+}
+
+void Scene::UpdateGeometry() {
+  const auto& nodes{ this->GetFlatTree() };
+  auto& requests{ this->geometryRequests };
+  const Rect viewport{ 0, 0, static_cast<float>(this->width), static_cast<float>(this->height) };
+
+  if (this->isGeometryDirty) {
+    const auto count{ static_cast<uint32_t>(nodes.size()) };
+
+    this->isGeometryDirty = false;
+    requests.clear();
+    this->geometry.resize(count);
+    this->UpdateGeometry(0, count, Matrix::Identity(), viewport);
+  } else if (!requests.empty()) {
+    uint32_t end{ 0 };
+
+    // Parents first, so a subtree nested in another invalidated subtree is computed once, with the outer one.
+    std::sort(requests.begin(), requests.end());
+
+    for (auto begin : requests) {
+      if (begin < end) {
+        continue;
+      }
+
+      auto node{ nodes[begin].node };
+      auto parent{ node->GetParent() };
+      auto transform{ Matrix::Identity() };
+      auto clip{ viewport };
+      auto hidden{ false };
+
+      end = begin + nodes[begin].subtreeSize;
+
+      for (auto ancestor{ parent }; ancestor; ancestor = ancestor->GetParent()) {
+        if (ancestor->IsHidden()) {
+          hidden = true;
+          break;
+        }
+      }
+
+      if (hidden) {
+        std::fill(this->geometry.begin() + begin, this->geometry.begin() + end, NodeGeometry{ Matrix::Identity() });
+      } else {
+        // Layer roots have no parent. Otherwise, the parent precedes the subtree and its geometry is up to date.
+        if (parent && this->IsInFlatTree(parent)) {
+          const auto& parentGeometry{ this->geometry[parent->flatIndex] };
+          const auto offset{ parent->GetContentOffset() };
+
+          transform = parentGeometry.transform * Matrix::Translate(offset.x, offset.y);
+          clip = IsClipping(parent, Style::Or(parent->style))
+              ? Intersect(parentGeometry.clip, parentGeometry.bounds) : parentGeometry.clip;
+        }
+
+        this->UpdateGeometry(begin, end, transform, clip);
+      }
+    }
+
+    requests.clear();
+  } else {
+    return;
+  }
+
+  this->geometryVersion++;
+}
+
+void Scene::UpdateGeometry(uint32_t begin, uint32_t end, const Matrix& transform, const Rect& clip) {
+  const auto& nodes{ this->flatTree };
+  auto& scopes{ this->geometryScopes };
+  auto i{ begin };
+
+  scopes.push_back({ end, transform, clip });
+
+  // Same walk and transforms as the composite.
+  while (i < end) {
+    while (i >= scopes.back().end) {
+      scopes.pop_back();
+    }
+
+    const auto& entry{ nodes[i] };
+    auto node{ entry.node };
+
+    if (node->IsHidden()) {
+      std::fill_n(this->geometry.begin() + i, entry.subtreeSize, NodeGeometry{ Matrix::Identity() });
+      i += entry.subtreeSize;
+      continue;
     }
+
+    const auto box{ YGNodeGetBox(node->ygNode) };
+    auto nodeTransform{ scopes.back().transform };
+
+    // Geometry queries can run between frames, before the compute style phase.
+    node->UpdateCompositeStyle();
+    nodeTransform *= Matrix::Translate(box.x, box.y);
+
+    if (node->HasTransform()) {
+      nodeTransform *= node->GetTransform();
+    }
+
+    const auto& scope{ scopes.back() };
+    const auto bounds{ TransformBounds(nodeTransform, box.width, box.height) };
+
+    this->geometry[i] = { nodeTransform, bounds, scope.clip };
+
+    if (entry.subtreeSize > 1) {
+      const auto offset{ node->GetContentOffset() };
+      // Same test as the composite, which clips the children of these nodes to their box.
+      const auto childClip{ IsClipping(node, Style::Or(node->style)) ? Intersect(scope.clip, bounds) : scope.clip };
+
+      scopes.push_back({ i + entry.subtreeSize, nodeTransform * Matrix::Translate(offset.x, offset.y), childClip });
+    }
+
+    i++;
+  }
+
+  scopes.clear();
+}
+
+void Scene::UpdateObservers() {
+  if (this->observers.IsEmpty() || !this->root) {
+    return;
+  }
+
+  this->UpdateGeometry();
+
+  if (this->geometryVersion == this->observedGeometryVersion && !this->observers.IsDirty()) {
+    return;
   }
 
-  if (clip) {
-    context->PopClipRect();
+  this->observedGeometryVersion = this->geometryVersion;
+  this->observers.Update(
+      [this](SceneNode* node) { return this->IsInFlatTree(node) ? &this->geometry[node->flatIndex] : nullptr; });
+}
+
+void Scene::AddObserver(uint32_t id, NodeObserverType type, std::vector<float>&& thresholds) {
+  this->observers.Add(id, type, std::move(thresholds));
+}
+
+void Scene::RemoveObserver(uint32_t id) noexcept {
+  this->observers.Remove(id);
+}
+
+bool Scene::Observe(uint32_t id, SceneNode* node) {
+  return this->observers.Observe(id, node);
+}
+
+void Scene::Unobserve(uint32_t id, SceneNode* node) noexcept {
+  this->observers.Unobserve(id, node);
+}
+
+const std::vector<NodeObserverRecord>& Scene::GetObserverRecords() const noexcept {
+  return this->observers.GetRecords();
+}
+
+void Scene::ClearObserverRecords() noexcept {
+  this->observers.ClearRecords();
+}
+
+void Scene::UpdateFocusIndex() {
+  if (!this->isFocusIndexDirty) {
+    return;
+  }
+
+  const auto count{ static_cast<uint32_t>(this->flatTree.size()) };
+
+  this->isFocusIndexDirty = false;
+  this->focusIndex.Clear();
+
+  // Geometry is up to date (SyncGeometry()). Hidden nodes have empty bounds.
+  for (uint32_t i = 0; i < count; i++) {
+    auto node{ this->flatTree[i].node };
+    const auto& bounds{ this->geometry[i].bounds };
+
+    if (node->IsFocusable() && !IsEmpty(bounds)) {
+      this->focusIndex.Insert(node, bounds, i);
+    }
   }
 
-  context->PopOpacity();
-  context->PopMatrix();
+  this->focusIndex.Build();
 }
 
 bool Scene::SyncStyleContext() {
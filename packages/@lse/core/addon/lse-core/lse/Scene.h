@@ -14,6 +14,8 @@
 #pragma once
 
 #include <lse/CompositeContext.h>
+#include <lse/FocusIndex.h>
+#include <lse/NodeObserver.h>
 #include <lse/StyleContext.h>
 #include <lse/GraphicsContext.h>
 #include <lse/Reference.h>
@@ -23,6 +25,8 @@
 #include <lse/StyleEnums.h>
 
 #include <algorithm>
+#include <array>
+#include <chrono>
 #include <memory>
 #include <phmap.h>
 
@@ -31,6 +35,68 @@ namespace lse {
 class Renderer;
 class RootSceneNode;
 class SceneNode;
+class SceneNodePool;
+class SceneSnapshot;
+class Texture;
+
+/**
+ * Scene graph mutations recorded by JS in a command buffer. Each command is kSceneCommandSize words: the command
+ * followed by node ids. Unused arguments are 0.
+ */
+enum SceneCommand : uint32_t {
+  SceneCommandAppendChild, // parent, child
+  SceneCommandInsertBefore, // parent, child, before
+  SceneCommandRemoveChild, // parent, child
+  SceneCommandSetHidden, // node, hidden (0 or 1)
+  SceneCommandDestroy, // node
+  SceneCommandSetFocusable, // node, focusable (0 or 1)
+};
+
+constexpr std::size_t kSceneCommandSize{4};
+
+/**
+ * Work done by one Scene::Frame(), by phase. Work done between frames (layout forced by a focus query, texture uploads
+ * of image loads, etc) is counted in the next frame.
+ */
+struct FrameStats {
+  // Sequence number of the frame, starting at 1.
+  uint32_t frame{};
+  // Nodes with a new layout after the flexbox phase.
+  uint32_t layoutCount{};
+  // Nodes processed by the compute style phase.
+  uint32_t computeStyleCount{};
+  // Nodes painted by the paint phase.
+  uint32_t paintCount{};
+  // Nodes drawn by the composite phase.
+  uint32_t compositeCount{};
+  // Nodes skipped by the composite phase: nodes in hidden subtrees and nodes with an empty box.
+  uint32_t culledCount{};
+  // Layout-only nodes passed through by the composite phase, without drawing or context state changes.
+  uint32_t layoutOnlyCount{};
+  // Renderer work (see RenderStats).
+  uint32_t drawCalls{};
+  uint32_t textureUploads{};
+  uint32_t stateChanges{};
+  // Duration of Frame(), from the first Update() to Render(), in microseconds.
+  uint32_t frameTime{};
+};
+
+/**
+ * Screen-space geometry of a node, cached by the Scene.
+ */
+struct NodeGeometry {
+  // Maps the node's box, with origin 0,0, to the screen. Includes layout position, the transform style and the scroll
+  // offsets of ancestors.
+  Matrix transform;
+  // Screen-space bounding box of the transformed box. Empty if the node is hidden.
+  Rect bounds;
+  // Screen-space area the node can be drawn in: the viewport intersected with the bounds of the clipping ancestors
+  // (overflow hidden and scroll containers, including lists). Empty if the node is hidden.
+  Rect clip;
+};
+
+// Number of frames of FrameStats history kept by a Scene.
+constexpr std::size_t kFrameStatsCount{60};
 
 /**
  * Manages the SceneNode graph and renders frames to the screen.
@@ -44,13 +110,45 @@ class Scene : public Reference {
   void Detach();
   void Destroy() noexcept;
 
+  /**
+   * Render a frame: Update() followed by Render().
+   */
   void Frame();
+
+  /**
+   * First half of a frame: media changes, layout, observers and compute style. Can be called again before Render(),
+   * for example, to lay out list items bound in response to a range change made by the compute style phase.
+   */
+  void Update();
+
+  /**
+   * Second half of a frame: paint and composite. Completes the frame stats started by Update().
+   */
+  void Render();
+
   void SetRoot(RootSceneNode* root);
 
+  /**
+   * Add a layer: a scene graph root composited over the main tree, for toasts, FPS counters, cursors, modals, etc.
+   *
+   * Layers are laid out against the viewport and composited in ascending z-index order. The main tree (SetRoot()) is
+   * the layer at z-index 0; layers with equal z-index are composited in the order they were added. Dirty state is
+   * tracked per layer. A cached layer is composited into its own render target and redrawn only when a node in it
+   * changes, so an animating overlay recomposites itself over the cached main tree.
+   *
+   * @throws std::runtime_error if root has a parent or is already a layer root
+   */
+  void AddLayer(SceneNode* root, int32_t zIndex);
+  void RemoveLayer(SceneNode* root) noexcept;
+  void SetLayerZIndex(SceneNode* root, int32_t zIndex);
+  void SetLayerCached(SceneNode* root, bool cached);
+  bool IsLayerRoot(SceneNode* node) const noexcept;
+
   Stage* GetStage() const noexcept { return this->stage.Get(); }
   FontManager* GetFontManager() const noexcept;
   ImageManager* GetImageManager() const noexcept;
   Renderer* GetRenderer() const noexcept;
+  SceneNodePool* GetNodePool() const noexcept { return this->nodePool; }
 
   StyleContext* GetStyleContext() const noexcept { return &this->styleContext; }
   int32_t GetWidth() const noexcept { return this->width; }
@@ -58,36 +156,280 @@ class Scene : public Reference {
 
   void OnRootFontSizeChange() noexcept;
 
-  void MarkComputeStyleDirty() noexcept { this->isComputeStyleDirty = true; }
-  void MarkCompositeDirty() noexcept { this->isCompositeDirty = true; }
+  /**
+   * Register a node of this scene, so command buffers can refer to it by id.
+   *
+   * @return id of the node; never 0
+   */
+  uint32_t RegisterNode(SceneNode* node);
+  void UnregisterNode(uint32_t id) noexcept;
+  SceneNode* GetNode(uint32_t id) const noexcept;
+
+  /**
+   * Apply a buffer of SceneCommands, in order.
+   *
+   * JS records appendChild, insertBefore, etc. in a command buffer and sends it in one call, rather than crossing
+   * into native for each mutation. On error, commands before the failed command remain applied.
+   *
+   * @param length number of words in commands
+   * @throws std::runtime_error for malformed commands, unknown node ids or a failed mutation
+   */
+  void ApplyCommands(const uint32_t* commands, std::size_t length);
+
+  /**
+   * Queue a node for OnComputeStyle() in the next frame.
+   *
+   * Only queued nodes are visited by ComputeStyle(), rather than walking the tree for dirty nodes. The scene holds a
+   * reference to a queued node until it is processed.
+   */
+  void RequestComputeStyle(SceneNode* node) noexcept;
+
+  /**
+   * Queue a node for Paint() before the next composite. The scene holds a reference to a queued node until it is
+   * painted.
+   */
+  void RequestPaint(SceneNode* node) noexcept;
+
+  /**
+   * Limit the time spent servicing paint requests per frame. Requests that do not fit in the budget are painted in
+   * later frames. At least one request is serviced per frame.
+   *
+   * @param milliseconds Budget in milliseconds. 0 or less removes the limit.
+   */
+  void SetPaintBudget(float milliseconds) noexcept;
+  float GetPaintBudget() const noexcept;
+
+  /**
+   * Stats of the most recent frames. Collected for every frame; the cost is a few counter increments per node.
+   *
+   * @return number of frames available, up to kFrameStatsCount
+   */
+  std::size_t GetFrameStatsCount() const noexcept;
+
+  /**
+   * @param index 0 is the oldest available frame, GetFrameStatsCount() - 1 the most recent
+   */
+  const FrameStats& GetFrameStats(std::size_t index) const noexcept;
+
+  /**
+   * Duration, in microseconds, of the last Attach(): graphics context attach, texture uploads from image shadows and
+   * node attach. Images without a shadow load after Attach() returns (see ImageManager::GetAttachLoadCount()).
+   */
+  uint32_t GetAttachTime() const noexcept;
+
+  /**
+   * Record the scene into a binary SceneSnapshot. The snapshot reflects the current layout and the styles computed by
+   * the last frame.
+   *
+   * @throws std::runtime_error if the scene has no screen size (never attached)
+   */
+  std::vector<uint8_t> SaveSnapshot();
+
+  /**
+   * Show a snapshot, created by SaveSnapshot() in this or another process, in place of the scene graph until
+   * ReleaseSnapshot() is called. The scene graph can be built and updated while the snapshot is shown.
+   *
+   * @throws std::runtime_error if data is not a valid snapshot
+   */
+  void LoadSnapshot(const uint8_t* data, std::size_t size);
+  void ReleaseSnapshot() noexcept;
+  bool HasSnapshot() const noexcept;
+
+  // Mark all layers for composite.
+  void MarkCompositeDirty() noexcept;
+  // Mark the layer containing node for composite. No-op if node is not in a layer.
+  void MarkCompositeDirty(SceneNode* node) noexcept;
+
+  /**
+   * Invalidate the flattened node tree. Called on structural changes: children added or removed, or children
+   * reordered by z-index.
+   */
+  void InvalidateFlatTree() noexcept {
+    this->isFlatTreeDirty = true;
+    this->InvalidateGeometry();
+  }
+
+  /**
+   * Invalidate the cached geometry of all nodes. Called on structural and media changes.
+   */
+  void InvalidateGeometry() noexcept { this->isGeometryDirty = this->isFocusIndexDirty = true; }
+
+  /**
+   * Invalidate the cached geometry of node and its subtree. Called on layout, transform, hidden and scroll offset
+   * changes. Only the invalidated subtrees are recomputed.
+   */
+  void InvalidateGeometry(SceneNode* node) noexcept;
+
+  /**
+   * Get the screen-space geometry of a node.
+   *
+   * Geometry is cached for all nodes and recomputed in one pass when invalidated, so queries do not walk ancestors.
+   * Layout is computed first if it is dirty, so this can be called between frames.
+   *
+   * @return geometry of node; nullptr if node is not in the scene graph
+   */
+  const NodeGeometry* GetGeometry(SceneNode* node);
+
+  /**
+   * Find the top most visible node whose bounds contain a screen point. Parts of nodes clipped by an ancestor (overflow
+   * hidden or a scroll container) are not hit.
+   *
+   * @return the hit node; nullptr if no node is hit
+   */
+  SceneNode* HitTest(float x, float y);
+
+  /**
+   * Find the focusable node nearest to from in direction. Used to resolve arrow key and d-pad focus moves.
+   *
+   * The query runs against a spatial index of the absolute layout rects of focusable, visible nodes. The index is
+   * rebuilt lazily, after layout or focusable nodes change. Layout is computed first if it is dirty.
+   *
+   * @param from origin of the move. If null or not in the scene graph, the first focusable node is returned.
+   * @param within if not null, only nodes in the subtree of within are considered
+   * @return the nearest focusable node; nullptr if there is no focusable node in direction
+   */
+  SceneNode* FindFocus(SceneNode* from, FocusDirection direction, SceneNode* within);
+
+  /**
+   * Invalidate the focus index. Called when a node's focusable or hidden state changes or a scroll container scrolls.
+   */
+  void InvalidateFocusIndex() noexcept { this->isFocusIndexDirty = true; }
+
+  /**
+   * Add a resize or intersection observer (see NodeObserverSet).
+   *
+   * Observed nodes are evaluated each frame, after layout, against the cached node geometry. Evaluation is skipped on
+   * frames where geometry did not change. Records of the changes accumulate until ClearObserverRecords().
+   *
+   * @throws std::runtime_error if id is in use or type is invalid
+   */
+  void AddObserver(uint32_t id, NodeObserverType type, std::vector<float>&& thresholds);
+  void RemoveObserver(uint32_t id) noexcept;
+  // Observe node. Returns false if there is no observer with id.
+  bool Observe(uint32_t id, SceneNode* node);
+  void Unobserve(uint32_t id, SceneNode* node) noexcept;
+  const std::vector<NodeObserverRecord>& GetObserverRecords() const noexcept;
+  void ClearObserverRecords() noexcept;
 
  private:
+  // Entry of the flattened node tree. The subtree of node is the subtreeSize entries starting with node.
+  struct FlatNode {
+    SceneNode* node;
+    uint32_t subtreeSize;
+  };
+
+  // Context state pushed by a node in composite. Popped at end, the index past the node's subtree.
+  struct CompositeScope {
+    uint32_t end;
+    bool clip;
+    bool scroll;
+    // Pushed by a layout-only node: no context state to pop.
+    bool layoutOnly;
+    // Translation of the children not applied to the context matrix: the positions of layout-only ancestors.
+    Point offset;
+  };
+
+  struct Layer {
+    SceneNode* root;
+    int32_t zIndex;
+    bool cached;
+    bool dirty;
+    // Render target of a cached layer. Screen sized.
+    Texture* texture;
+    // Range of the layer's nodes in the flat tree: [begin, end).
+    uint32_t begin;
+    uint32_t end;
+  };
+
+  // Transform of the children of a node, while computing geometry. Popped at end.
+  struct GeometryScope {
+    uint32_t end;
+    Matrix transform;
+    Rect clip;
+  };
+
   void DispatchMediaChange();
   void ComputeStyle();
+  // Run UpdateCompositeStyle() of the nodes queued for compute style. Large batches run on the thread pool.
+  void UpdateCompositeStyles();
+  // Run UpdateCompositeStyle() of nodes on the thread pool. Returns when all nodes are updated.
+  void UpdateCompositeStyleParallel(const std::vector<SceneNode*>& nodes);
   void ComputeFlexBoxLayout();
   void Paint();
   void Composite();
-  void ComputeStylePostOrder(SceneNode* node);
-  void CompositePreOrder(SceneNode* node, CompositeContext* context);
+  void CompositePreOrder(CompositeContext* context, uint32_t begin, uint32_t end);
+  // Composite a cached layer into its render target. Returns false if the render target is not available.
+  bool CompositeLayerTexture(Layer* layer);
+  Layer* FindLayer(SceneNode* root) noexcept;
+  void SortLayers();
+  void DestroyLayerTextures() noexcept;
+  const std::vector<FlatNode>& GetFlatTree();
+  void FlattenPreOrder(SceneNode* node);
+  bool IsInFlatTree(SceneNode* node) const noexcept;
+  void UpdateGeometry();
+  // Compute the geometry of the flat tree entries in [begin, end), with transform mapping the parent's content box to
+  // the screen and clip the screen-space clip of the parent's children.
+  void UpdateGeometry(uint32_t begin, uint32_t end, const Matrix& transform, const Rect& clip);
+  void UpdateObservers();
+  // Bring layout and geometry up to date for a query made outside of Frame().
+  void SyncGeometry();
+  void UpdateFocusIndex();
   bool SyncStyleContext();
+  static void SnapshotImageListener(void* owner, Image* image) noexcept;
 
  private:
   ReferenceHolder<Stage> stage{};
   ReferenceHolder<FontManager> fontManager{};
   ReferenceHolder<ImageManager> imageManager{};
   ReferenceHolder<GraphicsContext> graphicsContext{};
+  // Released in the destructor. Nodes hold their own references, so the pool outlives the scene if they do.
+  SceneNodePool* nodePool{};
   SceneNode* root{};
+  // Layers in composite order, including the layer of root. Each layer holds a reference to its root.
+  std::vector<Layer> layers;
   mutable StyleContext styleContext{ 0, 0, 0 };
   int32_t width{};
   int32_t height{};
   float lastRootFontSize{ DEFAULT_REM_FONT_SIZE };
   bool isViewportSizeDirty{ true };
   bool isRootFontSizeDirty{ false };
-  bool isComputeStyleDirty{ false };
   bool isCompositeDirty{ false };
   bool isAttached{ false };
   std::vector<SceneNode*> paintRequests;
+  std::vector<SceneNode*> paintQueue;
+  std::chrono::microseconds paintBudget{0};
+  uint32_t attachTime{};
+  std::unique_ptr<SceneSnapshot> snapshot;
+  std::vector<SceneNode*> computeStyleRequests;
+  std::vector<SceneNode*> computeStyleQueue;
+  phmap::flat_hash_map<uint32_t, SceneNode*> nodesById{};
+  uint32_t nextNodeId{1};
   CompositeContext compositeContext;
+  // Stats of the frame in progress and a ring buffer of completed frames.
+  FrameStats frameStats{};
+  std::array<FrameStats, kFrameStatsCount> frameStatsHistory{};
+  uint32_t frameCount{};
+  // Start of the frame in progress. Set by the first Update() of a frame.
+  std::chrono::steady_clock::time_point frameStart{};
+  // Nodes in paint order (pre-order, children in z-order). Frame phases iterate this array rather than walking the
+  // yoga tree. Rebuilt on the next frame after a structural change.
+  std::vector<FlatNode> flatTree;
+  std::vector<CompositeScope> compositeScopes;
+  bool isFlatTreeDirty{ true };
+  FocusIndex focusIndex;
+  bool isFocusIndexDirty{ true };
+  // Geometry of each flat tree entry, by flat tree index.
+  std::vector<NodeGeometry> geometry;
+  std::vector<GeometryScope> geometryScopes;
+  bool isGeometryDirty{ true };
+  // Flat tree indices of the subtrees invalidated by InvalidateGeometry(node). Unused while all geometry is dirty.
+  std::vector<uint32_t> geometryRequests;
+  // Incremented when geometry is recomputed. Observers are evaluated when it changes.
+  uint32_t geometryVersion{};
+  uint32_t observedGeometryVersion{};
+  NodeObserverSet observers;
+  // Traversal stack of ComputeFlexBoxLayout(). A member so the storage is reused between frames.
+  std::vector<YGNodeRef> layoutStack;
 };
 
 } // namespace lse
@@ -19,6 +19,7 @@
 #include <lse/Style.h>
 #include <lse/StyleContext.h>
 #include <lse/Scene.h>
+#include <lse/SceneNodePool.h>
 #include <lse/Stage.h>
 #include <lse/CompositeContext.h>
 #include <lse/Renderer.h>
@@ -30,14 +31,53 @@ namespace lse {
 
 int32_t SceneNode::instanceCount{0};
 
+// Properties cached by SceneNode::UpdateCompositeStyle().
+static bool IsCompositeStyleProperty(StyleProperty property) noexcept {
+  switch (property) {
+    case StyleProperty::filter:
+    case StyleProperty::opacity:
+    case StyleProperty::transform:
+    case StyleProperty::transformOriginX:
+    case StyleProperty::transformOriginY:
+    // Properties that decide whether a node is layout-only.
+    case StyleProperty::backgroundColor:
+    case StyleProperty::backgroundImage:
+    case StyleProperty::borderColor:
+    case StyleProperty::overflow:
+      return true;
+    default:
+      return false;
+  }
+}
+
 SceneNode::SceneNode(Scene* scene) : scene(scene) {
   assert(scene != nullptr);
 
-  this->ygNode = YGNodeNew();
+  this->ygNode = &this->ygNodeStorage;
   YGNodeSetContext(this->ygNode, this);
+  this->id = scene->RegisterNode(this);
   instanceCount++;
 }
 
+SceneNode::~SceneNode() {
+  // Nodes released without Destroy() are still registered.
+  if (this->scene) {
+    this->scene->UnregisterNode(this->id);
+  }
+}
+
+void* SceneNode::operator new(std::size_t size, Scene* scene) noexcept {
+  return scene->GetNodePool()->Allocate(size);
+}
+
+void SceneNode::operator delete(void* p, Scene* scene) noexcept {
+  SceneNodePool::Free(p);
+}
+
+void SceneNode::operator delete(void* p) noexcept {
+  SceneNodePool::Free(p);
+}
+
 int32_t SceneNode::GetInstanceCount() noexcept {
   return SceneNode::instanceCount;
 }
@@ -67,13 +107,39 @@ void SceneNode::BindStyle(Style* style) noexcept {
     if (IsYogaProperty(property)) {
       this->GetStyleContext()->SetYogaPropertyValue(this->style, property, this->ygNode);
     } else {
+      if (IsCompositeStyleProperty(property)) {
+        this->MarkCompositeStyleDirty();
+      }
+
+      if (IsInheritedProperty(property)) {
+        this->MarkDescendantsComputeStyleDirty();
+      }
+
       this->OnStylePropertyChanged(property);
     }
   });
+  this->MarkCompositeStyleDirty();
 }
 
 void SceneNode::SetHidden(bool value) noexcept {
-  this->flags.set(FlagHidden, value);
+  if (value != this->flags.test(FlagHidden)) {
+    this->flags.set(FlagHidden, value);
+
+    if (this->scene) {
+      this->MarkCompositeDirty();
+      this->scene->InvalidateGeometry(this);
+    }
+  }
+}
+
+void SceneNode::SetFocusable(bool value) noexcept {
+  if (value != this->flags.test(FlagFocusable)) {
+    this->flags.set(FlagFocusable, value);
+
+    if (this->scene) {
+      this->scene->InvalidateFocusIndex();
+    }
+  }
 }
 
 ImageManager* SceneNode::GetImageManager() const noexcept {
@@ -104,7 +170,12 @@ void SceneNode::AppendChild(SceneNode* node) {
     throw std::runtime_error("node already has a parent");
   }
 
+  if (this->scene->IsLayerRoot(node)) {
+    throw std::runtime_error("node is a layer root");
+  }
+
   YGNodeInsertChild(this->ygNode, node->ygNode, YGNodeGetChildCount(this->ygNode));
+  this->InvalidateZOrder();
 
   // Add reference for the added child.
   node->Ref();
@@ -129,6 +200,10 @@ void SceneNode::InsertBefore(SceneNode* node, SceneNode* before) {
     throw std::runtime_error("child already has a parent");
   }
 
+  if (this->scene->IsLayerRoot(node)) {
+    throw std::runtime_error("node is a layer root");
+  }
+
   if (before == nullptr) {
     throw std::runtime_error("before must be a SceneNode");
   }
@@ -140,6 +215,7 @@ void SceneNode::InsertBefore(SceneNode* node, SceneNode* before) {
   }
 
   YGNodeInsertChild(this->ygNode, node->ygNode, beforeIndex);
+  this->InvalidateZOrder();
 
   // Add reference for the added child.
   node->Ref();
@@ -153,6 +229,7 @@ void SceneNode::RemoveChild(SceneNode* node) noexcept {
   }
 
   YGNodeRemoveChild(this->ygNode, node->ygNode);
+  this->InvalidateZOrder();
 
   // Remove reference for the child.
   node->Unref();
@@ -162,12 +239,18 @@ void SceneNode::RemoveChild(SceneNode* node) noexcept {
 }
 
 void SceneNode::Paint(CompositeContext* ctx) {
+  this->flags.set(FlagPaintDirty, false);
+  this->OnPaint(ctx->renderer);
+
+  if (!this->layer) {
+    return;
+  }
+
+  // Render the node's composite into its layer. The layer is drawn in place of the node during composite.
   auto box{YGNodeGetBox(this->ygNode, 0, 0)};
 
-  if (this->layer) {
-    if (this->layer->Width() < box.width || this->layer->Height() < box.height) {
-      this->layer = Texture::SafeDestroy(this->layer);
-    }
+  if (this->layer->Width() < box.width || this->layer->Height() < box.height) {
+    this->layer = Texture::SafeDestroy(this->layer);
   }
 
   if (!this->layer) {
@@ -232,27 +315,49 @@ void SceneNode::Destroy() {
     this->style = nullptr;
   }
 
+  this->scene->UnregisterNode(this->id);
   this->scene = nullptr;
 
-  YGNodeFree(this->ygNode);
+  ReleaseYogaNode(this->ygNode);
   this->ygNode = nullptr;
 
   this->Unref();
 }
 
+void SceneNode::ReleaseYogaNode(YGNodeRef node) noexcept {
+  // YGNodeFree() without the delete: the yoga node is embedded in the SceneNode.
+  if (auto owner{node->getOwner()}) {
+    owner->removeChild(node);
+    node->setOwner(nullptr);
+  }
+
+  for (auto child : node->getChildren()) {
+    child->setOwner(nullptr);
+  }
+
+  node->clearChildren();
+}
+
 void SceneNode::OnStylePropertyChanged(StyleProperty property) {
   switch (property) {
     case StyleProperty::transformOriginX:
     case StyleProperty::transformOriginY:
-    case StyleProperty::opacity:
     case StyleProperty::transform:
-    case StyleProperty::overflow:
+      this->MarkCompositeDirty();
+      this->scene->InvalidateGeometry(this);
+      break;
+    case StyleProperty::opacity:
       // TODO: if in software mode, compute
       this->MarkCompositeDirty();
       break;
+    case StyleProperty::overflow:
+      this->MarkCompositeDirty();
+      // The clip of the descendants changed.
+      this->scene->InvalidateGeometry(this);
+      break;
     case StyleProperty::zIndex:
-      // TODO: addChild(), removeChild()
       if (this->GetParent()) {
+        this->GetParent()->InvalidateZOrder();
         this->GetParent()->MarkCompositeDirty();
       }
       break;
@@ -275,35 +380,47 @@ int32_t SceneNode::GetChildIndex(SceneNode* node) const noexcept {
 }
 
 int32_t SceneNode::GetZIndex(SceneNode* node) const noexcept {
-  return node->style && node->style->GetInteger(StyleProperty::zIndex).value_or(0);
+  return node->style ? node->style->GetInteger(StyleProperty::zIndex).value_or(0) : 0;
 }
 
-const std::vector<SceneNode*>& SceneNode::GetChildrenOrderedByZIndex() {
-  // TODO: sorting can be cached and invalidated on style change or add/remove.
-  SceneNode* node;
-  int32_t lastZ = INT32_MIN;
-  int32_t currentZ;
-  bool outOfOrder{};
+void SceneNode::InvalidateZOrder() noexcept {
+  this->flags.set(FlagZOrderDirty);
 
-  this->sortedChildren.clear();
+  if (this->scene) {
+    this->scene->InvalidateFlatTree();
+    // Children added, removed or reordered: the layer of this node must be recomposited.
+    this->scene->MarkCompositeDirty(this);
+  }
+}
 
-  for (const auto& child : YGNodeGetChildren(this->ygNode)) {
-    node = YGNodeGetContextAs<SceneNode>(child);
+bool SceneNode::UpdateZOrder() {
+  if (!this->flags.test(FlagZOrderDirty)) {
+    return this->flags.test(FlagZOrdered);
+  }
 
-    if (!outOfOrder) {
-      currentZ = this->GetZIndex(node);
+  int32_t lastZ{INT32_MIN};
+  bool outOfOrder{};
 
-      if (currentZ < lastZ) {
-        outOfOrder = true;
-      }
+  // If z-indexes are already ascending in document order (including the common case of no z-indexes), the yoga
+  // children are the paint order and no sorted list is needed.
+  for (const auto& child : YGNodeGetChildren(this->ygNode)) {
+    const auto z{this->GetZIndex(YGNodeGetContextAs<SceneNode>(child))};
 
-      lastZ = currentZ;
+    if (z < lastZ) {
+      outOfOrder = true;
+      break;
     }
 
-    this->sortedChildren.push_back(node);
+    lastZ = z;
   }
 
+  this->sortedChildren.clear();
+
   if (outOfOrder) {
+    for (const auto& child : YGNodeGetChildren(this->ygNode)) {
+      this->sortedChildren.push_back(YGNodeGetContextAs<SceneNode>(child));
+    }
+
     std::stable_sort(
         this->sortedChildren.begin(),
         this->sortedChildren.end(),
@@ -312,7 +429,10 @@ const std::vector<SceneNode*>& SceneNode::GetChildrenOrderedByZIndex() {
         });
   }
 
-  return this->sortedChildren;
+  this->flags.set(FlagZOrdered, outOfOrder);
+  this->flags.set(FlagZOrderDirty, false);
+
+  return outOfOrder;
 }
 
 YGSize SceneNode::OnMeasure(float width, YGMeasureMode widthMode, float height, YGMeasureMode heightMode) {
@@ -323,6 +443,10 @@ bool SceneNode::IsHidden() const noexcept {
   return this->flags.test(FlagHidden);
 }
 
+bool SceneNode::IsFocusable() const noexcept {
+  return this->flags.test(FlagFocusable);
+}
+
 bool SceneNode::IsLayoutOnly() const noexcept {
   return this->flags.test(FlagLayoutOnly);
 }
@@ -335,14 +459,101 @@ bool SceneNode::IsCompositeDirty() const noexcept {
   return this->flags.test(FlagCompositeDirty);
 }
 
+bool SceneNode::IsPaintDirty() const noexcept {
+  return this->flags.test(FlagPaintDirty);
+}
+
 void SceneNode::MarkComputeStyleDirty() noexcept {
-  this->flags.set(FlagComputeStyleDirty);
-  this->scene->MarkComputeStyleDirty();
+  if (!this->flags.test(FlagComputeStyleDirty)) {
+    this->flags.set(FlagComputeStyleDirty);
+    this->scene->RequestComputeStyle(this);
+  }
+}
+
+void SceneNode::MarkDescendantsComputeStyleDirty() noexcept {
+  for (const auto& child : YGNodeGetChildren(this->ygNode)) {
+    auto node{ YGNodeGetContextAs<SceneNode>(child) };
+
+    node->MarkComputeStyleDirty();
+    node->MarkDescendantsComputeStyleDirty();
+  }
+}
+
+void SceneNode::MarkCompositeStyleDirty() noexcept {
+  if (!this->flags.test(FlagCompositeStyleDirty)) {
+    this->flags.set(FlagCompositeStyleDirty);
+    this->scene->RequestComputeStyle(this);
+  }
+
+  this->MarkCompositeDirty();
+}
+
+void SceneNode::UpdateCompositeStyle() noexcept {
+  if (!this->flags.test(FlagCompositeStyleDirty)) {
+    return;
+  }
+
+  auto nodeStyle{ Style::Or(this->style) };
+  auto context{ this->GetStyleContext() };
+
+  this->flags.reset(FlagCompositeStyleDirty);
+
+  // The transform depends on the layout box (transform origin, percent translate), the viewport and the rem size.
+  this->hasTransform = !nodeStyle->IsEmpty(StyleProperty::transform);
+  this->transform = this->hasTransform
+      ? context->ComputeTransform(nodeStyle, YGNodeGetBox(this->ygNode)) : Matrix::Identity();
+  this->opacity = context->ComputeOpacity(nodeStyle);
+  this->filter = {};
+  this->hasFilterTint = false;
+
+  for (const auto& filterFunc : nodeStyle->GetFilter()) {
+    switch (filterFunc.filter) {
+      case StyleFilterTint:
+        this->filter.tint = filterFunc.color;
+        this->hasFilterTint = true;
+        break;
+      case StyleFilterFlipH:
+        this->filter.flipH = true;
+        break;
+      case StyleFilterFlipV:
+        this->filter.flipV = true;
+        break;
+      default:
+        break;
+    }
+  }
+
+  this->flags.set(FlagLayoutOnly,
+      this->IsLayoutOnlyCandidate()
+      && !this->hasTransform
+      && !this->hasFilterTint
+      && !this->filter.HasFlip()
+      && this->opacity >= 1.f
+      && !this->IsScrollContainer()
+      && nodeStyle->IsEmpty(StyleProperty::backgroundColor)
+      && nodeStyle->IsEmpty(StyleProperty::backgroundImage)
+      && nodeStyle->IsEmpty(StyleProperty::borderColor)
+      && nodeStyle->GetEnum(StyleProperty::overflow) != YGOverflowHidden);
+}
+
+RenderFilter SceneNode::GetFilter(color_t fallbackTint, float currentOpacity) const noexcept {
+  return {
+      (this->hasFilterTint ? this->filter.tint : fallbackTint).MixAlpha(currentOpacity),
+      this->filter.flipH,
+      this->filter.flipV
+  };
 }
 
 void SceneNode::MarkCompositeDirty() noexcept {
   this->flags.set(FlagCompositeDirty);
-  this->scene->MarkCompositeDirty();
+  this->scene->MarkCompositeDirty(this);
+}
+
+void SceneNode::RequestPaint() noexcept {
+  if (!this->flags.test(FlagPaintDirty)) {
+    this->flags.set(FlagPaintDirty);
+    this->scene->RequestPaint(this);
+  }
 }
 
 bool SceneNode::HasChildren() const noexcept {
@@ -372,16 +583,6 @@ SceneNode* SceneNode::GetChildAt(uint32_t index) const noexcept {
   return {};
 }
 
-void SceneNode::YogaNodeLayoutEvent(
-    const YGNode& node, facebook::yoga::Event::Type event, const facebook::yoga::Event::Data& data) {
-  assert(event == Event::NodeLayout);
-
-  if (node.getHasNewLayout()) {
-    assert(node.getContext() != nullptr);
-    YGNodeGetContextAs<SceneNode>(&node)->OnFlexBoxLayoutChanged();
-  }
-}
-
 YGSize SceneNode::YogaMeasureCallback(
     YGNodeRef nodeRef, float width, YGMeasureMode widthMode, float height, YGMeasureMode heightMode) {
   assert(nodeRef->getContext() != nullptr);
@@ -13,11 +13,12 @@
 
 #pragma once
 
+#include <lse/Matrix.h>
 #include <lse/Reference.h>
+#include <lse/Renderer.h>
 #include <lse/Scene.h>
 #include <lse/Style.h>
 #include <lse/yoga-ext.h>
-#include <event/event.h>
 #include <lse/StyleEnums.h>
 #include <bitset>
 
@@ -35,8 +36,17 @@ class Texture;
 class SceneNode : public Reference {
  public:
   explicit SceneNode(Scene* scene);
-  ~SceneNode() override = default;
+  ~SceneNode() override;
 
+  /**
+   * Allocate the node from the node pool of scene. Returns nullptr if out of memory.
+   */
+  static void* operator new(std::size_t size, Scene* scene) noexcept;
+  static void operator delete(void* p, Scene* scene) noexcept;
+  static void operator delete(void* p) noexcept;
+
+  // Id of this node in the Scene's command buffer node table.
+  uint32_t GetId() const noexcept { return this->id; }
   float GetX() const noexcept;
   float GetY() const noexcept;
   float GetWidth() const noexcept;
@@ -51,6 +61,10 @@ class SceneNode : public Reference {
   void BindStyle(Style* style) noexcept;
   void SetHidden(bool value) noexcept;
 
+  // Focusable nodes are candidates of Scene::FindFocus(). Mirrors the focusable property of the JS node.
+  void SetFocusable(bool value) noexcept;
+  bool IsFocusable() const noexcept;
+
   void Paint(CompositeContext* ctx);
   void Composite(CompositeContext* ctx);
   void Destroy();
@@ -62,24 +76,42 @@ class SceneNode : public Reference {
   virtual void OnStylePropertyChanged(StyleProperty property);
   virtual void OnFlexBoxLayoutChanged() {}
   virtual void OnComputeStyle() {}
+  // Rasterize node content (text, canvas drawings, etc) into textures. Called for nodes that requested a paint.
+  virtual void OnPaint(Renderer* renderer) {}
   virtual void OnComposite(CompositeContext* ctx) {}
   virtual YGSize OnMeasure(float width, YGMeasureMode widthMode, float height, YGMeasureMode heightMode);
 
   virtual bool IsLeaf() const noexcept { return false; }
+  // Scroll containers clip their children to their box and translate them by GetContentOffset() at composite.
+  virtual bool IsScrollContainer() const noexcept { return false; }
+  virtual Point GetContentOffset() const noexcept { return {}; }
+  // Node types that draw only their box (background, border) can be layout-only when the box is not visible. Node
+  // types with content of their own (text, images, etc) cannot.
+  virtual bool IsLayoutOnlyCandidate() const noexcept { return false; }
   bool IsHidden() const noexcept;
   bool IsLayoutOnly() const noexcept;
   bool IsComputeStyleDirty() const noexcept;
   bool IsCompositeDirty() const noexcept;
-
-  template<typename Callable>
-  static void Visit(SceneNode* node, const Callable& func);
+  bool IsPaintDirty() const noexcept;
+
+  /**
+   * Recompute the transform, opacity and filter of this node from its style, if they changed since the last update.
+   *
+   * Also detects layout-only nodes: nodes that position their children but draw nothing, with no transform, opacity,
+   * filter or clip. The composite skips their draw logic and folds their layout position into their children.
+   *
+   * The composite reads these every frame. They are computed in the compute style phase (or on demand by geometry
+   * queries) rather than from the style maps on every frame.
+   */
+  void UpdateCompositeStyle() noexcept;
+  bool HasTransform() const noexcept { return this->hasTransform; }
+  const Matrix& GetTransform() const noexcept { return this->transform; }
+  float GetOpacity() const noexcept { return this->opacity; }
+  RenderFilter GetFilter(color_t fallbackTint, float currentOpacity) const noexcept;
 
   static YGSize YogaMeasureCallback(
       YGNodeRef nodeRef, float width, YGMeasureMode widthMode, float height, YGMeasureMode heightMode);
 
-  static void YogaNodeLayoutEvent(
-      const YGNode& node, facebook::yoga::Event::Type event, const facebook::yoga::Event::Data& data);
-
   static int32_t GetInstanceCount() noexcept;
 
  protected:
@@ -89,14 +121,30 @@ class SceneNode : public Reference {
     FlagComputeStyleDirty,
     FlagCompositeDirty,
     FlagPaintDirty,
+    FlagZOrderDirty,
+    FlagZOrdered,
+    FlagFocusable,
+    FlagCompositeStyleDirty,
+    // In the compute style requests of the scene.
+    FlagComputeStyleQueued,
   };
 
   ImageManager* GetImageManager() const noexcept;
 
   void MarkComputeStyleDirty() noexcept;
+  // Queue the subtree below this node for compute style, after an inherited property (see IsInheritedProperty()) of
+  // this node changed.
+  void MarkDescendantsComputeStyleDirty() noexcept;
+  // Transform, opacity or filter changed. Invalidates the composite style.
+  void MarkCompositeStyleDirty() noexcept;
   void MarkCompositeDirty() noexcept;
+  void RequestPaint() noexcept;
 
-  const std::vector<SceneNode*>& GetChildrenOrderedByZIndex();
+  /**
+   * Visit the children of this node in paint order: ascending z-index, with document order breaking ties.
+   */
+  template<typename Callable>
+  void VisitChildrenInZOrder(const Callable& func);
   void SetFlag(Flag flag, bool value) noexcept;
   StyleContext* GetStyleContext() const noexcept;
   Rect GetBackgroundClipBox(StyleBackgroundClip value) const noexcept;
@@ -105,28 +153,50 @@ class SceneNode : public Reference {
   SceneNode* GetChildAt(uint32_t index) const noexcept;
   int32_t GetChildIndex(SceneNode* node) const noexcept;
   int32_t GetZIndex(SceneNode* node) const noexcept;
+  void InvalidateZOrder() noexcept;
+  bool UpdateZOrder();
 
   void DrawBackground(CompositeContext* ctx, StyleBackgroundClip backgroundClip) const noexcept;
   void DrawBorder(CompositeContext* ctx) const noexcept;
 
+ private:
+  static void ReleaseYogaNode(YGNodeRef node) noexcept;
+
  protected:
   static int32_t instanceCount;
   ReferenceHolder<Scene> scene{};
   ReferenceHolder<Style> style{};
+  // Points to ygNodeStorage until Destroy().
   YGNodeRef ygNode{};
+  uint32_t id{};
+  // Index of this node in the Scene's flat tree. Only valid when the flat tree is up to date.
+  uint32_t flatIndex{};
   Texture* layer{};
+  // Children sorted by z-index. Only populated when the document order of the children is not the paint order.
   std::vector<SceneNode*> sortedChildren{};
-  std::bitset<8> flags;
+  std::bitset<16> flags;
+  // Composite style, computed by UpdateCompositeStyle(). The filter tint is only set if hasFilterTint.
+  Matrix transform{ Matrix::Identity() };
+  RenderFilter filter{};
+  float opacity{ 1.f };
+  bool hasTransform{};
+  bool hasFilterTint{};
+  // The yoga node lives in the node's pool block rather than in its own heap allocation.
+  YGNode ygNodeStorage{};
 
   friend Scene;
 };
 
 template<typename Callable>
-void SceneNode::Visit(SceneNode* node, const Callable& func) {
-  func(node);
-
-  for (const auto& child : YGNodeGetChildren(node->ygNode)) {
-    Visit(YGNodeGetContextAs<SceneNode>(child), func);
+void SceneNode::VisitChildrenInZOrder(const Callable& func) {
+  if (this->UpdateZOrder()) {
+    for (auto child : this->sortedChildren) {
+      func(child);
+    }
+  } else {
+    for (const auto& child : YGNodeGetChildren(this->ygNode)) {
+      func(YGNodeGetContextAs<SceneNode>(child));
+    }
   }
 }
 
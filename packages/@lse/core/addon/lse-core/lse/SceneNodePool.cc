@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) 2021 Light Source Software, LLC. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on
+ * an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the
+ * specific language governing permissions and limitations under the License.
+ */
+
+#include <lse/SceneNodePool.h>
+
+#include <new>
+
+namespace lse {
+
+void* SceneNodePool::Allocate(std::size_t size) noexcept {
+  const auto sizeClass{(sizeof(Header) + size - 1) / kSizeClassStep};
+  const auto blockSize{(sizeClass + 1) * kSizeClassStep};
+  Header* header;
+
+  if (sizeClass >= kSizeClassCount) {
+    // Too large for a slab. Served by the system allocator, but still tagged so Free() can route it back.
+    header = static_cast<Header*>(::operator new(blockSize, std::nothrow));
+
+    if (!header) {
+      return nullptr;
+    }
+
+    this->stats.reservedBytes += blockSize;
+  } else {
+    if (!this->freeLists[sizeClass] && !this->Grow(sizeClass)) {
+      return nullptr;
+    }
+
+    auto block{this->freeLists[sizeClass]};
+
+    this->freeLists[sizeClass] = block->next;
+    this->stats.freeCount--;
+
+    if (this->recycledBlocks[sizeClass] > 0) {
+      this->recycledBlocks[sizeClass]--;
+      this->stats.recycledCount++;
+    }
+
+    header = reinterpret_cast<Header*>(block);
+  }
+
+  header->pool = this;
+  header->sizeClass = sizeClass;
+
+  this->stats.liveCount++;
+  this->stats.allocationCount++;
+  this->Ref();
+
+  return header + 1;
+}
+
+void SceneNodePool::Free(void* p) noexcept {
+  if (!p) {
+    return;
+  }
+
+  auto header{static_cast<Header*>(p) - 1};
+  auto pool{header->pool};
+  const auto sizeClass{header->sizeClass};
+
+  pool->stats.liveCount--;
+
+  if (sizeClass >= kSizeClassCount) {
+    pool->stats.reservedBytes -= (sizeClass + 1) * kSizeClassStep;
+    ::operator delete(header);
+  } else {
+    pool->Release(header, sizeClass);
+  }
+
+  // May delete the pool, if this was the last node of a destroyed Scene.
+  pool->Unref();
+}
+
+void SceneNodePool::Release(void* block, std::size_t sizeClass) noexcept {
+  auto freeBlock{static_cast<FreeBlock*>(block)};
+
+  freeBlock->next = this->freeLists[sizeClass];
+  this->freeLists[sizeClass] = freeBlock;
+  this->recycledBlocks[sizeClass]++;
+  this->stats.freeCount++;
+}
+
+bool SceneNodePool::Grow(std::size_t sizeClass) noexcept {
+  const auto blockSize{(sizeClass + 1) * kSizeClassStep};
+  std::unique_ptr<uint8_t[]> slab{new (std::nothrow) uint8_t[blockSize * kBlocksPerSlab]};
+
+  if (!slab) {
+    return false;
+  }
+
+  try {
+    this->slabs.push_back(std::move(slab));
+  } catch (...) {
+    return false;
+  }
+
+  auto base{this->slabs.back().get()};
+
+  // Only called when the free list is empty. Blocks are linked in address order.
+  for (auto i{kBlocksPerSlab}; i-- > 0;) {
+    auto freeBlock{reinterpret_cast<FreeBlock*>(base + i * blockSize)};
+
+    freeBlock->next = this->freeLists[sizeClass];
+    this->freeLists[sizeClass] = freeBlock;
+  }
+
+  this->stats.freeCount += kBlocksPerSlab;
+  this->stats.slabCount++;
+  this->stats.reservedBytes += blockSize * kBlocksPerSlab;
+
+  return true;
+}
+
+} // namespace lse
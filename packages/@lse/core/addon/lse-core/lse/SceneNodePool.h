@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2021 Light Source Software, LLC. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on
+ * an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the
+ * specific language governing permissions and limitations under the License.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <lse/Reference.h>
+
+namespace lse {
+
+struct SceneNodePoolStats {
+  // Blocks in use by live nodes.
+  std::size_t liveCount{};
+  // Blocks on the free lists, ready to be recycled.
+  std::size_t freeCount{};
+  // Slabs allocated from the system.
+  std::size_t slabCount{};
+  // Bytes allocated from the system, including blocks too large for the pool.
+  std::size_t reservedBytes{};
+  // Total allocations served.
+  std::size_t allocationCount{};
+  // Allocations served with a block released by a previous node.
+  std::size_t recycledCount{};
+};
+
+/**
+ * Slab allocator for the SceneNodes of a Scene.
+ *
+ * Blocks are grouped in size classes. Each size class has a free list. Freed nodes go back to the free list of their
+ * size class and are recycled by the next node of the same size class, so creating and destroying nodes (list
+ * re-renders, for example) does not reach the system allocator. Memory is returned to the system when the pool is
+ * destroyed.
+ *
+ * Every allocation holds a reference to the pool, so nodes that outlive their Scene can still be freed.
+ */
+class SceneNodePool final : public Reference {
+ public:
+  SceneNodePool() = default;
+  ~SceneNodePool() override = default;
+
+  /**
+   * @return memory for a node of size bytes; nullptr if out of memory
+   */
+  void* Allocate(std::size_t size) noexcept;
+
+  /**
+   * Return memory from Allocate() to the pool that allocated it.
+   */
+  static void Free(void* p) noexcept;
+
+  const SceneNodePoolStats& GetStats() const noexcept { return this->stats; }
+
+ private:
+  static constexpr std::size_t kSizeClassStep{64};
+  static constexpr std::size_t kSizeClassCount{32};
+  static constexpr std::size_t kBlocksPerSlab{32};
+
+  struct FreeBlock {
+    FreeBlock* next;
+  };
+
+  // Prefix of every block. Aligned so the node that follows it is suitably aligned.
+  struct alignas(alignof(std::max_align_t)) Header {
+    SceneNodePool* pool;
+    std::size_t sizeClass;
+  };
+
+  void Release(void* block, std::size_t sizeClass) noexcept;
+  bool Grow(std::size_t sizeClass) noexcept;
+
+ private:
+  std::vector<std::unique_ptr<uint8_t[]>> slabs{};
+  std::array<FreeBlock*, kSizeClassCount> freeLists{};
+  // Freed blocks are pushed on top of never used blocks, so the first recycledBlocks of a free list are recycled.
+  std::array<std::size_t, kSizeClassCount> recycledBlocks{};
+  SceneNodePoolStats stats{};
+};
+
+} // namespace lse
@@ -0,0 +1,488 @@
+/*
+ * Copyright (c) 2021 Light Source Software, LLC. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on
+ * an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the
+ * specific language governing permissions and limitations under the License.
+ */
+
+#include "SceneSnapshot.h"
+
+#include <cstring>
+#include <stdexcept>
+#include <phmap.h>
+#include <lse/ImageManager.h>
+
+namespace lse {
+
+constexpr uint8_t kSnapshotMagic[]{ 'L', 'S', 'E', 'S' };
+constexpr uint32_t kSnapshotVersion{ 2 };
+constexpr uint8_t kFlipH{ 1 };
+constexpr uint8_t kFlipV{ 2 };
+
+/**
+ * Renderer that appends draw calls to a snapshot's op list rather than drawing them.
+ */
+class SceneSnapshot::Recorder : public Renderer {
+ public:
+  Recorder(SceneSnapshot* snapshot, ImageManager* imageManager) noexcept
+  : snapshot(snapshot), imageManager(imageManager) {
+  }
+
+  void Reset() noexcept override {}
+  int32_t GetWidth() const noexcept override { return this->snapshot->width; }
+  int32_t GetHeight() const noexcept override { return this->snapshot->height; }
+  bool SetRenderTarget(Texture* texture) noexcept override { return false; }
+  Texture* CreateTexture(int32_t width, int32_t height, Texture::Type type) override { return nullptr; }
+  void DestroyTexture(Texture* texture) override {}
+  PixelFormat GetTextureFormat() const noexcept override { return PixelFormatRGBA; }
+
+  void EnabledClipping(const Rect& rect) noexcept override {
+    this->Append({ OpTypeClip, rect });
+  }
+
+  void DisableClipping() noexcept override {
+    this->Append({ OpTypeNoClip });
+  }
+
+  void DrawImage(const RenderTransform& transform, const Point& origin, const Rect& box, const IntRect& src,
+      Texture* texture, const RenderFilter& filter) noexcept override {
+    uint32_t resource;
+
+    if (this->FindResource(texture, &resource)) {
+      this->Append({ OpTypeDrawImageTransform, box, {}, src, resource, transform, origin, filter });
+    }
+  }
+
+  void DrawImage(const Rect& box, const IntRect& src, Texture* texture, const RenderFilter& filter) noexcept override {
+    uint32_t resource;
+
+    if (this->FindResource(texture, &resource)) {
+      this->Append({ OpTypeDrawImage, box, {}, src, resource, {}, {}, filter });
+    }
+  }
+
+  void FillRect(const Rect& box, const RenderFilter& filter) noexcept override {
+    this->Append({ OpTypeFillRect, box, {}, {}, 0, {}, {}, filter });
+  }
+
+  void StrokeRect(const Rect& box, const EdgeRect& edges, const RenderFilter& filter) noexcept override {
+    this->Append({ OpTypeStrokeRect, box, edges, {}, 0, {}, {}, filter });
+  }
+
+ private:
+  void Append(const Op& op) noexcept {
+    this->snapshot->ops.push_back(op);
+  }
+
+  bool FindResource(Texture* texture, uint32_t* resource) {
+    if (!texture) {
+      return false;
+    }
+
+    auto p{ this->resourcesByTexture.find(texture) };
+
+    if (p == this->resourcesByTexture.end()) {
+      auto image{ this->imageManager->FindByTexture(texture) };
+      auto index{ image ? static_cast<int32_t>(this->snapshot->resources.size()) : -1 };
+
+      if (image) {
+        // The full request, so images requested at a resize size are reloaded at that size and the recorded source
+        // rects address the same pixels.
+        this->snapshot->resources.push_back(image->GetRequest());
+      }
+
+      p = this->resourcesByTexture.insert({ texture, index }).first;
+    }
+
+    if (p->second < 0) {
+      return false;
+    }
+
+    *resource = static_cast<uint32_t>(p->second);
+
+    return true;
+  }
+
+ private:
+  SceneSnapshot* snapshot;
+  ImageManager* imageManager;
+  // Resource index of image textures; -1 for textures without a uri.
+  phmap::flat_hash_map<Texture*, int32_t> resourcesByTexture;
+};
+
+/**
+ * Little endian binary writer.
+ */
+class SnapshotWriter {
+ public:
+  explicit SnapshotWriter(std::vector<uint8_t>* buffer) noexcept : buffer(buffer) {
+  }
+
+  void U8(uint8_t value) {
+    this->buffer->push_back(value);
+  }
+
+  void U32(uint32_t value) {
+    for (auto i = 0; i < 4; i++) {
+      this->buffer->push_back(static_cast<uint8_t>(value >> (i * 8)));
+    }
+  }
+
+  void I32(int32_t value) {
+    this->U32(static_cast<uint32_t>(value));
+  }
+
+  void F32(float value) {
+    uint32_t bits;
+
+    std::memcpy(&bits, &value, sizeof(bits));
+    this->U32(bits);
+  }
+
+  void Bytes(const void* data, std::size_t size) {
+    auto bytes{ static_cast<const uint8_t*>(data) };
+
+    this->buffer->insert(this->buffer->end(), bytes, bytes + size);
+  }
+
+  void RectF(const Rect& rect) {
+    this->F32(rect.x);
+    this->F32(rect.y);
+    this->F32(rect.width);
+    this->F32(rect.height);
+  }
+
+ private:
+  std::vector<uint8_t>* buffer;
+};
+
+/**
+ * Little endian binary reader. Reading past the end throws.
+ */
+class SnapshotReader {
+ public:
+  SnapshotReader(const uint8_t* data, std::size_t size) noexcept : data(data), size(size) {
+  }
+
+  uint8_t U8() {
+    return *this->Take(1);
+  }
+
+  uint32_t U32() {
+    auto bytes{ this->Take(4) };
+
+    return static_cast<uint32_t>(bytes[0]) | (static_cast<uint32_t>(bytes[1]) << 8)
+        | (static_cast<uint32_t>(bytes[2]) << 16) | (static_cast<uint32_t>(bytes[3]) << 24);
+  }
+
+  int32_t I32() {
+    return static_cast<int32_t>(this->U32());
+  }
+
+  float F32() {
+    const auto bits{ this->U32() };
+    float value;
+
+    std::memcpy(&value, &bits, sizeof(value));
+
+    return value;
+  }
+
+  const uint8_t* Take(std::size_t count) {
+    if (count > this->size - this->position) {
+      throw std::runtime_error("scene snapshot is truncated");
+    }
+
+    auto bytes{ this->data + this->position };
+
+    this->position += count;
+
+    return bytes;
+  }
+
+  Rect RectF() {
+    const auto x{ this->F32() };
+    const auto y{ this->F32() };
+    const auto width{ this->F32() };
+    const auto height{ this->F32() };
+
+    return { x, y, width, height };
+  }
+
+  IntRect RectI() {
+    const auto x{ this->I32() };
+    const auto y{ this->I32() };
+    const auto width{ this->I32() };
+    const auto height{ this->I32() };
+
+    return { x, y, width, height };
+  }
+
+  bool AtEnd() const noexcept {
+    return this->position == this->size;
+  }
+
+ private:
+  const uint8_t* data;
+  std::size_t size;
+  std::size_t position{};
+};
+
+static RenderFilter ReadFilter(SnapshotReader* reader) {
+  const auto tint{ reader->U32() };
+  const auto flip{ reader->U8() };
+
+  return { tint, (flip & kFlipH) != 0, (flip & kFlipV) != 0 };
+}
+
+static void WriteFilter(SnapshotWriter* writer, const RenderFilter& filter) {
+  writer->U32(filter.tint.value);
+  writer->U8((filter.flipH ? kFlipH : 0) | (filter.flipV ? kFlipV : 0));
+}
+
+SceneSnapshot SceneSnapshot::Record(
+    int32_t width, int32_t height, ImageManager* imageManager, const std::function<void(Renderer*)>& composite) {
+  SceneSnapshot snapshot;
+
+  snapshot.width = width;
+  snapshot.height = height;
+
+  Recorder recorder(&snapshot, imageManager);
+
+  composite(&recorder);
+
+  return snapshot;
+}
+
+SceneSnapshot SceneSnapshot::Decode(const uint8_t* data, std::size_t size) {
+  SnapshotReader reader(data, size);
+  SceneSnapshot snapshot;
+
+  if (std::memcmp(reader.Take(sizeof(kSnapshotMagic)), kSnapshotMagic, sizeof(kSnapshotMagic)) != 0) {
+    throw std::runtime_error("not a scene snapshot");
+  }
+
+  if (reader.U32() != kSnapshotVersion) {
+    throw std::runtime_error("unsupported scene snapshot version");
+  }
+
+  snapshot.width = reader.I32();
+  snapshot.height = reader.I32();
+
+  if (snapshot.width <= 0 || snapshot.height <= 0) {
+    throw std::runtime_error("invalid scene snapshot dimensions");
+  }
+
+  const auto resourceCount{ reader.U32() };
+  phmap::flat_hash_set<std::string> uris;
+
+  for (uint32_t i = 0; i < resourceCount; i++) {
+    const auto length{ reader.U32() };
+    auto bytes{ reinterpret_cast<const char*>(reader.Take(length)) };
+    ImageRequest request{ std::string(bytes, length) };
+
+    request.width = reader.I32();
+    request.height = reader.I32();
+
+    if (request.width < 0 || request.height < 0) {
+      throw std::runtime_error("invalid scene snapshot image size");
+    }
+
+    // Images are acquired once per resource.
+    if (!uris.insert(request.uri).second) {
+      throw std::runtime_error("duplicate scene snapshot image reference");
+    }
+
+    snapshot.resources.push_back(std::move(request));
+  }
+
+  const auto opCount{ reader.U32() };
+
+  for (uint32_t i = 0; i < opCount; i++) {
+    Op op{ static_cast<OpType>(reader.U8()) };
+
+    switch (op.type) {
+      case OpTypeFillRect:
+        op.box = reader.RectF();
+        op.filter = ReadFilter(&reader);
+        break;
+      case OpTypeStrokeRect:
+        op.box = reader.RectF();
+        op.edges.top = reader.I32();
+        op.edges.right = reader.I32();
+        op.edges.bottom = reader.I32();
+        op.edges.left = reader.I32();
+        op.filter = ReadFilter(&reader);
+        break;
+      case OpTypeDrawImageTransform:
+        op.transform.tx = reader.F32();
+        op.transform.ty = reader.F32();
+        op.transform.sx = reader.F32();
+        op.transform.sy = reader.F32();
+        op.transform.rotate = reader.F32();
+        op.origin.x = reader.F32();
+        op.origin.y = reader.F32();
+        // fall through
+      case OpTypeDrawImage:
+        op.resource = reader.U32();
+        op.box = reader.RectF();
+        op.src = reader.RectI();
+        op.filter = ReadFilter(&reader);
+
+        if (op.resource >= resourceCount) {
+          throw std::runtime_error("invalid scene snapshot image reference");
+        }
+        break;
+      case OpTypeClip:
+        op.box = reader.RectF();
+        break;
+      case OpTypeNoClip:
+        break;
+      default:
+        throw std::runtime_error("unknown scene snapshot op");
+    }
+
+    snapshot.ops.push_back(op);
+  }
+
+  if (!reader.AtEnd()) {
+    throw std::runtime_error("unexpected data after scene snapshot");
+  }
+
+  return snapshot;
+}
+
+std::vector<uint8_t> SceneSnapshot::Encode() const {
+  std::vector<uint8_t> buffer;
+  SnapshotWriter writer(&buffer);
+
+  writer.Bytes(kSnapshotMagic, sizeof(kSnapshotMagic));
+  writer.U32(kSnapshotVersion);
+  writer.I32(this->width);
+  writer.I32(this->height);
+  writer.U32(static_cast<uint32_t>(this->resources.size()));
+
+  for (const auto& resource : this->resources) {
+    writer.U32(static_cast<uint32_t>(resource.uri.size()));
+    writer.Bytes(resource.uri.data(), resource.uri.size());
+    writer.I32(resource.width);
+    writer.I32(resource.height);
+  }
+
+  writer.U32(static_cast<uint32_t>(this->ops.size()));
+
+  for (const auto& op : this->ops) {
+    writer.U8(op.type);
+
+    switch (op.type) {
+      case OpTypeFillRect:
+        writer.RectF(op.box);
+        WriteFilter(&writer, op.filter);
+        break;
+      case OpTypeStrokeRect:
+        writer.RectF(op.box);
+        writer.I32(op.edges.top);
+        writer.I32(op.edges.right);
+        writer.I32(op.edges.bottom);
+        writer.I32(op.edges.left);
+        WriteFilter(&writer, op.filter);
+        break;
+      case OpTypeDrawImageTransform:
+        writer.F32(op.transform.tx);
+        writer.F32(op.transform.ty);
+        writer.F32(op.transform.sx);
+        writer.F32(op.transform.sy);
+        writer.F32(op.transform.rotate);
+        writer.F32(op.origin.x);
+        writer.F32(op.origin.y);
+        // fall through
+      case OpTypeDrawImage:
+        writer.U32(op.resource);
+        writer.RectF(op.box);
+        writer.I32(op.src.x);
+        writer.I32(op.src.y);
+        writer.I32(op.src.width);
+        writer.I32(op.src.height);
+        WriteFilter(&writer, op.filter);
+        break;
+      case OpTypeClip:
+        writer.RectF(op.box);
+        break;
+      default:
+        break;
+    }
+  }
+
+  return buffer;
+}
+
+void SceneSnapshot::AcquireImages(ImageManager* imageManager, void* owner, Image::Listener listener) {
+  this->images.reserve(this->resources.size());
+
+  for (const auto& resource : this->resources) {
+    this->images.push_back(ImageManager::SafeAcquire(imageManager, resource, owner, owner, listener));
+  }
+}
+
+void SceneSnapshot::ReleaseImages(ImageManager* imageManager, void* owner) noexcept {
+  for (auto image : this->images) {
+    ImageManager::SafeRelease(imageManager, image, owner, owner);
+  }
+
+  this->images.clear();
+}
+
+void SceneSnapshot::Draw(Renderer* renderer, int32_t width, int32_t height) const noexcept {
+  const auto sx{ static_cast<float>(width) / static_cast<float>(this->width) };
+  const auto sy{ static_cast<float>(height) / static_cast<float>(this->height) };
+  auto scale = [sx, sy](const Rect& r) -> Rect { return { r.x * sx, r.y * sy, r.width * sx, r.height * sy }; };
+
+  for (const auto& op : this->ops) {
+    switch (op.type) {
+      case OpTypeFillRect:
+        renderer->FillRect(scale(op.box), op.filter);
+        break;
+      case OpTypeStrokeRect:
+        renderer->StrokeRect(scale(op.box), op.edges, op.filter);
+        break;
+      case OpTypeDrawImage:
+      case OpTypeDrawImageTransform: {
+        auto image{ op.resource < this->images.size() ? this->images[op.resource] : nullptr };
+
+        if (!Image::SafeIsReady(image)) {
+          break;
+        }
+
+        if (op.type == OpTypeDrawImage) {
+          renderer->DrawImage(scale(op.box), op.src, image->GetTexture(), op.filter);
+        } else {
+          auto transform{ op.transform };
+
+          transform.tx *= sx;
+          transform.ty *= sy;
+          transform.sx *= sx;
+          transform.sy *= sy;
+
+          renderer->DrawImage(transform, op.origin, op.box, op.src, image->GetTexture(), op.filter);
+        }
+        break;
+      }
+      case OpTypeClip:
+        renderer->EnabledClipping(scale(op.box));
+        break;
+      case OpTypeNoClip:
+        renderer->DisableClipping();
+        break;
+    }
+  }
+
+  renderer->DisableClipping();
+}
+
+} // namespace lse
@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2021 Light Source Software, LLC. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on
+ * an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the
+ * specific language governing permissions and limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+#include <lse/Image.h>
+#include <lse/Renderer.h>
+
+namespace lse {
+
+class ImageManager;
+
+/**
+ * Draw list of a composited scene: the fills, strokes, image draws and clips a composite submits to the renderer,
+ * with layout, styles, transforms and opacity already resolved.
+ *
+ * A snapshot is recorded from a live scene, encoded to a compact binary format and decoded in another process, where
+ * it can be drawn before the scene graph is built. Images are referenced by request (uri and resize size) and loaded
+ * through the ImageManager; draws of textures without a uri (text, canvas and pixel nodes) are not recorded.
+ *
+ * Binary format, little endian: "LSES", u32 version, i32 width, i32 height, u32 resource count, resources (u32 byte
+ * length + utf8 uri + i32 request width + i32 request height), u32 op count, ops (u8 type + fields of the type).
+ */
+class SceneSnapshot {
+ public:
+  /**
+   * Record the draw calls made by composite.
+   *
+   * @param width screen width of the recorded scene
+   * @param height screen height of the recorded scene
+   * @param imageManager resolves image textures to uris
+   * @param composite draws the scene to the renderer it is passed
+   */
+  static SceneSnapshot Record(
+      int32_t width, int32_t height, ImageManager* imageManager, const std::function<void(Renderer*)>& composite);
+
+  /**
+   * Decode a snapshot created by Encode().
+   *
+   * @throws std::runtime_error if data is not a valid snapshot
+   */
+  static SceneSnapshot Decode(const uint8_t* data, std::size_t size);
+
+  std::vector<uint8_t> Encode() const;
+
+  /**
+   * Acquire the images referenced by the snapshot. listener is called with owner when an image finishes loading.
+   */
+  void AcquireImages(ImageManager* imageManager, void* owner, Image::Listener listener);
+  void ReleaseImages(ImageManager* imageManager, void* owner) noexcept;
+
+  /**
+   * Replay the draw list. If the screen size differs from the recorded size, the draw list is scaled to fit.
+   */
+  void Draw(Renderer* renderer, int32_t width, int32_t height) const noexcept;
+
+  int32_t Width() const noexcept { return this->width; }
+  int32_t Height() const noexcept { return this->height; }
+  std::size_t GetOpCount() const noexcept { return this->ops.size(); }
+  const std::vector<ImageRequest>& GetResources() const noexcept { return this->resources; }
+
+ private:
+  enum OpType : uint8_t {
+    OpTypeFillRect = 1,
+    OpTypeStrokeRect = 2,
+    OpTypeDrawImage = 3,
+    OpTypeDrawImageTransform = 4,
+    OpTypeClip = 5,
+    OpTypeNoClip = 6,
+  };
+
+  struct Op {
+    OpType type;
+    Rect box;
+    // StrokeRect edges.
+    EdgeRect edges;
+    // DrawImage source rect and resource index.
+    IntRect src;
+    uint32_t resource;
+    // DrawImageTransform transform and origin.
+    RenderTransform transform;
+    Point origin;
+    RenderFilter filter;
+  };
+
+  class Recorder;
+
+  int32_t width{};
+  int32_t height{};
+  std::vector<ImageRequest> resources;
+  std::vector<Op> ops;
+  // Images of resources, while acquired.
+  std::vector<Image*> images;
+};
+
+} // namespace lse
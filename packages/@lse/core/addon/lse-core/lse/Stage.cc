@@ -13,10 +13,27 @@
 
 #include <lse/Stage.h>
 
+#include <lse/ThreadPool.h>
+
 namespace lse {
 
+Stage::Stage() = default;
+Stage::~Stage() = default;
+
+ThreadPool* Stage::GetThreadPool() {
+  if (!this->threadPool) {
+    this->threadPool = std::make_unique<ThreadPool>();
+  }
+
+  return this->threadPool.get();
+}
+
 void Stage::Destroy() {
   // TODO: cleanup resources
+  if (this->threadPool) {
+    this->threadPool->ShutdownNow();
+    this->threadPool = nullptr;
+  }
 }
 
 } // namespace lse
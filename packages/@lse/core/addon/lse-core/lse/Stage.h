@@ -14,9 +14,12 @@
 #pragma once
 
 #include <lse/Reference.h>
+#include <memory>
 
 namespace lse {
 
+class ThreadPool;
+
 /**
  * Application instance for a Light Source Engine app.
  *
@@ -29,7 +32,18 @@ namespace lse {
  */
 class Stage : public Reference {
  public:
+  Stage();
+  ~Stage() override;
+
+  /**
+   * Worker threads shared by the scenes of this stage. Created on first use.
+   */
+  ThreadPool* GetThreadPool();
+
   void Destroy();
+
+ private:
+  std::unique_ptr<ThreadPool> threadPool;
 };
 
 } // namespace lse
@@ -137,14 +137,19 @@ float StyleContext::ComputeTransformOrigin(Style* style, StyleProperty property,
 }
 
 Rect StyleContext::ComputeObjectFit(Style* style, const Rect& box, const Image* image) const noexcept {
+  return this->ComputeObjectFit(style, box, image->WidthF(), image->HeightF());
+}
+
+Rect StyleContext::ComputeObjectFit(
+    Style* style, const Rect& box, float objectWidth, float objectHeight) const noexcept {
   assert(style);
   auto objectFit{ style->GetEnum<StyleObjectFit>(StyleProperty::objectFit) };
   float fitWidth;
   float fitHeight;
-  float aspectRatio;
+  const float aspectRatio{objectHeight > 0 ? objectWidth / objectHeight : 0};
 
   if (objectFit == StyleObjectFitScaleDown) {
-    if (image->WidthF() > box.width || image->HeightF() > box.height) {
+    if (objectWidth > box.width || objectHeight > box.height) {
       objectFit = StyleObjectFitContain;
     } else {
       objectFit = StyleObjectFitNone;
@@ -153,8 +158,6 @@ Rect StyleContext::ComputeObjectFit(Style* style, const Rect& box, const Image*
 
   switch (objectFit) {
     case StyleObjectFitContain:
-      aspectRatio = image->AspectRatio();
-
       if (aspectRatio > (box.width / box.height)) {
         fitWidth = box.width;
         fitHeight = box.width / aspectRatio;
@@ -164,19 +167,17 @@ Rect StyleContext::ComputeObjectFit(Style* style, const Rect& box, const Image*
       }
       break;
     case StyleObjectFitCover:
-      aspectRatio = image->AspectRatio();
-
       if (aspectRatio > (box.width / box.height)) {
-        fitWidth = box.height * image->AspectRatio();
+        fitWidth = box.height * aspectRatio;
         fitHeight = box.height;
       } else {
         fitWidth = box.width;
-        fitHeight = box.width / image->AspectRatio();
+        fitHeight = box.width / aspectRatio;
       }
       break;
     case StyleObjectFitNone:
-      fitWidth = image->WidthF();
-      fitHeight = image->HeightF();
+      fitWidth = objectWidth;
+      fitHeight = objectHeight;
       break;
     default:
       fitWidth = box.width;
@@ -332,28 +333,6 @@ float StyleContext::ComputeLineHeight(Style* style, float fontLineHeight) const
   }
 }
 
-RenderFilter StyleContext::ComputeFilter(Style* style, color_t fallbackTint, float opacity) const noexcept {
-  auto filter{RenderFilter::OfTint(fallbackTint, opacity)};
-
-  for (const auto& filterFunc : style->GetFilter()) {
-    switch (filterFunc.filter) {
-      case StyleFilterTint:
-        filter.tint = filterFunc.color.MixAlpha(opacity);
-        break;
-      case StyleFilterFlipH:
-        filter.flipH = true;
-        break;
-      case StyleFilterFlipV:
-        filter.flipV = true;
-        break;
-      default:
-        break;
-    }
-  }
-
-  return filter;
-}
-
 void StyleContext::SetViewportSize(float width, float height) noexcept {
   this->viewportWidth = width;
   this->viewportHeight = height;
@@ -43,9 +43,9 @@ class StyleContext {
   float ComputeOpacity(Style* style) const noexcept;
   Matrix ComputeTransform(Style* style, const Rect& box) const noexcept;
   Rect ComputeObjectFit(Style* style, const Rect& box, const Image* image) const noexcept;
+  Rect ComputeObjectFit(Style* style, const Rect& box, float objectWidth, float objectHeight) const noexcept;
   Rect ComputeBackgroundFit(Style* style, const Rect& box, const Image* image) const noexcept;
   float ComputeLineHeight(Style* style, float fontLineHeight) const noexcept;
-  RenderFilter ComputeFilter(Style* style, color_t fallbackTint, float opacity) const noexcept;
 
   // Set environment context variables: viewport width, viewport height, root font size
   void SetViewportSize(float width, float height) noexcept;
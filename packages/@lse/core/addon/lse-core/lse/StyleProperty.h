@@ -117,6 +117,10 @@ constexpr const uint32_t StylePropertyMetaTypeFilter = 1u << 7u;
 
 constexpr const uint32_t kStylePropertyMetaTypeMask = 0b1111'1110;
 
+// The computed value of the property is used by the descendants of a node, so a change queues the node's subtree for
+// compute style. Style::parent is the class cascade rather than the node tree, so no property is inherited yet.
+constexpr const uint32_t StylePropertyMetaInherited = 1u << 8u;
+
 // StyleProperty enum has enough room to attached meta data in the id, but StyleProperty must be 0 based and
 // contiguous. So, the meta data is associated with properties through this array. Each index maps to a StyleProperty
 // enum value.
@@ -202,6 +206,10 @@ constexpr bool IsYogaProperty(StyleProperty property) noexcept {
   return kStylePropertyMeta[property] & StylePropertyMetaGroupYoga;
 }
 
+constexpr bool IsInheritedProperty(StyleProperty property) noexcept {
+  return kStylePropertyMeta[property] & StylePropertyMetaInherited;
+}
+
 void StylePropertyValueInit();
 bool StylePropertyValueIsValid(StyleProperty property, int32_t value) noexcept;
 const char* StylePropertyValueToString(StyleProperty property, int32_t value) noexcept;
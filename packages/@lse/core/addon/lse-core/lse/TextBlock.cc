@@ -13,12 +13,11 @@
 
 #include <lse/TextBlock.h>
 
-#include <lse/Renderer.h>
+#include <lse/ImageManager.h>
 #include <lse/FontManager.h>
 #include <lse/Style.h>
 #include <lse/StyleContext.h>
 #include <lse/Timer.h>
-#include <lse/PixelConversion.h>
 #include <lse/Log.h>
 #include <lse/string-ext.h>
 #include <lse/math-ext.h>
@@ -29,26 +28,86 @@
 
 namespace lse {
 
-void TextBlock::Shape(
-    const std::string& utf8, Font* font, Style* style, StyleContext* context, float maxWidth, float maxHeight) {
-  this->Invalidate();
+// Number of Layout() results memoized per block. Yoga measures a node with a few constraints per layout pass.
+constexpr std::size_t kLayoutCacheSize{4};
 
+bool TextBlock::Shape(
+    const std::string& utf8, Font* font, Style* style, StyleContext* context, float maxWidth, float maxHeight) {
   if (utf8.empty() || !style || !font || font->GetFontStatus() != FontStatusReady) {
-    return;
+    this->Invalidate();
+    return true;
   }
 
-  this->font = font->GetFontSourceAs<FTFontSource>();
-  this->fontSize = SnapToPixelGrid<int32_t>(context->ComputeFontSize(style));
+  const auto fontSource{font->GetFontSourceAs<FTFontSource>()};
+  const auto fontSize{SnapToPixelGrid<int32_t>(context->ComputeFontSize(style))};
+  const auto textTransform{style->GetEnum<StyleTextTransform>(StyleProperty::textTransform)};
 
-  if (this->fontSize <= 0 || !this->font->SetFontSizePt(this->fontSize)) {
-    return;
+  if (this->codepoints.empty() || fontSource != this->font || fontSize != this->fontSize
+      || textTransform != this->textTransform) {
+    this->Invalidate();
+
+    if (fontSize <= 0 || !fontSource->SetFontSizePt(fontSize)) {
+      return true;
+    }
+
+    this->font = fontSource;
+    this->fontSize = fontSize;
+    this->textTransform = textTransform;
+    this->LoadCodepoints(utf8);
+  }
+
+  const LayoutKey key{
+    maxWidth,
+    maxHeight,
+    static_cast<std::size_t>(style->GetInteger(StyleProperty::maxLines).value_or(0)),
+    style->GetEnum<StyleTextOverflow>(StyleProperty::textOverflow)
+  };
+
+  this->align = style->GetEnum<StyleTextAlign>(StyleProperty::textAlign);
+
+  for (std::size_t i = 0; i < this->layoutCache.size(); i++) {
+    const auto& entry{this->layoutCache[i]};
+
+    if (entry.key == key) {
+      if (this->layoutIndex == static_cast<int32_t>(i)) {
+        return false;
+      }
+
+      this->lines = entry.lines;
+      this->calculatedWidth = entry.width;
+      this->calculatedHeight = entry.height;
+      this->layoutIndex = static_cast<int32_t>(i);
+      this->isReady = false;
+
+      return true;
+    }
   }
 
-  this->LoadCodepoints(utf8, style);
-  this->Layout(style, maxWidth, maxHeight);
+  if (!this->font->SetFontSizePt(this->fontSize)) {
+    this->Invalidate();
+    return true;
+  }
+
+  this->lines.clear();
+  this->Layout(key);
+
+  LayoutResult result{key, this->lines, this->calculatedWidth, this->calculatedHeight};
+
+  if (this->layoutCache.size() < kLayoutCacheSize) {
+    this->layoutIndex = static_cast<int32_t>(this->layoutCache.size());
+    this->layoutCache.push_back(std::move(result));
+  } else {
+    this->layoutIndex = static_cast<int32_t>(this->layoutCacheNext);
+    this->layoutCache[this->layoutCacheNext] = std::move(result);
+    this->layoutCacheNext = (this->layoutCacheNext + 1) % kLayoutCacheSize;
+  }
+
+  this->isReady = false;
+
+  return true;
 }
 
-void TextBlock::Layout(Style* style, float maxWidth, float maxHeight) {
+void TextBlock::Layout(const LayoutKey& key) {
   /*
    * Layout a string of characters given the maxWidth and maxHeight bounds.
    *
@@ -69,11 +128,11 @@ void TextBlock::Layout(Style* style, float maxWidth, float maxHeight) {
   auto walker = this->TrimLeft(0, textIteratorEnd);
   auto lineStart = walker;
   auto lastSpace = textIteratorEnd;
-  const std::size_t maxLines = style->GetInteger(StyleProperty::maxLines).value_or(0);
+  const auto maxLines = key.maxLines;
   Float266 lineWidth266{};
   Float266 advance266;
-  Float266 maxWidth266{ToFloat266(maxWidth)};
-  Float266 maxHeight266{ToFloat266(maxHeight)};
+  Float266 maxWidth266{ToFloat266(key.maxWidth)};
+  Float266 maxHeight266{ToFloat266(key.maxHeight)};
   uint32_t c;
 
   while (walker != textIteratorEnd) {
@@ -92,7 +151,7 @@ void TextBlock::Layout(Style* style, float maxWidth, float maxHeight) {
 
       // More characters exist, but no vertical space is left. Ellipsize and bail.
       if (this->AtVerticalLimit(maxHeight266, maxLines)) {
-        this->EllipsizeIfNecessary(style, maxWidth);
+        this->EllipsizeIfNecessary(key.textOverflow, maxWidth266);
         lineStart = textIteratorEnd;
         break;
       }
@@ -115,7 +174,7 @@ void TextBlock::Layout(Style* style, float maxWidth, float maxHeight) {
 
       // More characters exist, but no vertical space is left. Ellipsize and bail.
       if (this->AtVerticalLimit(maxHeight266, maxLines)) {
-        this->EllipsizeIfNecessary(style, maxWidth266);
+        this->EllipsizeIfNecessary(key.textOverflow, maxWidth266);
         lineStart = textIteratorEnd;
         break;
       }
@@ -148,17 +207,45 @@ void TextBlock::Layout(Style* style, float maxWidth, float maxHeight) {
   // Round up so sub-pixels can be rendered to the int texture dimensions.
   this->calculatedWidth = ::ceilf(FromFloat266(maxWidth266));
   this->calculatedHeight = lineHeight * static_cast<float>(this->lines.size());
-  this->align = style->GetEnum<StyleTextAlign>(StyleProperty::textAlign);
 }
 
-void TextBlock::Paint(Renderer* renderer) {
+void TextBlock::Paint(ImageManager* imageManager, const void* scope) {
   if (this->IsEmpty() || !this->font->SetFontSizePt(this->fontSize)) {
     return;
   }
 
-  auto textureLock{this->LockTexture(renderer)};
+  std::string key;
+
+  this->BuildTextureKey(&key);
+
+  if (this->texture && key == this->textureKey && imageManager == this->textureOwner && scope == this->textureScope) {
+    this->isReady = true;
+    return;
+  }
+
+  this->ReleaseTexture();
+
+  bool isNew{};
+
+  this->texture = imageManager->AcquireTextTexture(key, this->Width(), this->Height(), scope, &isNew);
+
+  if (!this->texture) {
+    return;
+  }
+
+  this->textureOwner = imageManager;
+  this->textureScope = scope;
+  this->textureKey = std::move(key);
+
+  if (!isNew) {
+    this->isReady = true;
+    return;
+  }
+
+  TextureLock textureLock{this->texture, true};
 
   if (!textureLock.IsLocked()) {
+    this->ReleaseTexture();
     return;
   }
 
@@ -185,44 +272,50 @@ void TextBlock::Paint(Renderer* renderer) {
     y += lineHeight;
   }
 
-  ConvertToFormat(surface, this->texture->Width() * this->texture->Height(), this->texture->Format());
-
   this->isReady = true;
 }
 
 void TextBlock::PaintLine(const TextLine& line, float x, color_t* surface, int32_t pitch) noexcept {
-  FT_BitmapGlyph glyph;
-  color_t* s;
-  int32_t yOffset;
-  float advance;
   auto pos{static_cast<float>(x)};
   const auto ascent{::ceilf(FromFloat266(this->font->GetAscent()))};
 
   for (size_t i = line.start; i < line.end; i++) {
-    advance = FromFloat266(this->codepoints[i].advance266);
-    glyph = this->font->GetGlyphBitmap(this->codepoints[i].value);
+    this->PaintGlyph(this->codepoints[i].value, pos, ascent, surface, pitch);
+    pos += FromFloat266(this->codepoints[i].advance266);
+  }
+
+  if (line.ellipsis) {
+    const auto dotAdvance{FromFloat266(this->font->GetAdvance('.'))};
 
-    if (!glyph) {
-      pos += advance;
-      continue;
+    for (auto i = 0; i < 3; i++) {
+      this->PaintGlyph('.', pos, ascent, surface, pitch);
+      pos += dotAdvance;
     }
+  }
+}
 
-    yOffset = static_cast<int32_t>(ascent - glyph->top);
+void TextBlock::PaintGlyph(uint32_t codepoint, float x, float ascent, color_t* surface, int32_t pitch) noexcept {
+  const auto glyph{this->font->GetGlyphBitmap(codepoint)};
 
-    if (yOffset < 0) {
-      continue;
-    }
+  if (!glyph) {
+    return;
+  }
 
-    s = surface + ((yOffset * pitch) + SnapToPixelGrid<int32_t>(pos) + glyph->left);
+  const auto yOffset{static_cast<int32_t>(ascent - glyph->top)};
 
-    for (uint32_t by = 0; by < glyph->bitmap.rows; by++) {
-      for (uint32_t bx = 0; bx < glyph->bitmap.width; bx++) {
-        *s++ = 0xFFFFFF | (glyph->bitmap.buffer[by*glyph->bitmap.pitch + bx] << 24);
-      }
-      s += (pitch - glyph->bitmap.width);
-    }
+  if (yOffset < 0) {
+    return;
+  }
+
+  auto s{surface + ((yOffset * pitch) + SnapToPixelGrid<int32_t>(x) + glyph->left)};
 
-    pos += advance;
+  for (uint32_t by = 0; by < glyph->bitmap.rows; by++) {
+    for (uint32_t bx = 0; bx < glyph->bitmap.width; bx++) {
+      // premultiplied white: every channel equals the glyph coverage, so the value is the same in any pixel
+      // format and no format conversion is necessary.
+      *s++ = glyph->bitmap.buffer[by*glyph->bitmap.pitch + bx] * 0x01010101u;
+    }
+    s += (pitch - glyph->bitmap.width);
   }
 }
 
@@ -237,20 +330,39 @@ int32_t TextBlock::ComputeLineHeight() const noexcept {
   return (lineHeight >> 6);
 }
 
-TextureLock TextBlock::LockTexture(Renderer* renderer) noexcept {
-  if (this->texture && this->Width() <= this->texture->Width() && this->Height() <= this->texture->Height()) {
-    return {this->texture, true};
-  }
+void TextBlock::BuildTextureKey(std::string* key) const {
+  // The pixels depend on the font, size, alignment, bounds and the codepoints of each line. Values are appended as
+  // raw bytes; the key is only compared, never printed.
+  const auto append = [key](const void* value, std::size_t size) {
+    key->append(static_cast<const char*>(value), size);
+  };
+  const int32_t header[]{ this->fontSize, static_cast<int32_t>(this->align), this->calculatedWidth,
+                          this->calculatedHeight };
 
-  Texture::SafeDestroy(this->texture);
+  append(&this->font, sizeof(this->font));
+  append(header, sizeof(header));
 
-  // Add a little bit of extra size, to reduce the chance a size change causes texture churn.
-  const auto extraW{static_cast<int32_t>(this->Width() * 0.1f)};
-  const auto extraH{static_cast<int32_t>(this->Height() * 0.1f)};
+  for (const auto& line : this->lines) {
+    const uint32_t mark{ line.ellipsis ? 0xFFFFFFFEu : 0xFFFFFFFFu };
 
-  this->texture = renderer->CreateTexture(this->Width() + extraW, this->Height() + extraH, Texture::Lockable);
+    for (auto i{line.start}; i < line.end; i++) {
+      append(&this->codepoints[i].value, sizeof(uint32_t));
+    }
 
-  return {this->texture, this->texture != nullptr};
+    append(&mark, sizeof(mark));
+  }
+}
+
+void TextBlock::ReleaseTexture() noexcept {
+  if (this->texture) {
+    this->textureOwner->ReleaseTextTexture(this->textureKey, this->textureScope);
+  }
+
+  this->texture = nullptr;
+  this->textureOwner = nullptr;
+  this->textureScope = nullptr;
+  this->textureKey.clear();
+  this->isReady = false;
 }
 
 int32_t TextBlock::Width() const noexcept {
@@ -271,14 +383,19 @@ float TextBlock::HeightF() const noexcept {
 
 void TextBlock::Destroy() noexcept {
   this->Invalidate();
-  this->texture = Texture::SafeDestroy(this->texture);
+  this->ReleaseTexture();
 }
 
 void TextBlock::Invalidate() noexcept {
   this->calculatedWidth = this->calculatedHeight = 0;
   this->lines.clear();
   this->font = nullptr;
+  this->fontSize = 0;
+  this->textTransform = {};
   this->codepoints.clear();
+  this->layoutCache.clear();
+  this->layoutCacheNext = 0;
+  this->layoutIndex = -1;
   this->align = {};
   this->isReady = false;
 }
@@ -287,7 +404,7 @@ bool TextBlock::IsEmpty() const noexcept {
   return this->calculatedWidth <= 0 || this->calculatedHeight <= 0;
 }
 
-void TextBlock::LoadCodepoints(const std::string& utf8, Style* style) {
+void TextBlock::LoadCodepoints(const std::string& utf8) {
   assert(!utf8.empty());
 
   auto i{utf8.begin()};
@@ -296,7 +413,7 @@ void TextBlock::LoadCodepoints(const std::string& utf8, Style* style) {
 
   this->codepoints.reserve(LengthUtf8(utf8));
 
-  switch (style->GetEnum<StyleTextTransform>(StyleProperty::textTransform)) {
+  switch (this->textTransform) {
     case StyleTextTransformLowercase:
       op = &std::tolower;
       break;
@@ -363,6 +480,10 @@ int32_t TextBlock::MeasureLine(const TextLine& line) const noexcept {
     width266 += this->codepoints[i].advance266;
   }
 
+  if (line.ellipsis) {
+    width266 += this->GetEllipsisWidth();
+  }
+
   return width266;
 }
 
@@ -378,7 +499,7 @@ bool TextBlock::AtVerticalLimit(int32_t maxHeight266, std::size_t maxLines, std:
   return (maxLines > 0 && lineNo == maxLines) || (maxHeight266 > 0 && ToFloat266(lineNo) > maxHeight266);
 }
 
-void TextBlock::EllipsizeIfNecessary(Style* style, int32_t maxWidth266) noexcept {
+void TextBlock::EllipsizeIfNecessary(StyleTextOverflow textOverflow, int32_t maxWidth266) noexcept {
   /*
    * Assumes that layout processing has completed and the text could not fit in the
    * layout area. If text overflow is not ellipsis, the last line is sufficiently
@@ -392,12 +513,11 @@ void TextBlock::EllipsizeIfNecessary(Style* style, int32_t maxWidth266) noexcept
    * If a run of multiple spaces are in the line, the ellipsis appears dangling.
    */
 
-  if (style->GetEnum(StyleProperty::textOverflow) != StyleTextOverflowEllipsis) {
+  if (textOverflow != StyleTextOverflowEllipsis) {
     return;
   }
 
-  const auto dotAdvance266{this->font->GetAdvance('.')};
-  const auto ellipsisWidth266{ ((dotAdvance266 >> 6) * 3) << 6 | (dotAdvance266 & 0b111111) };
+  const auto ellipsisWidth266{this->GetEllipsisWidth()};
 
   // if font has not dot or ellipsis does not fit in available space, bail.
   if (ellipsisWidth266 <= 0 || maxWidth266 < ellipsisWidth266) {
@@ -413,7 +533,7 @@ void TextBlock::EllipsizeIfNecessary(Style* style, int32_t maxWidth266) noexcept
 
   // Check if there is already space for the ellipsis.
   if (this->MeasureLine(lastLine) + ellipsisWidth266 < maxWidth266) {
-    AppendEllipsis(lastLine);
+    lastLine.ellipsis = true;
     return;
   }
 
@@ -425,21 +545,14 @@ void TextBlock::EllipsizeIfNecessary(Style* style, int32_t maxWidth266) noexcept
 
     if (space266 >= ellipsisWidth266) {
       lastLine.end = i;
-      AppendEllipsis(lastLine);
+      lastLine.ellipsis = true;
       return;
     }
   }
 }
 
-void TextBlock::AppendEllipsis(TextLine& line) noexcept {
-  auto dotAdvance{this->font->GetAdvance('.')};
-
-  this->codepoints.erase(this->codepoints.begin() + line.end, this->codepoints.end());
-  this->codepoints.emplace_back('.', dotAdvance);
-  this->codepoints.emplace_back('.', dotAdvance);
-  this->codepoints.emplace_back('.', dotAdvance);
-
-  line.end += 3;
+Float266 TextBlock::GetEllipsisWidth() const noexcept {
+  return this->font->GetAdvance('.') * 3;
 }
 
 bool TextBlock::IsReady() const noexcept {
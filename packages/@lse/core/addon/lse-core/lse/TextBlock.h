@@ -24,23 +24,42 @@
 
 namespace lse {
 
-class Renderer;
+class ImageManager;
 class Style;
 class StyleContext;
 class Font;
 
 /**
  * Drawing and layout of text strings for the content area of text elements.
+ *
+ * Shaping is split in two steps, both cached. The text is decoded to codepoints with their advances once per text,
+ * font and font size. Line breaking results are memoized per bounding box and line style, so the repeated measures of
+ * a yoga layout pass do not redo the work.
+ *
+ * The painted texture is shared through the ImageManager with other blocks (in any scene of the graphics context)
+ * showing the same lines with the same font, size and alignment.
  */
 class TextBlock {
  public:
-  // Render the text block. Shape must be called for this function to render.
-  void Paint(Renderer* renderer);
-  // Layout text according to style settings and dimensions of the bounding box.
-  void Shape(const std::string& utf8, Font* font, Style* style, StyleContext* context, float maxWidth, float maxHeight);
-  // Reset text layout, usually due to a text change or style change.
+  /**
+   * Render the text block. Shape must be called for this function to render.
+   *
+   * The texture is acquired from imageManager on behalf of scope (the scene) and only painted if no other block has
+   * painted the same text.
+   */
+  void Paint(ImageManager* imageManager, const void* scope);
+  /**
+   * Layout text according to style settings and dimensions of the bounding box.
+   *
+   * The codepoints of utf8 are reused until Invalidate() is called, so the caller must Invalidate() when the text
+   * changes. Font and style changes are detected.
+   *
+   * @return true if the layout changed and the block needs to be painted
+   */
+  bool Shape(const std::string& utf8, Font* font, Style* style, StyleContext* context, float maxWidth, float maxHeight);
+  // Reset text layout and shaped codepoints, usually due to a text change or font change.
   void Invalidate() noexcept;
-  // Invalidate and destroy the texture that backs this block. Object can be reused after Destroy().
+  // Invalidate and release the texture that backs this block. Object can be reused after Destroy().
   void Destroy() noexcept;
   // Is the layout empty? It will be empty if Shape() has not been called or Invalidate() was called.
   bool IsEmpty() const noexcept;
@@ -64,6 +83,7 @@ class TextBlock {
     std::size_t start{};
     std::size_t end{};
     Float266 width266{};
+    // Draw "..." after end. The codepoints are not modified, so layouts of other sizes can share them.
     bool ellipsis{};
   };
 
@@ -77,30 +97,61 @@ class TextBlock {
     Float266 advance266{};
   };
 
+  // Inputs of Layout(), other than the codepoints.
+  struct LayoutKey {
+    float maxWidth;
+    float maxHeight;
+    std::size_t maxLines;
+    StyleTextOverflow textOverflow;
+
+    bool operator==(const LayoutKey& other) const noexcept {
+      return this->maxWidth == other.maxWidth && this->maxHeight == other.maxHeight
+          && this->maxLines == other.maxLines && this->textOverflow == other.textOverflow;
+    }
+  };
+
+  struct LayoutResult {
+    LayoutKey key;
+    std::vector<TextLine> lines;
+    int32_t width;
+    int32_t height;
+  };
+
  private:
-  void LoadCodepoints(const std::string& utf8, Style* style);
-  void Layout(Style* style, float maxWidth, float maxHeight);
+  void LoadCodepoints(const std::string& utf8);
+  void Layout(const LayoutKey& key);
   size_t TrimLeft(std::size_t begin, std::size_t end) const noexcept;
   void PushLine(std::size_t begin, std::size_t end);
   int32_t MeasureLine(const TextLine& line) const noexcept;
   float MeasureLineF(const TextLine& line) const noexcept;
   bool AtVerticalLimit(int32_t maxHeight266, std::size_t maxLines) const noexcept;
   bool AtVerticalLimit(int32_t maxHeight266, std::size_t maxLines, std::size_t lineNo) const noexcept;
-  void EllipsizeIfNecessary(Style* style, int32_t maxWidth266) noexcept;
+  void EllipsizeIfNecessary(StyleTextOverflow textOverflow, int32_t maxWidth266) noexcept;
   void PaintLine(const TextLine& line, float x, color_t* surface, int32_t pitch) noexcept;
+  void PaintGlyph(uint32_t codepoint, float x, float ascent, color_t* surface, int32_t pitch) noexcept;
+  Float266 GetEllipsisWidth() const noexcept;
   int32_t ComputeLineHeight() const noexcept;
-  TextureLock LockTexture(Renderer* renderer) noexcept;
-  void AppendEllipsis(TextLine& line) noexcept;
+  void BuildTextureKey(std::string* key) const;
+  void ReleaseTexture() noexcept;
 
  private:
   FTFontSource* font{};
   int32_t fontSize{};
+  StyleTextTransform textTransform{};
+  // Shared texture, acquired from textureOwner with textureKey on behalf of textureScope.
   Texture* texture{};
+  ImageManager* textureOwner{};
+  const void* textureScope{};
+  std::string textureKey{};
   int32_t calculatedWidth{};
   int32_t calculatedHeight{};
   StyleTextAlign align{};
   std::vector<Codepoint> codepoints{};
   std::vector<TextLine> lines{};
+  // Memoized Layout() results for the current codepoints. layoutIndex is the entry lines was set from; -1 if none.
+  std::vector<LayoutResult> layoutCache{};
+  std::size_t layoutCacheNext{};
+  int32_t layoutIndex{-1};
   bool isReady{false};
 };
 
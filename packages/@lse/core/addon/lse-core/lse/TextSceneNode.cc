@@ -54,12 +54,14 @@ void TextSceneNode::OnStylePropertyChanged(StyleProperty property) {
 }
 
 void TextSceneNode::OnFlexBoxLayoutChanged() {
+  this->RequestPaint();
   this->MarkCompositeDirty();
 }
 
 void TextSceneNode::OnComputeStyle() {
   if (this->SetFont(this->style)) {
      this->block.Invalidate();
+     this->RequestPaint();
      YGNodeMarkDirty(this->ygNode);
   }
 }
@@ -73,7 +75,11 @@ YGSize TextSceneNode::OnMeasure(float width, YGMeasureMode widthMode, float heig
     height = this->scene->GetHeight();
   }
 
-  this->block.Shape(this->text, this->fontFace, this->style, this->GetStyleContext(), width, height);
+  // Yoga measures with several constraints per layout. TextBlock memoizes the results, so repeated measures with the
+  // same constraints are cheap and only repaint if the layout of the text changed.
+  if (this->block.Shape(this->text, this->fontFace, this->style, this->GetStyleContext(), width, height)) {
+    this->RequestPaint();
+  }
 
   return { this->block.WidthF(), this->block.HeightF() };
 }
@@ -92,6 +98,7 @@ void TextSceneNode::SetText(std::string&& text) {
   if (this->text != text) {
     this->text = std::move(text);
     this->block.Invalidate();
+    this->RequestPaint();
     YGNodeMarkDirty(this->ygNode);
   }
 }
@@ -135,6 +142,7 @@ bool TextSceneNode::SetFont(Style* style) {
         auto self{static_cast<TextSceneNode*>(listener)};
         if (status == FontStatusReady) {
           self->block.Invalidate();
+          self->RequestPaint();
           YGNodeMarkDirty(self->ygNode);
           font->RemoveListener(listener);
         } else {
@@ -152,21 +160,26 @@ bool TextSceneNode::SetFont(Style* style) {
   return dirty;
 }
 
-void TextSceneNode::DrawText(CompositeContext* ctx) {
-  auto box{YGNodeGetPaddingBox(this->ygNode)};
-  auto textStyle{Style::Or(this->style)};
-
+void TextSceneNode::OnPaint(Renderer* renderer) {
   if (this->block.IsEmpty()) {
     // if style width and height are set, measure is not used. if this is the situation, shape the text before paint.
+    auto box{YGNodeGetPaddingBox(this->ygNode)};
+    auto textStyle{Style::Or(this->style)};
+
     this->block.Shape(this->text, this->fontFace, textStyle, this->GetStyleContext(), box.width, box.height);
   }
 
-  this->block.Paint(ctx->renderer);
+  this->block.Paint(this->GetImageManager(), this->scene.Get());
+}
 
+void TextSceneNode::DrawText(CompositeContext* ctx) {
   if (!this->block.IsReady()) {
     return;
   }
 
+  auto box{YGNodeGetPaddingBox(this->ygNode)};
+  auto textStyle{Style::Or(this->style)};
+
   Rect pos{
     box.x + ctx->CurrentMatrix().GetTranslateX(),
     box.y + ctx->CurrentMatrix().GetTranslateY(),
@@ -193,7 +206,7 @@ void TextSceneNode::DrawText(CompositeContext* ctx) {
       pos,
       this->block.GetTextureSourceRect(),
       this->block.GetTexture(),
-      this->GetStyleContext()->ComputeFilter(textStyle, textColor, ctx->CurrentOpacity()));
+      this->GetFilter(textColor, ctx->CurrentOpacity()));
 }
 
 void TextSceneNode::ClearFontFaceResource() {
@@ -208,6 +221,12 @@ void TextSceneNode::OnDestroy() {
   this->block.Destroy();
 }
 
+void TextSceneNode::OnAttach() {
+  // OnDetach() released the font and texture. Find the font again, which will reshape and repaint the text.
+  this->MarkComputeStyleDirty();
+  this->RequestPaint();
+}
+
 // TODO: temporary hack due to scene and renderer shutdown conflicts
 void TextSceneNode::OnDetach() {
   this->ClearFontFaceResource();
@@ -32,6 +32,8 @@ class TextSceneNode final : public SceneNode {
   void OnStylePropertyChanged(StyleProperty property) override;
   void OnFlexBoxLayoutChanged() override;
   void OnComputeStyle() override;
+  void OnPaint(Renderer* renderer) override;
+  void OnAttach() override;
   void OnDetach() override;
 
   YGSize OnMeasure(float width, YGMeasureMode widthMode, float height, YGMeasureMode heightMode) override;
@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2021 Light Source Software, LLC. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on
+ * an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the
+ * specific language governing permissions and limitations under the License.
+ */
+
+#include "CoreClasses.h"
+
+#include <napix.h>
+#include <lse/CanvasSceneNode.h>
+#include <lse/bindings/CSceneNodeConstructor.h>
+
+using napix::js_class::define;
+using napix::descriptor::instance_method;
+
+namespace lse {
+namespace bindings {
+
+static napi_value SetCommands(napi_env env, napi_callback_info info) noexcept {
+  auto ci{napix::get_callback_info<2>(env, info)};
+  auto node{ci.unwrap_this_as<CanvasSceneNode>(env)};
+
+  if (napix::is_nullish(env, ci[0])) {
+    node->ClearCommands();
+    return {};
+  }
+
+  NAPIX_EXPECT_TRUE(env, napix::is_typedarray(env, ci[0]), "commands must be a Float64Array", {});
+
+  auto commands{napix::as_typedarray(env, ci[0], napi_float64_array)};
+
+  std::vector<std::string> imageUris;
+
+  if (napix::is_array(env, ci[1])) {
+    uint32_t length{};
+
+    napi_get_array_length(env, ci[1], &length);
+    imageUris.reserve(length);
+
+    for (uint32_t i = 0; i < length; i++) {
+      imageUris.emplace_back(napix::as_string_utf8(env, napix::object_at(env, ci[1], i)));
+    }
+  }
+
+  NAPIX_TRY_STD(env, node->SetCommands(commands.as<double>(), commands.size, std::move(imageUris)), {});
+
+  return {};
+}
+
+static napi_value GetCommandCount(napi_env env, napi_callback_info info) noexcept {
+  auto node{napix::unwrap_this_as<CanvasSceneNode>(env, info)};
+
+  return napix::to_value(env, static_cast<uint32_t>(node->GetCommandCount()));
+}
+
+napi_value CCanvasSceneNode::CreateClass(napi_env env) noexcept {
+  auto props{ CSceneNode::GetClassProperties(env) };
+
+  props.emplace_back(instance_method("setCommands", &SetCommands));
+  props.emplace_back(instance_method("getCommandCount", &GetCommandCount));
+
+  return define(env, NAME, &CSceneNodeConstructor<CanvasSceneNode>, props.size(), props.data());
+}
+
+} // namespace bindings
+} // namespace lse
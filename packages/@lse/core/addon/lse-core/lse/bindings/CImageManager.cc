@@ -20,6 +20,7 @@
 using napix::unwrap_this_as;
 using napix::js_class::define;
 using napix::descriptor::instance_method;
+using napix::descriptor::instance_value;
 
 namespace lse {
 namespace bindings {
@@ -55,8 +56,53 @@ static napi_value Constructor(napi_env env, napi_callback_info info) noexcept {
       });
 }
 
+static napi_value Destroy(napi_env env, napi_callback_info info) noexcept {
+  unwrap_this_as<ImageManager>(env, info)->Destroy();
+
+  return {};
+}
+
+static napi_value GetStats(napi_env env, napi_callback_info info) noexcept {
+  auto imageManager{unwrap_this_as<ImageManager>(env, info)};
+  const auto& stats{imageManager->GetStats()};
+  auto count = [env](std::size_t value) { return napix::to_value(env, static_cast<uint32_t>(value)); };
+
+  return napix::object_new(env, {
+      instance_value("imageCount", count(imageManager->GetImageCount()), napi_enumerable),
+      instance_value("acquireCount", count(stats.acquireCount), napi_enumerable),
+      instance_value("shareCount", count(stats.shareCount), napi_enumerable),
+      instance_value("savedBytes", count(stats.savedBytes), napi_enumerable),
+      instance_value("textShareCount", count(stats.textShareCount), napi_enumerable),
+      instance_value("textSavedBytes", count(stats.textSavedBytes), napi_enumerable),
+  });
+}
+
+static napi_value SetShadowLimit(napi_env env, napi_callback_info info) noexcept {
+  auto ci{ napix::get_callback_info<1>(env, info) };
+
+  ci.unwrap_this_as<ImageManager>(env)->SetShadowLimit(static_cast<uint32_t>(napix::as_uint32(env, ci[0], 0)));
+
+  return {};
+}
+
+static napi_value GetShadowStats(napi_env env, napi_callback_info info) noexcept {
+  const auto& budget{unwrap_this_as<ImageManager>(env, info)->GetShadowBudget()};
+  auto count = [env](std::size_t value) { return napix::to_value(env, static_cast<uint32_t>(value)); };
+
+  return napix::object_new(env, {
+      instance_value("limit", count(budget.limit), napi_enumerable),
+      instance_value("usedBytes", count(budget.used), napi_enumerable),
+      instance_value("count", count(budget.count), napi_enumerable),
+  });
+}
+
 napi_value CImageManager::CreateClass(napi_env env) noexcept {
-  return define(env, NAME, Constructor, {});
+  return define(env, NAME, Constructor, {
+      instance_method("destroy", &Destroy),
+      instance_method("getStats", &GetStats),
+      instance_method("setShadowLimit", &SetShadowLimit),
+      instance_method("getShadowStats", &GetShadowStats),
+  });
 }
 
 } // namespace bindings
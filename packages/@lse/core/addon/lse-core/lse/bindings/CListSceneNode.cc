@@ -0,0 +1,175 @@
+/*
+ * Copyright (c) 2021 Light Source Software, LLC. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on
+ * an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the
+ * specific language governing permissions and limitations under the License.
+ */
+
+#include "CoreClasses.h"
+
+#include <napix.h>
+#include <lse/Log.h>
+#include <lse/ListSceneNode.h>
+#include <lse/bindings/CSceneNodeConstructor.h>
+
+using napix::js_class::define;
+using napix::descriptor::instance_accessor;
+using napix::descriptor::instance_value;
+using napix::descriptor::instance_method;
+
+namespace lse {
+namespace bindings {
+
+class NapiListRangeCallback : public ListRangeCallback {
+ public:
+  NapiListRangeCallback(napi_env env, napi_ref callback) noexcept : env(env), callback(callback) {
+  }
+
+  ~NapiListRangeCallback() override {
+    if (this->callback) {
+      napi_delete_reference(this->env, this->callback);
+    }
+  }
+
+  void Invoke(int32_t first, int32_t last) override {
+    auto callStatus = napix::call_function(
+        this->env, this->callback, { napix::to_value(this->env, first), napix::to_value(this->env, last) }, nullptr);
+
+    if (napix::has_pending_exception(env)) {
+      LOG_ERROR("Uncaught JS exception: %s", napix::pop_pending_exception(env));
+    } else if (callStatus != napi_ok) {
+      LOG_ERROR("callback invoke: %i", callStatus);
+    }
+  }
+
+ private:
+  napi_env env{};
+  napi_ref callback{};
+};
+
+static napi_value GetItemCount(napi_env env, napi_callback_info info) noexcept {
+  return napix::to_value(env, napix::unwrap_this_as<ListSceneNode>(env, info)->GetItemCount());
+}
+
+static napi_value SetItemCount(napi_env env, napi_callback_info info) noexcept {
+  auto ci{napix::get_callback_info<1>(env, info)};
+
+  ci.unwrap_this_as<ListSceneNode>(env)->SetItemCount(napix::as_int32(env, ci[0], 0));
+
+  return {};
+}
+
+static napi_value GetItemExtent(napi_env env, napi_callback_info info) noexcept {
+  return napix::to_value(env, napix::unwrap_this_as<ListSceneNode>(env, info)->GetItemExtent());
+}
+
+static napi_value SetItemExtent(napi_env env, napi_callback_info info) noexcept {
+  auto ci{napix::get_callback_info<1>(env, info)};
+
+  ci.unwrap_this_as<ListSceneNode>(env)->SetItemExtent(napix::as_float(env, ci[0], 0));
+
+  return {};
+}
+
+static napi_value GetOverscan(napi_env env, napi_callback_info info) noexcept {
+  return napix::to_value(env, napix::unwrap_this_as<ListSceneNode>(env, info)->GetOverscan());
+}
+
+static napi_value SetOverscan(napi_env env, napi_callback_info info) noexcept {
+  auto ci{napix::get_callback_info<1>(env, info)};
+
+  ci.unwrap_this_as<ListSceneNode>(env)->SetOverscan(napix::as_int32(env, ci[0], 0));
+
+  return {};
+}
+
+static napi_value GetHorizontal(napi_env env, napi_callback_info info) noexcept {
+  return napix::to_value(env, napix::unwrap_this_as<ListSceneNode>(env, info)->IsHorizontal());
+}
+
+static napi_value SetHorizontal(napi_env env, napi_callback_info info) noexcept {
+  auto ci{napix::get_callback_info<1>(env, info)};
+
+  ci.unwrap_this_as<ListSceneNode>(env)->SetHorizontal(napix::as_bool(env, ci[0], false));
+
+  return {};
+}
+
+static napi_value GetScrollOffset(napi_env env, napi_callback_info info) noexcept {
+  return napix::to_value(env, napix::unwrap_this_as<ListSceneNode>(env, info)->GetScrollOffset());
+}
+
+static napi_value SetScrollOffset(napi_env env, napi_callback_info info) noexcept {
+  auto ci{napix::get_callback_info<1>(env, info)};
+
+  ci.unwrap_this_as<ListSceneNode>(env)->SetScrollOffset(napix::as_float(env, ci[0], 0));
+
+  return {};
+}
+
+static napi_value GetMaxScrollOffset(napi_env env, napi_callback_info info) noexcept {
+  return napix::to_value(env, napix::unwrap_this_as<ListSceneNode>(env, info)->GetMaxScrollOffset());
+}
+
+static napi_value GetRange(napi_env env, napi_callback_info info) noexcept {
+  auto node{napix::unwrap_this_as<ListSceneNode>(env, info)};
+
+  return napix::object_new(env, {
+      instance_value(env, "first", node->GetFirstIndex(), napi_enumerable),
+      instance_value(env, "last", node->GetLastIndex(), napi_enumerable),
+  });
+}
+
+static napi_value SetRangeCallback(napi_env env, napi_callback_info info) noexcept {
+  auto ci{napix::get_callback_info<1>(env, info)};
+  auto node{ci.unwrap_this_as<ListSceneNode>(env)};
+  std::unique_ptr<NapiListRangeCallback> callback;
+
+  if (napix::is_function(env, ci[0])) {
+    if (node->HasRangeCallback()) {
+      napix::throw_error(env, "callback already set");
+      return {};
+    }
+
+    napi_ref ref{};
+    napi_create_reference(env, ci[0], 1, &ref);
+
+    if (!ref) {
+      napix::throw_error(env, "failed to create ref");
+      return {};
+    }
+
+    callback = std::make_unique<NapiListRangeCallback>(env, ref);
+  } else if (!napix::is_nullish(env, ci[0])) {
+    napix::throw_error(env, "expected function or null");
+    return {};
+  }
+
+  node->SetRangeCallback(std::move(callback));
+
+  return {};
+}
+
+napi_value CListSceneNode::CreateClass(napi_env env) noexcept {
+  auto props{ CSceneNode::GetClassProperties(env) };
+
+  props.emplace_back(instance_accessor("itemCount", &GetItemCount, &SetItemCount));
+  props.emplace_back(instance_accessor("itemExtent", &GetItemExtent, &SetItemExtent));
+  props.emplace_back(instance_accessor("overscan", &GetOverscan, &SetOverscan));
+  props.emplace_back(instance_accessor("horizontal", &GetHorizontal, &SetHorizontal));
+  props.emplace_back(instance_accessor("scrollOffset", &GetScrollOffset, &SetScrollOffset));
+  props.emplace_back(instance_accessor("maxScrollOffset", &GetMaxScrollOffset, nullptr));
+  props.emplace_back(instance_method("getRange", &GetRange));
+  props.emplace_back(instance_method("setCallback", &SetRangeCallback));
+
+  return define(env, NAME, &CSceneNodeConstructor<ListSceneNode>, props.size(), props.data());
+}
+
+} // namespace bindings
+} // namespace lse
@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2021 Light Source Software, LLC. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on
+ * an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the
+ * specific language governing permissions and limitations under the License.
+ */
+
+#include "CoreClasses.h"
+
+#include <napix.h>
+#include <lse/PixelSceneNode.h>
+#include <lse/bindings/CSceneNodeConstructor.h>
+
+using napix::js_class::define;
+using napix::descriptor::instance_method;
+
+namespace lse {
+namespace bindings {
+
+static napi_value SetFrame(napi_env env, napi_callback_info info) noexcept {
+  auto ci{napix::get_callback_info<5>(env, info)};
+  auto node{ci.unwrap_this_as<PixelSceneNode>(env)};
+  auto pixels{napix::as_bytes(env, ci[0])};
+
+  NAPIX_EXPECT_FALSE(env, pixels.empty(), "pixels must be an ArrayBuffer or TypedArray", {});
+
+  auto width{napix::as_int32(env, ci[1], 0)};
+  auto height{napix::as_int32(env, ci[2], 0)};
+  auto pitch{napix::as_int32(env, ci[3], width * 4)};
+  auto format{napix::as_int32(env, ci[4], PixelFormatRGBA)};
+
+  NAPIX_EXPECT_TRUE(env, width > 0 && height > 0, "width and height must be greater than 0", {});
+  NAPIX_EXPECT_TRUE(env, IsEnum<PixelFormat>(format), "invalid pixel format", {});
+  NAPIX_EXPECT_TRUE(
+      env,
+      pitch >= width * 4
+          && pixels.size >= static_cast<std::size_t>(pitch) * static_cast<std::size_t>(height - 1) + width * 4,
+      "pixels buffer is too small for width, height and pitch",
+      {});
+
+  bool result{};
+
+  NAPIX_TRY_STD(
+      env,
+      result = node->SetFrame(pixels.as<uint8_t>(), width, height, pitch, static_cast<PixelFormat>(format)),
+      {});
+
+  return napix::to_value(env, result);
+}
+
+static napi_value ClearFrame(napi_env env, napi_callback_info info) noexcept {
+  napix::unwrap_this_as<PixelSceneNode>(env, info)->ClearFrame();
+
+  return {};
+}
+
+static napi_value GetTextureFormat(napi_env env, napi_callback_info info) noexcept {
+  return napix::to_value(
+      env, static_cast<int32_t>(napix::unwrap_this_as<PixelSceneNode>(env, info)->GetTextureFormat()));
+}
+
+static napi_value GetFrameWidth(napi_env env, napi_callback_info info) noexcept {
+  return napix::to_value(env, napix::unwrap_this_as<PixelSceneNode>(env, info)->GetFrameWidth());
+}
+
+static napi_value GetFrameHeight(napi_env env, napi_callback_info info) noexcept {
+  return napix::to_value(env, napix::unwrap_this_as<PixelSceneNode>(env, info)->GetFrameHeight());
+}
+
+napi_value CPixelSceneNode::CreateClass(napi_env env) noexcept {
+  auto props{ CSceneNode::GetClassProperties(env) };
+
+  props.emplace_back(instance_method("setFrame", &SetFrame));
+  props.emplace_back(instance_method("clearFrame", &ClearFrame));
+  props.emplace_back(instance_method("getTextureFormat", &GetTextureFormat));
+  props.emplace_back(instance_method("getFrameWidth", &GetFrameWidth));
+  props.emplace_back(instance_method("getFrameHeight", &GetFrameHeight));
+
+  return define(env, NAME, &CSceneNodeConstructor<PixelSceneNode>, props.size(), props.data());
+}
+
+} // namespace bindings
+} // namespace lse
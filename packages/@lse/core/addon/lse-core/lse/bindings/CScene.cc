@@ -13,10 +13,13 @@
 
 #include "CoreClasses.h"
 
+#include <algorithm>
 #include <napix.h>
 #include <lse/GraphicsContext.h>
 #include <lse/RootSceneNode.h>
 #include <lse/Scene.h>
+#include <lse/SceneNode.h>
+#include <lse/SceneNodePool.h>
 #include <lse/Habitat.h>
 #include <lse/Stage.h>
 
@@ -24,6 +27,7 @@ using napix::unwrap_this_as;
 using napix::unwrap_as;
 using napix::js_class::define;
 using napix::descriptor::instance_method;
+using napix::descriptor::instance_value;
 using napix::js_class::constructor_helper;
 
 namespace lse {
@@ -86,11 +90,20 @@ static napi_value Detach(napi_env env, napi_callback_info info) noexcept {
   return {};
 }
 
-static napi_value Render(napi_env env, napi_callback_info info) noexcept {
-  NAPIX_TRY_STD(env, unwrap_this_as<Scene>(env, info)->Frame(), {});
+static napi_value Update(napi_env env, napi_callback_info info) noexcept {
+  NAPIX_TRY_STD(env, unwrap_this_as<Scene>(env, info)->Update(), {});
   return {};
 }
 
+static napi_value Render(napi_env env, napi_callback_info info) noexcept {
+  auto scene{unwrap_this_as<Scene>(env, info)};
+
+  NAPIX_TRY_STD(env, scene->Render(), {});
+
+  // Tell the caller if there are observer records to take, so frames without changes do not cross into native again.
+  return napix::to_value(env, !scene->GetObserverRecords().empty());
+}
+
 static napi_value Destroy(napi_env env, napi_callback_info info) noexcept {
   NAPIX_TRY_STD(env, unwrap_this_as<Scene>(env, info)->Destroy(), {})
   return {};
@@ -112,13 +125,310 @@ static napi_value SetRoot(napi_env env, napi_callback_info info) noexcept {
   return {};
 }
 
+static napi_value GetPaintBudget(napi_env env, napi_callback_info info) noexcept {
+  return napix::to_value(env, unwrap_this_as<Scene>(env, info)->GetPaintBudget());
+}
+
+static napi_value SetPaintBudget(napi_env env, napi_callback_info info) noexcept {
+  auto ci{ napix::get_callback_info<1>(env, info) };
+
+  ci.unwrap_this_as<Scene>(env)->SetPaintBudget(napix::as_float(env, ci[0], 0));
+
+  return {};
+}
+
+static napi_value ApplyCommands(napi_env env, napi_callback_info info) noexcept {
+  auto ci{napix::get_callback_info<1>(env, info)};
+  auto scene{ci.unwrap_this_as<Scene>(env)};
+
+  NAPIX_EXPECT_TRUE(env, napix::is_typedarray(env, ci[0]), "commands must be a Uint32Array", {});
+
+  auto commands{napix::as_typedarray(env, ci[0], napi_uint32_array)};
+
+  NAPIX_TRY_STD(env, scene->ApplyCommands(commands.as<uint32_t>(), commands.size), {});
+
+  return {};
+}
+
+static napi_value GetNodePoolStats(napi_env env, napi_callback_info info) noexcept {
+  const auto& stats{unwrap_this_as<Scene>(env, info)->GetNodePool()->GetStats()};
+  auto count = [env](std::size_t value) { return napix::to_value(env, static_cast<uint32_t>(value)); };
+
+  return napix::object_new(env, {
+      instance_value("liveCount", count(stats.liveCount), napi_enumerable),
+      instance_value("freeCount", count(stats.freeCount), napi_enumerable),
+      instance_value("slabCount", count(stats.slabCount), napi_enumerable),
+      instance_value("reservedBytes", count(stats.reservedBytes), napi_enumerable),
+      instance_value("allocationCount", count(stats.allocationCount), napi_enumerable),
+      instance_value("recycledCount", count(stats.recycledCount), napi_enumerable),
+  });
+}
+
+static napi_value GetAttachStats(napi_env env, napi_callback_info info) noexcept {
+  auto scene{unwrap_this_as<Scene>(env, info)};
+  auto imageManager{scene->GetImageManager()};
+
+  return napix::object_new(env, {
+      instance_value(env, "attachTime", scene->GetAttachTime(), napi_enumerable),
+      instance_value(env, "imageUploadCount", imageManager->GetAttachUploadCount(), napi_enumerable),
+      instance_value(env, "imageLoadCount", imageManager->GetAttachLoadCount(), napi_enumerable),
+  });
+}
+
+static napi_value GetFrameStats(napi_env env, napi_callback_info info) noexcept {
+  auto scene{unwrap_this_as<Scene>(env, info)};
+  const auto count{scene->GetFrameStatsCount()};
+  auto result{napix::array_new(env, count)};
+
+  for (std::size_t i = 0; i < count; i++) {
+    const auto& stats{scene->GetFrameStats(i)};
+    auto entry{napix::object_new(env, {
+        instance_value(env, "frame", stats.frame, napi_enumerable),
+        instance_value(env, "layoutCount", stats.layoutCount, napi_enumerable),
+        instance_value(env, "computeStyleCount", stats.computeStyleCount, napi_enumerable),
+        instance_value(env, "paintCount", stats.paintCount, napi_enumerable),
+        instance_value(env, "compositeCount", stats.compositeCount, napi_enumerable),
+        instance_value(env, "culledCount", stats.culledCount, napi_enumerable),
+        instance_value(env, "layoutOnlyCount", stats.layoutOnlyCount, napi_enumerable),
+        instance_value(env, "drawCalls", stats.drawCalls, napi_enumerable),
+        instance_value(env, "textureUploads", stats.textureUploads, napi_enumerable),
+        instance_value(env, "stateChanges", stats.stateChanges, napi_enumerable),
+        instance_value(env, "frameTime", stats.frameTime, napi_enumerable),
+    })};
+
+    napi_set_element(env, result, static_cast<uint32_t>(i), entry);
+  }
+
+  return result;
+}
+
+static napi_value GetGeometry(napi_env env, napi_callback_info info) noexcept {
+  auto ci{napix::get_callback_info<2>(env, info)};
+  auto scene{ci.unwrap_this_as<Scene>(env)};
+
+  NAPIX_EXPECT_TRUE(env, napix::is_typedarray(env, ci[1]), "out must be a Float32Array", {});
+
+  auto out{napix::as_typedarray(env, ci[1], napi_float32_array)};
+
+  NAPIX_EXPECT_TRUE(env, out.size >= 10, "out must have room for 10 values", {});
+
+  const NodeGeometry* geometry{};
+
+  NAPIX_TRY_STD(env, geometry = scene->GetGeometry(scene->GetNode(napix::as_uint32(env, ci[0], 0))), {});
+
+  if (!geometry) {
+    return napix::to_value(env, false);
+  }
+
+  // Layout: bounds x, y, width, height, then the transform a, b, x, c, d, y.
+  const auto& bounds{geometry->bounds};
+  const auto& m{geometry->transform};
+  const float values[]{ bounds.x, bounds.y, bounds.width, bounds.height, m.a, m.b, m.x, m.c, m.d, m.y };
+
+  std::copy(std::begin(values), std::end(values), out.as<float>());
+
+  return napix::to_value(env, true);
+}
+
+static napi_value HitTest(napi_env env, napi_callback_info info) noexcept {
+  auto ci{napix::get_callback_info<2>(env, info)};
+  auto scene{ci.unwrap_this_as<Scene>(env)};
+  SceneNode* result{};
+
+  NAPIX_TRY_STD(env, result = scene->HitTest(napix::as_float(env, ci[0], 0), napix::as_float(env, ci[1], 0)), {});
+
+  return napix::to_value(env, result ? result->GetId() : 0);
+}
+
+static napi_value SaveSnapshot(napi_env env, napi_callback_info info) noexcept {
+  auto scene{unwrap_this_as<Scene>(env, info)};
+  std::vector<uint8_t> snapshot;
+  napi_value result{};
+
+  NAPIX_TRY_STD(env, snapshot = scene->SaveSnapshot(), {});
+
+  napi_create_buffer_copy(env, snapshot.size(), snapshot.data(), nullptr, &result);
+
+  return result;
+}
+
+static napi_value LoadSnapshot(napi_env env, napi_callback_info info) noexcept {
+  auto ci{napix::get_callback_info<1>(env, info)};
+  auto scene{ci.unwrap_this_as<Scene>(env)};
+  auto bytes{napix::as_bytes(env, ci[0])};
+
+  NAPIX_EXPECT_FALSE(env, bytes.empty(), "snapshot must be an ArrayBuffer or TypedArray", {});
+  NAPIX_TRY_STD(env, scene->LoadSnapshot(bytes.as<uint8_t>(), bytes.size), {});
+
+  return {};
+}
+
+static napi_value ReleaseSnapshot(napi_env env, napi_callback_info info) noexcept {
+  unwrap_this_as<Scene>(env, info)->ReleaseSnapshot();
+
+  return {};
+}
+
+static napi_value HasSnapshot(napi_env env, napi_callback_info info) noexcept {
+  return napix::to_value(env, unwrap_this_as<Scene>(env, info)->HasSnapshot());
+}
+
+static napi_value FindFocus(napi_env env, napi_callback_info info) noexcept {
+  auto ci{napix::get_callback_info<3>(env, info)};
+  auto scene{ci.unwrap_this_as<Scene>(env)};
+  auto from{scene->GetNode(napix::as_uint32(env, ci[0], 0))};
+  auto direction{static_cast<FocusDirection>(napix::as_int32(env, ci[1], 0))};
+  auto within{scene->GetNode(napix::as_uint32(env, ci[2], 0))};
+  SceneNode* result{};
+
+  NAPIX_TRY_STD(env, result = scene->FindFocus(from, direction, within), {});
+
+  return napix::to_value(env, result ? result->GetId() : 0);
+}
+
+static napi_value AddLayer(napi_env env, napi_callback_info info) noexcept {
+  auto ci{napix::get_callback_info<2>(env, info)};
+  auto scene{ci.unwrap_this_as<Scene>(env)};
+
+  NAPIX_TRY_STD(env, scene->AddLayer(
+      scene->GetNode(napix::as_uint32(env, ci[0], 0)), napix::as_int32(env, ci[1], 0)), {});
+
+  return {};
+}
+
+static napi_value RemoveLayer(napi_env env, napi_callback_info info) noexcept {
+  auto ci{napix::get_callback_info<1>(env, info)};
+  auto scene{ci.unwrap_this_as<Scene>(env)};
+
+  scene->RemoveLayer(scene->GetNode(napix::as_uint32(env, ci[0], 0)));
+
+  return {};
+}
+
+static napi_value SetLayerZIndex(napi_env env, napi_callback_info info) noexcept {
+  auto ci{napix::get_callback_info<2>(env, info)};
+  auto scene{ci.unwrap_this_as<Scene>(env)};
+
+  NAPIX_TRY_STD(env, scene->SetLayerZIndex(
+      scene->GetNode(napix::as_uint32(env, ci[0], 0)), napix::as_int32(env, ci[1], 0)), {});
+
+  return {};
+}
+
+static napi_value SetLayerCached(napi_env env, napi_callback_info info) noexcept {
+  auto ci{napix::get_callback_info<2>(env, info)};
+  auto scene{ci.unwrap_this_as<Scene>(env)};
+
+  NAPIX_TRY_STD(env, scene->SetLayerCached(
+      scene->GetNode(napix::as_uint32(env, ci[0], 0)), napix::as_bool(env, ci[1], false)), {});
+
+  return {};
+}
+
+static napi_value AddObserver(napi_env env, napi_callback_info info) noexcept {
+  auto ci{napix::get_callback_info<3>(env, info)};
+  auto scene{ci.unwrap_this_as<Scene>(env)};
+  std::vector<float> thresholds;
+  uint32_t length{};
+
+  if (napix::is_array(env, ci[2])) {
+    napi_get_array_length(env, ci[2], &length);
+  }
+
+  for (uint32_t i = 0; i < length; i++) {
+    thresholds.push_back(napix::object_at_or(env, ci[2], i, 0.f));
+  }
+
+  NAPIX_TRY_STD(env, scene->AddObserver(napix::as_uint32(env, ci[0], 0),
+      static_cast<NodeObserverType>(napix::as_int32(env, ci[1], 0)), std::move(thresholds)), {});
+
+  return {};
+}
+
+static napi_value RemoveObserver(napi_env env, napi_callback_info info) noexcept {
+  auto ci{napix::get_callback_info<1>(env, info)};
+
+  ci.unwrap_this_as<Scene>(env)->RemoveObserver(napix::as_uint32(env, ci[0], 0));
+
+  return {};
+}
+
+static napi_value Observe(napi_env env, napi_callback_info info) noexcept {
+  auto ci{napix::get_callback_info<2>(env, info)};
+  auto scene{ci.unwrap_this_as<Scene>(env)};
+  bool result{};
+
+  NAPIX_TRY_STD(env, result = scene->Observe(
+      napix::as_uint32(env, ci[0], 0), scene->GetNode(napix::as_uint32(env, ci[1], 0))), {});
+
+  return napix::to_value(env, result);
+}
+
+static napi_value Unobserve(napi_env env, napi_callback_info info) noexcept {
+  auto ci{napix::get_callback_info<2>(env, info)};
+  auto scene{ci.unwrap_this_as<Scene>(env)};
+
+  scene->Unobserve(napix::as_uint32(env, ci[0], 0), scene->GetNode(napix::as_uint32(env, ci[1], 0)));
+
+  return {};
+}
+
+static napi_value TakeObserverRecords(napi_env env, napi_callback_info info) noexcept {
+  auto scene{unwrap_this_as<Scene>(env, info)};
+  const auto& records{scene->GetObserverRecords()};
+  auto result{napix::array_new(env, records.size())};
+
+  for (std::size_t i = 0; i < records.size(); i++) {
+    const auto& record{records[i]};
+    auto entry{napix::object_new(env, {
+        instance_value(env, "observerId", static_cast<int32_t>(record.observerId), napi_enumerable),
+        instance_value(env, "nodeId", static_cast<int32_t>(record.nodeId), napi_enumerable),
+        instance_value("x", napix::to_value(env, record.rect.x), napi_enumerable),
+        instance_value("y", napix::to_value(env, record.rect.y), napi_enumerable),
+        instance_value("width", napix::to_value(env, record.rect.width), napi_enumerable),
+        instance_value("height", napix::to_value(env, record.rect.height), napi_enumerable),
+        instance_value("ratio", napix::to_value(env, record.ratio), napi_enumerable),
+        instance_value("isIntersecting", napix::to_value(env, record.isIntersecting), napi_enumerable),
+    })};
+
+    napi_set_element(env, result, static_cast<uint32_t>(i), entry);
+  }
+
+  scene->ClearObserverRecords();
+
+  return result;
+}
+
 napi_value CScene::CreateClass(napi_env env) {
   return define(env, NAME, Constructor, {
       instance_method("attach", &Attach),
       instance_method("detach", &Detach),
+      instance_method("update", &Update),
       instance_method("render", &Render),
       instance_method("destroy", &Destroy),
       instance_method("setRoot", &SetRoot),
+      instance_method("getPaintBudget", &GetPaintBudget),
+      instance_method("setPaintBudget", &SetPaintBudget),
+      instance_method("getNodePoolStats", &GetNodePoolStats),
+      instance_method("getFrameStats", &GetFrameStats),
+      instance_method("getAttachStats", &GetAttachStats),
+      instance_method("applyCommands", &ApplyCommands),
+      instance_method("findFocus", &FindFocus),
+      instance_method("getGeometry", &GetGeometry),
+      instance_method("hitTest", &HitTest),
+      instance_method("saveSnapshot", &SaveSnapshot),
+      instance_method("loadSnapshot", &LoadSnapshot),
+      instance_method("releaseSnapshot", &ReleaseSnapshot),
+      instance_method("hasSnapshot", &HasSnapshot),
+      instance_method("addLayer", &AddLayer),
+      instance_method("removeLayer", &RemoveLayer),
+      instance_method("setLayerZIndex", &SetLayerZIndex),
+      instance_method("setLayerCached", &SetLayerCached),
+      instance_method("addObserver", &AddObserver),
+      instance_method("removeObserver", &RemoveObserver),
+      instance_method("observe", &Observe),
+      instance_method("unobserve", &Unobserve),
+      instance_method("takeObserverRecords", &TakeObserverRecords),
   });
 }
 
@@ -46,6 +46,10 @@ static napi_value BindStyle(napi_env env, napi_callback_info info) noexcept {
   return ci[0];
 }
 
+static napi_value GetId(napi_env env, napi_callback_info info) noexcept {
+  return napix::to_value(env, napix::unwrap_this_as<SceneNode>(env, info)->GetId());
+}
+
 static napi_value GetX(napi_env env, napi_callback_info info) noexcept {
   return napix::to_value(env, napix::unwrap_this_as<SceneNode>(env, info)->GetX());
 }
@@ -144,7 +148,10 @@ static SceneNode* ToSceneNode(napi_env env, napi_value value) noexcept {
   // workaround to do an instanceof to check for scene node
   if (Habitat::InstanceOf(env, value, Habitat::Class::CBoxSceneNode)
       || Habitat::InstanceOf(env, value, Habitat::Class::CImageSceneNode)
-      || Habitat::InstanceOf(env, value, Habitat::Class::CTextSceneNode)) {
+      || Habitat::InstanceOf(env, value, Habitat::Class::CTextSceneNode)
+      || Habitat::InstanceOf(env, value, Habitat::Class::CCanvasSceneNode)
+      || Habitat::InstanceOf(env, value, Habitat::Class::CPixelSceneNode)
+      || Habitat::InstanceOf(env, value, Habitat::Class::CListSceneNode)) {
     return napix::unwrap_as<SceneNode>(env, value);
   }
 
@@ -154,6 +161,7 @@ static SceneNode* ToSceneNode(napi_env env, napi_value value) noexcept {
 std::vector<napi_property_descriptor> CSceneNode::GetClassProperties(napi_env env) noexcept {
   return {
       instance_method("bindStyle", &BindStyle),
+      instance_method("getId", &GetId),
       instance_method("getX", &GetX),
       instance_method("getY", &GetY),
       instance_method("getWidth", &GetWidth),
@@ -95,6 +95,30 @@ class CTextSceneNode {
   static napi_value CreateClass(napi_env env) noexcept;
 };
 
+class CCanvasSceneNode {
+ public:
+  static constexpr auto NAME = "CCanvasSceneNode";
+  static constexpr auto CLASS_ID = Habitat::Class::CCanvasSceneNode;
+
+  static napi_value CreateClass(napi_env env) noexcept;
+};
+
+class CListSceneNode {
+ public:
+  static constexpr auto NAME = "CListSceneNode";
+  static constexpr auto CLASS_ID = Habitat::Class::CListSceneNode;
+
+  static napi_value CreateClass(napi_env env) noexcept;
+};
+
+class CPixelSceneNode {
+ public:
+  static constexpr auto NAME = "CPixelSceneNode";
+  static constexpr auto CLASS_ID = Habitat::Class::CPixelSceneNode;
+
+  static napi_value CreateClass(napi_env env) noexcept;
+};
+
 class CImage {
  public:
   static constexpr auto NAME = "CImage";
@@ -14,6 +14,9 @@
 #include "CoreEnums.h"
 
 #include <lse/StyleEnums.h>
+#include <lse/CanvasSceneNode.h>
+#include <lse/PixelFormat.h>
+#include <lse/Scene.h>
 #include <napix.h>
 
 using napix::object_new;
@@ -68,5 +71,58 @@ napi_value NewStyleFilterEnum(napi_env env) noexcept {
   });
 }
 
+napi_value NewCanvasCommandEnum(napi_env env) noexcept {
+  return object_new(env, {
+      instance_value(env, "BEGIN_PATH", CanvasCommandBeginPath, napi_enumerable),
+      instance_value(env, "CLOSE_PATH", CanvasCommandClosePath, napi_enumerable),
+      instance_value(env, "MOVE_TO", CanvasCommandMoveTo, napi_enumerable),
+      instance_value(env, "LINE_TO", CanvasCommandLineTo, napi_enumerable),
+      instance_value(env, "BEZIER_CURVE_TO", CanvasCommandBezierCurveTo, napi_enumerable),
+      instance_value(env, "QUADRATIC_CURVE_TO", CanvasCommandQuadraticCurveTo, napi_enumerable),
+      instance_value(env, "ARC", CanvasCommandArc, napi_enumerable),
+      instance_value(env, "RECT", CanvasCommandRect, napi_enumerable),
+      instance_value(env, "FILL", CanvasCommandFill, napi_enumerable),
+      instance_value(env, "STROKE", CanvasCommandStroke, napi_enumerable),
+      instance_value(env, "FILL_RECT", CanvasCommandFillRect, napi_enumerable),
+      instance_value(env, "STROKE_RECT", CanvasCommandStrokeRect, napi_enumerable),
+      instance_value(env, "DRAW_IMAGE", CanvasCommandDrawImage, napi_enumerable),
+      instance_value(env, "SET_FILL_STYLE", CanvasCommandSetFillStyle, napi_enumerable),
+      instance_value(env, "SET_STROKE_STYLE", CanvasCommandSetStrokeStyle, napi_enumerable),
+      instance_value(env, "SET_LINE_WIDTH", CanvasCommandSetLineWidth, napi_enumerable),
+      instance_value(env, "SET_LINE_CAP", CanvasCommandSetLineCap, napi_enumerable),
+      instance_value(env, "SET_LINE_JOIN", CanvasCommandSetLineJoin, napi_enumerable),
+      instance_value(env, "SET_MITER_LIMIT", CanvasCommandSetMiterLimit, napi_enumerable),
+      instance_value(env, "SET_GLOBAL_ALPHA", CanvasCommandSetGlobalAlpha, napi_enumerable),
+      instance_value(env, "SAVE", CanvasCommandSave, napi_enumerable),
+      instance_value(env, "RESTORE", CanvasCommandRestore, napi_enumerable),
+      instance_value(env, "TRANSLATE", CanvasCommandTranslate, napi_enumerable),
+      instance_value(env, "ROTATE", CanvasCommandRotate, napi_enumerable),
+      instance_value(env, "SCALE", CanvasCommandScale, napi_enumerable),
+      instance_value(env, "TRANSFORM", CanvasCommandTransform, napi_enumerable),
+      instance_value(env, "SET_TRANSFORM", CanvasCommandSetTransform, napi_enumerable),
+  });
+}
+
+napi_value NewSceneCommandEnum(napi_env env) noexcept {
+  return object_new(env, {
+      instance_value(env, "APPEND_CHILD", SceneCommandAppendChild, napi_enumerable),
+      instance_value(env, "INSERT_BEFORE", SceneCommandInsertBefore, napi_enumerable),
+      instance_value(env, "REMOVE_CHILD", SceneCommandRemoveChild, napi_enumerable),
+      instance_value(env, "SET_HIDDEN", SceneCommandSetHidden, napi_enumerable),
+      instance_value(env, "DESTROY", SceneCommandDestroy, napi_enumerable),
+      instance_value(env, "SET_FOCUSABLE", SceneCommandSetFocusable, napi_enumerable),
+  });
+}
+
+napi_value NewPixelFormatEnum(napi_env env) noexcept {
+  return object_new(env, {
+      instance_value(env, "RGBA", PixelFormatRGBA, napi_enumerable),
+      instance_value(env, "ARGB", PixelFormatARGB, napi_enumerable),
+      instance_value(env, "ABGR", PixelFormatABGR, napi_enumerable),
+      instance_value(env, "BGRA", PixelFormatBGRA, napi_enumerable),
+      instance_value(env, "UNKNOWN", PixelFormatUnknown, napi_enumerable),
+  });
+}
+
 } // namespace bindings
 } // namespace lse
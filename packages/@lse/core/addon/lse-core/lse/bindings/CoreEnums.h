@@ -22,6 +22,9 @@ napi_value NewStyleUnitEnum(napi_env env) noexcept;
 napi_value NewStyleTransformEnum(napi_env env) noexcept;
 napi_value NewStyleAnchorEnum(napi_env env) noexcept;
 napi_value NewStyleFilterEnum(napi_env env) noexcept;
+napi_value NewCanvasCommandEnum(napi_env env) noexcept;
+napi_value NewSceneCommandEnum(napi_env env) noexcept;
+napi_value NewPixelFormatEnum(napi_env env) noexcept;
 
 } // namespace bindings
 } // namespace lse
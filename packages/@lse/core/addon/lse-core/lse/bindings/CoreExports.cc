@@ -42,6 +42,9 @@ napi_value CoreExports(napi_env env, napi_value exports) noexcept {
   Export(env, exports, "FontStatus", NewFontStatusEnum(env));
   Export(env, exports, "FontStyle", NewFontStyleEnum(env));
   Export(env, exports, "FontWeight", NewFontWeightEnum(env));
+  Export(env, exports, "CanvasCommand", NewCanvasCommandEnum(env));
+  Export(env, exports, "SceneCommand", NewSceneCommandEnum(env));
+  Export(env, exports, "PixelFormat", NewPixelFormatEnum(env));
 
   // Objects
   Export(env, exports, "logger", NewLoggerObject(env));
@@ -77,6 +80,9 @@ napi_value CoreExports(napi_env env, napi_value exports) noexcept {
   Export(env, exports, CImageSceneNode::CLASS_ID);
   Export(env, exports, CRootSceneNode::CLASS_ID);
   Export(env, exports, CTextSceneNode::CLASS_ID);
+  Export(env, exports, CCanvasSceneNode::CLASS_ID);
+  Export(env, exports, CListSceneNode::CLASS_ID);
+  Export(env, exports, CPixelSceneNode::CLASS_ID);
   Export(env, exports, CImageManager::CLASS_ID);
 
   return exports;
@@ -133,6 +139,9 @@ static void LoadHabitatClasses(napi_env env) noexcept {
   Habitat::SetClass(env, CImageSceneNode::CLASS_ID, CImageSceneNode::CreateClass(env));
   Habitat::SetClass(env, CRootSceneNode::CLASS_ID, CRootSceneNode::CreateClass(env));
   Habitat::SetClass(env, CTextSceneNode::CLASS_ID, CTextSceneNode::CreateClass(env));
+  Habitat::SetClass(env, CCanvasSceneNode::CLASS_ID, CCanvasSceneNode::CreateClass(env));
+  Habitat::SetClass(env, CListSceneNode::CLASS_ID, CListSceneNode::CreateClass(env));
+  Habitat::SetClass(env, CPixelSceneNode::CLASS_ID, CPixelSceneNode::CreateClass(env));
   Habitat::SetClass(env, CImageManager::CLASS_ID, CImageManager::CreateClass(env));
 }
 
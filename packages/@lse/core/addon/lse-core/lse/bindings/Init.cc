@@ -11,7 +11,6 @@
  * specific language governing permissions and limitations under the License.
  */
 
-#include <event/event.h>
 #include <lse/Style.h>
 #include <lse/StyleValidator.h>
 #include <lse/System.h>
@@ -22,8 +21,6 @@
 #include <lse/bindings/CoreExports.h>
 #include <node_api.h>
 
-using facebook::yoga::Event;
-
 static napi_value Init(napi_env env, napi_value exports) {
   auto logLevel = lse::GetEnvOrDefault("LSE_LOG_LEVEL", "INFO");
 
@@ -48,7 +45,6 @@ static napi_value Init(napi_env env, napi_value exports) {
   lse::Style::Init();
   lse::StyleValidator::Init();
   lse::StylePropertyValueInit();
-  Event::subscribe(lse::SceneNode::YogaNodeLayoutEvent);
 
   lse::bindings::CoreExports(env, exports);
 
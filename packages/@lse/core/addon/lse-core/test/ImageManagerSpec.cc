@@ -43,6 +43,19 @@ void ImageManagerSpec(TestSuite* parent) {
         imageManager.Attach(renderer.get());
         imageManager.Attach(renderer.get());
       }
+    },
+    {
+      "should throw when attached to another renderer",
+      [](const TestInfo&) {
+        ImageManager imageManager([](Image*){});
+        auto renderer{RefRenderer::New()};
+        auto other{RefRenderer::New()};
+
+        imageManager.Attach(renderer.get());
+        Assert::Throws([&](){ imageManager.Attach(other.get()); });
+        imageManager.Detach();
+        Assert::IsFalse(imageManager.IsAttached());
+      }
     }
   };
 
@@ -67,6 +80,104 @@ void ImageManagerSpec(TestSuite* parent) {
         imageManager.Detach();
         imageManager.Detach();
       }
+    },
+    {
+      "should stay attached until each Attach() is matched by a Detach()",
+      [](const TestInfo&) {
+        ImageManager imageManager([](Image*){});
+        auto renderer{RefRenderer::New()};
+
+        imageManager.Attach(renderer.get());
+        imageManager.Attach(renderer.get());
+        imageManager.Detach();
+        Assert::IsTrue(imageManager.IsAttached());
+        imageManager.Detach();
+        Assert::IsFalse(imageManager.IsAttached());
+      }
+    }
+  };
+
+  spec->Describe("GetStats()")->tests = {
+    {
+      "should count images shared by uri across scopes",
+      [](const TestInfo&) {
+        ImageManager imageManager([](Image*){});
+        int scope1{};
+        int scope2{};
+        auto a{ imageManager.Acquire({ "test.png" }, &scope1) };
+        auto b{ imageManager.Acquire({ "test.png" }, &scope2) };
+        const auto& stats{ imageManager.GetStats() };
+
+        Assert::Equal(a, b);
+        Assert::Equal(stats.acquireCount, static_cast<std::size_t>(2));
+        Assert::Equal(stats.shareCount, static_cast<std::size_t>(1));
+        Assert::Equal(imageManager.GetImageCount(), static_cast<std::size_t>(1));
+
+        imageManager.Release(b, &scope2);
+        imageManager.Release(a, &scope1);
+        Assert::Equal(imageManager.GetImageCount(), static_cast<std::size_t>(0));
+      }
+    },
+    {
+      "should not count a uri repeated within one scope as a share",
+      [](const TestInfo&) {
+        ImageManager imageManager([](Image*){});
+        int scope{};
+        auto a{ imageManager.Acquire({ "test.png" }, &scope) };
+        auto b{ imageManager.Acquire({ "test.png" }, &scope) };
+        const auto& stats{ imageManager.GetStats() };
+
+        Assert::Equal(a, b);
+        Assert::Equal(stats.acquireCount, static_cast<std::size_t>(2));
+        Assert::Equal(stats.shareCount, static_cast<std::size_t>(0));
+
+        imageManager.Release(b, &scope);
+        imageManager.Release(a, &scope);
+        Assert::Equal(imageManager.GetImageCount(), static_cast<std::size_t>(0));
+      }
+    }
+  };
+
+  spec->Describe("AcquireTextTexture()")->tests = {
+    {
+      "should share a text texture by key across scopes",
+      [](const TestInfo&) {
+        ImageManager imageManager([](Image*){});
+        auto renderer{RefRenderer::New()};
+        int scope1{};
+        int scope2{};
+        bool isNew{};
+
+        imageManager.Attach(renderer.get());
+
+        auto a{ imageManager.AcquireTextTexture("text", 10, 5, &scope1, &isNew) };
+
+        Assert::IsTrue(a != nullptr);
+        Assert::IsTrue(isNew);
+
+        auto b{ imageManager.AcquireTextTexture("text", 10, 5, &scope2, &isNew) };
+        const auto& stats{ imageManager.GetStats() };
+
+        Assert::Equal(a, b);
+        Assert::IsFalse(isNew);
+        Assert::Equal(stats.textShareCount, static_cast<std::size_t>(1));
+        Assert::Equal(stats.textSavedBytes, static_cast<std::size_t>(10 * 5 * 4));
+
+        imageManager.ReleaseTextTexture("text", &scope1);
+        imageManager.ReleaseTextTexture("text", &scope2);
+        imageManager.Detach();
+      }
+    },
+    {
+      "should return nullptr when detached",
+      [](const TestInfo&) {
+        ImageManager imageManager([](Image*){});
+        int scope{};
+        bool isNew{};
+
+        Assert::IsTrue(imageManager.AcquireTextTexture("text", 10, 5, &scope, &isNew) == nullptr);
+        Assert::IsFalse(isNew);
+      }
     }
   };
 
@@ -41,6 +41,9 @@ class Habitat {
       CImageSceneNode,
       CBoxSceneNode,
       CTextSceneNode,
+      CCanvasSceneNode,
+      CPixelSceneNode,
+      CListSceneNode,
       CImage,
       CImageManager,
       StyleValue,
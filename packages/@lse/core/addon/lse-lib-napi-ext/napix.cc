@@ -176,6 +176,59 @@ buffer_info as_buffer(napi_env env, napi_value value) noexcept {
   return bi;
 }
 
+buffer_info as_typedarray(napi_env env, napi_value value, napi_typedarray_type type) noexcept {
+  buffer_info bi{};
+  napi_typedarray_type valueType{};
+  size_t length{};
+  void* data{};
+
+  if (is_typedarray(env, value)
+      && napi_get_typedarray_info(env, value, &valueType, &length, &data, nullptr, nullptr) == napi_ok
+      && valueType == type) {
+    bi.data = data;
+    bi.size = length;
+  }
+
+  return bi;
+}
+
+static size_t typedarray_element_size(napi_typedarray_type type) noexcept {
+  switch (type) {
+    case napi_int16_array:
+    case napi_uint16_array:
+      return 2;
+    case napi_int32_array:
+    case napi_uint32_array:
+    case napi_float32_array:
+      return 4;
+    case napi_float64_array:
+    case napi_bigint64_array:
+    case napi_biguint64_array:
+      return 8;
+    default:
+      return 1;
+  }
+}
+
+buffer_info as_bytes(napi_env env, napi_value value) noexcept {
+  buffer_info bi{};
+
+  if (is_arraybuffer(env, value)) {
+    napi_get_arraybuffer_info(env, value, &bi.data, &bi.size);
+  } else if (is_typedarray(env, value)) {
+    napi_typedarray_type type{};
+    size_t length{};
+
+    if (napi_get_typedarray_info(env, value, &type, &length, &bi.data, nullptr, nullptr) == napi_ok) {
+      bi.size = length * typedarray_element_size(type);
+    } else {
+      bi.data = nullptr;
+    }
+  }
+
+  return bi;
+}
+
 int32_t as_int32(napi_env env, napi_value value, int32_t defaultValue) noexcept {
   int32_t v;
 
@@ -421,6 +474,16 @@ bool is_array(napi_env env, napi_value value) noexcept {
   return (napi_is_array(env, value, &result) == napi_ok && result);
 }
 
+bool is_typedarray(napi_env env, napi_value value) noexcept {
+  bool result{};
+  return (value && napi_is_typedarray(env, value, &result) == napi_ok && result);
+}
+
+bool is_arraybuffer(napi_env env, napi_value value) noexcept {
+  bool result{};
+  return (value && napi_is_arraybuffer(env, value, &result) == napi_ok && result);
+}
+
 napi_status call_function(
     napi_env env,
     napi_ref functionRef,
@@ -185,6 +185,10 @@ bool as_bool(napi_env env, napi_value value, bool defaultValue) noexcept;
 float as_float(napi_env env, napi_value value, float defaultValue) noexcept;
 std::string as_string_utf8(napi_env env, napi_value str) noexcept;
 napix::buffer_info as_buffer(napi_env env, napi_value value) noexcept;
+// TypedArray of the given type. buffer_info size is the number of elements, not bytes.
+napix::buffer_info as_typedarray(napi_env env, napi_value value, napi_typedarray_type type) noexcept;
+// Memory of an ArrayBuffer or the memory viewed by a TypedArray of any type. buffer_info size is in bytes.
+napix::buffer_info as_bytes(napi_env env, napi_value value) noexcept;
 const char* copy_utf8(napi_env env, napi_value value, char* buffer, size_t bufferSize, const char* fallback) noexcept;
 
 std::string object_get(napi_env env, napi_value value, const char* prop) noexcept;
@@ -210,6 +214,8 @@ bool is_string(napi_env env, napi_value value) noexcept;
 bool is_number(napi_env env, napi_value value) noexcept;
 bool is_buffer(napi_env env, napi_value value) noexcept;
 bool is_array(napi_env env, napi_value value) noexcept;
+bool is_typedarray(napi_env env, napi_value value) noexcept;
+bool is_arraybuffer(napi_env env, napi_value value) noexcept;
 
 /**
  * Call a function contained by a reference.
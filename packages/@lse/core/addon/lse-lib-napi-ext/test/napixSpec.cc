@@ -22,6 +22,7 @@ namespace lse {
 
 static napi_value CreateObject(napi_env env);
 static napi_value CreateString(napi_env env, const char* text);
+static napi_value CreateTypedArray(napi_env env, napi_typedarray_type type, size_t length);
 static std::string GetAndClearLastExceptionMessage(napi_env env);
 
 void napixSpec(TestSuite* parent) {
@@ -206,6 +207,74 @@ void napixSpec(TestSuite* parent) {
       }
     }
   };
+
+  spec->Describe("as_typedarray()")->tests = {
+    {
+      "should return data and element count for typed array",
+      [](const TestInfo& info) {
+        auto env{ info.Env() };
+        auto value = napix::as_typedarray(env, CreateTypedArray(env, napi_float64_array, 4), napi_float64_array);
+
+        Assert::IsFalse(value.empty());
+        Assert::Equal(value.size, static_cast<size_t>(4));
+      }
+    },
+    {
+      "should return empty when typed array type does not match",
+      [](const TestInfo& info) {
+        auto env{ info.Env() };
+        auto value = napix::as_typedarray(env, CreateTypedArray(env, napi_uint8_array, 4), napi_float64_array);
+
+        Assert::IsTrue(value.empty());
+      }
+    },
+    {
+      "should return empty for non-typed array values",
+      [](const TestInfo& info) {
+        auto env{ info.Env() };
+
+        Assert::IsTrue(napix::as_typedarray(env, nullptr, napi_float64_array).empty());
+        Assert::IsTrue(napix::as_typedarray(env, CreateObject(env), napi_float64_array).empty());
+      }
+    }
+  };
+
+  spec->Describe("as_bytes()")->tests = {
+    {
+      "should return byte length of typed array",
+      [](const TestInfo& info) {
+        auto env{ info.Env() };
+        auto value = napix::as_bytes(env, CreateTypedArray(env, napi_float64_array, 4));
+
+        Assert::IsFalse(value.empty());
+        Assert::Equal(value.size, static_cast<size_t>(4 * sizeof(double)));
+      }
+    },
+    {
+      "should return data and byte length of array buffer",
+      [](const TestInfo& info) {
+        auto env{ info.Env() };
+        napi_value arrayBuffer{};
+        void* data{};
+
+        Assert::IsTrue(napi_create_arraybuffer(env, 16, &data, &arrayBuffer) == napi_ok);
+
+        auto value = napix::as_bytes(env, arrayBuffer);
+
+        Assert::IsTrue(value.data == data);
+        Assert::Equal(value.size, static_cast<size_t>(16));
+      }
+    },
+    {
+      "should return empty for non-buffer values",
+      [](const TestInfo& info) {
+        auto env{ info.Env() };
+
+        Assert::IsTrue(napix::as_bytes(env, nullptr).empty());
+        Assert::IsTrue(napix::as_bytes(env, CreateObject(env)).empty());
+      }
+    }
+  };
 }
 
 static std::string GetAndClearLastExceptionMessage(napi_env env) {
@@ -242,4 +311,17 @@ static napi_value CreateString(napi_env env, const char* text) {
   return str;
 }
 
+static napi_value CreateTypedArray(napi_env env, napi_typedarray_type type, size_t length) {
+  napi_value arrayBuffer{};
+  napi_value typedArray{};
+  void* data{};
+  size_t elementSize{type == napi_float64_array ? sizeof(double) : sizeof(uint8_t)};
+
+  Assert::IsTrue(napi_create_arraybuffer(env, length * elementSize, &data, &arrayBuffer) == napi_ok);
+  Assert::IsTrue(napi_create_typedarray(env, type, length, arrayBuffer, 0, &typedArray) == napi_ok);
+  Assert::IsNotNull(typedArray);
+
+  return typedArray;
+}
+
 } // namespace lse
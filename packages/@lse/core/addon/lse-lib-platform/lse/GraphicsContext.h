@@ -25,6 +25,8 @@ struct GraphicsContextConfig {
   int32_t displayIndex{};
   bool fullscreen{};
   std::string fullscreenMode{};
+  /** Renderer implementation. "software" selects the CPU renderer; otherwise, the platform default is used. */
+  std::string renderer{};
 };
 
 /**
@@ -25,8 +25,8 @@ class ImageBytes {
  public:
   ImageBytes() noexcept = default;
 
-  ImageBytes(uint8_t* bytes, Deleter deleter, int32_t width, int32_t height, int32_t pitch)
-      : bytes(bytes, deleter), width(width), height(height), pitch(pitch) {
+  ImageBytes(uint8_t* bytes, Deleter deleter, int32_t width, int32_t height, int32_t pitch, bool isOpaque = false)
+      : bytes(bytes, deleter), width(width), height(height), pitch(pitch), isOpaque(isOpaque) {
   }
 
   int32_t Width() const noexcept {
@@ -57,16 +57,50 @@ class ImageBytes {
     return this->format;
   }
 
+  bool IsPremultiplied() const noexcept {
+    return this->isPremultiplied;
+  }
+
+  /**
+   * True if every pixel has an alpha of 255. Known at decode time for formats without an alpha channel; otherwise,
+   * determined by PremultiplyAlpha().
+   */
+  bool IsOpaque() const noexcept {
+    return this->isOpaque;
+  }
+
+  /**
+   * Convert straight alpha pixels to premultiplied alpha. Does nothing if already premultiplied.
+   */
+  void PremultiplyAlpha() noexcept {
+    if (this->isPremultiplied || !this->bytes) {
+      return;
+    }
+
+    // opaque pixels are the same in straight and premultiplied alpha.
+    if (!this->isOpaque) {
+      this->isOpaque = lse::PremultiplyAlpha(
+          reinterpret_cast<color_t*>(this->bytes.get()), this->width * this->height, this->format);
+    }
+
+    this->isPremultiplied = true;
+  }
+
+  /**
+   * Convert the pixels to targetFormat. The pixels can be in any format, for example, a shadow kept in the texture
+   * format of a previous renderer.
+   */
   void SyncFormat(PixelFormat targetFormat) noexcept {
-    if (targetFormat == PixelFormat::PixelFormatUnknown || targetFormat == PixelFormat::PixelFormatRGBA
-        || targetFormat == this->format || !this->bytes) {
+    if (targetFormat == PixelFormat::PixelFormatUnknown || targetFormat == this->format || !this->bytes) {
       return;
     }
 
-    ConvertToFormat(
-        reinterpret_cast<color_t*>(this->bytes.get()),
-        this->width * this->height,
-        targetFormat);
+    auto pixels{reinterpret_cast<color_t*>(this->bytes.get())};
+    const auto len{this->width * this->height};
+
+    // ConvertToFormat() expects RGBA, so pixels in another format go through RGBA first.
+    ConvertToRGBA(pixels, len, this->format);
+    ConvertToFormat(pixels, len, targetFormat);
 
     this->format = targetFormat;
   }
@@ -74,6 +108,7 @@ class ImageBytes {
   void Release() {
     this->bytes.reset();
     this->width = this->height = this->pitch = 0;
+    this->isPremultiplied = this->isOpaque = false;
   }
 
  private:
@@ -82,6 +117,8 @@ class ImageBytes {
   int32_t height{};
   int32_t pitch{};
   PixelFormat format{PixelFormat::PixelFormatRGBA};
+  bool isPremultiplied{};
+  bool isOpaque{};
 };
 
 } // namespace lse
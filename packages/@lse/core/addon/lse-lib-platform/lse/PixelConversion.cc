@@ -13,46 +13,176 @@
 
 #include "PixelConversion.h"
 
+#include <cstring>
+
 using std20::endian;
 
 namespace lse {
 
 void ConvertToFormat(color_t* pixels, int32_t len, PixelFormat format) noexcept {
+  ConvertToFormat(pixels, pixels, len, format);
+}
+
+void ConvertToFormat(const color_t* source, color_t* dest, int32_t len, PixelFormat format) noexcept {
+  switch (format) {
+    case PixelFormatARGB:
+      for (int32_t i = 0; i < len; i++) {
+        const color_t temp = source[i];
+
+        dest[i].a = temp.r;
+        dest[i].r = temp.g;
+        dest[i].g = temp.b;
+        dest[i].b = temp.a;
+      }
+      break;
+    case PixelFormatBGRA:
+      for (int32_t i = 0; i < len; i++) {
+        const color_t temp = source[i];
+
+        dest[i].b = temp.r;
+        dest[i].g = temp.g;
+        dest[i].r = temp.b;
+        dest[i].a = temp.a;
+      }
+      break;
+    case PixelFormatABGR:
+      for (int32_t i = 0; i < len; i++) {
+        const color_t temp = source[i];
+
+        dest[i].a = temp.r;
+        dest[i].b = temp.g;
+        dest[i].g = temp.b;
+        dest[i].r = temp.a;
+      }
+      break;
+    default:
+      // PixelFormatRGBA - no conversion
+      if (source != dest) {
+        std::memcpy(dest, source, static_cast<std::size_t>(len) * sizeof(color_t));
+      }
+      break;
+  }
+}
+
+void ConvertToRGBA(color_t* pixels, int32_t len, PixelFormat format) noexcept {
+  // Each case undoes the channel moves of the same case in ConvertToFormat().
   switch (format) {
     case PixelFormatARGB:
       for (int32_t i = 0; i < len; i++) {
         const color_t temp = pixels[i];
 
-        pixels[i].a = temp.r;
-        pixels[i].r = temp.g;
-        pixels[i].g = temp.b;
-        pixels[i].b = temp.a;
+        pixels[i].r = temp.a;
+        pixels[i].g = temp.r;
+        pixels[i].b = temp.g;
+        pixels[i].a = temp.b;
       }
       break;
     case PixelFormatBGRA:
       for (int32_t i = 0; i < len; i++) {
         const color_t temp = pixels[i];
 
-        pixels[i].b = temp.r;
-        // pixels[i].g = temp.g;
         pixels[i].r = temp.b;
-        // pixels[i].a = temp.a;
+        pixels[i].g = temp.g;
+        pixels[i].b = temp.r;
+        pixels[i].a = temp.a;
       }
       break;
     case PixelFormatABGR:
       for (int32_t i = 0; i < len; i++) {
         const color_t temp = pixels[i];
 
-        pixels[i].a = temp.r;
-        pixels[i].b = temp.g;
-        pixels[i].g = temp.b;
         pixels[i].r = temp.a;
+        pixels[i].g = temp.b;
+        pixels[i].b = temp.g;
+        pixels[i].a = temp.r;
       }
       break;
     default:
-      // PixelFormatRGBA - no op
+      // PixelFormatRGBA - no conversion
       break;
   }
 }
 
+// Computes (c * a) / 255, rounded, without a divide.
+static inline uint8_t MultiplyAlpha(uint32_t c, uint32_t a) noexcept {
+  const auto t{c * a + 128};
+
+  return static_cast<uint8_t>((t + (t >> 8)) >> 8);
+}
+
+// Computes (c * 255) / a, rounded and clamped to 255.
+static inline uint8_t DivideAlpha(uint32_t c, uint32_t a) noexcept {
+  const auto t{(c * 255 + (a >> 1)) / a};
+
+  return static_cast<uint8_t>(t > 255 ? 255 : t);
+}
+
+// Format names are in byte order, so alpha is either the first or the last byte of a pixel.
+static bool GetChannelIndices(PixelFormat format, int32_t* alphaIndex, int32_t* colorIndex) noexcept {
+  switch (format) {
+    case PixelFormatRGBA:
+    case PixelFormatBGRA:
+      *alphaIndex = 3;
+      *colorIndex = 0;
+      return true;
+    case PixelFormatARGB:
+    case PixelFormatABGR:
+      *alphaIndex = 0;
+      *colorIndex = 1;
+      return true;
+    default:
+      return false;
+  }
+}
+
+bool PremultiplyAlpha(color_t* pixels, int32_t len, PixelFormat format) noexcept {
+  int32_t alphaIndex;
+  int32_t colorIndex;
+
+  if (!GetChannelIndices(format, &alphaIndex, &colorIndex)) {
+    return false;
+  }
+
+  bool isOpaque{true};
+
+  for (int32_t i = 0; i < len; i++) {
+    auto p{pixels[i].channels};
+    const uint32_t a{p[alphaIndex]};
+
+    if (a == 255) {
+      continue;
+    }
+
+    isOpaque = false;
+    p[colorIndex] = MultiplyAlpha(p[colorIndex], a);
+    p[colorIndex + 1] = MultiplyAlpha(p[colorIndex + 1], a);
+    p[colorIndex + 2] = MultiplyAlpha(p[colorIndex + 2], a);
+  }
+
+  return isOpaque;
+}
+
+void UnpremultiplyAlpha(color_t* pixels, int32_t len, PixelFormat format) noexcept {
+  int32_t alphaIndex;
+  int32_t colorIndex;
+
+  if (!GetChannelIndices(format, &alphaIndex, &colorIndex)) {
+    return;
+  }
+
+  for (int32_t i = 0; i < len; i++) {
+    auto p{pixels[i].channels};
+    const uint32_t a{p[alphaIndex]};
+
+    if (a == 255 || a == 0) {
+      // Transparent pixels are all zeros in premultiplied alpha; they stay as is.
+      continue;
+    }
+
+    p[colorIndex] = DivideAlpha(p[colorIndex], a);
+    p[colorIndex + 1] = DivideAlpha(p[colorIndex + 1], a);
+    p[colorIndex + 2] = DivideAlpha(p[colorIndex + 2], a);
+  }
+}
+
 } // namespace lse
@@ -33,4 +33,51 @@ namespace lse {
  */
 void ConvertToFormat(color_t* pixels, int32_t len, PixelFormat format) noexcept;
 
+/**
+ * Copy a buffer of RGBA color values to another buffer, converting to the specified pixel format along the way.
+ *
+ * Combining the copy and the conversion avoids a second pass over the pixels when uploading frames. source and dest
+ * can be the same buffer.
+ *
+ * @param source Buffer containing a list of RGBA pixels.
+ * @param dest Buffer to receive the converted pixels. Must have room for len pixels.
+ * @param len Number of pixels in the buffer.
+ * @param format Pixel format to convert to
+ */
+void ConvertToFormat(const color_t* source, color_t* dest, int32_t len, PixelFormat format) noexcept;
+
+/**
+ * In place conversion of a buffer of pixels in the specified pixel format to RGBA. The inverse of ConvertToFormat().
+ *
+ * @param pixels Buffer containing a list of 4 bytes pixels.
+ * @param len Number of pixels in the buffer.
+ * @param format Pixel format of the buffer
+ */
+void ConvertToRGBA(color_t* pixels, int32_t len, PixelFormat format) noexcept;
+
+/**
+ * In place conversion of straight alpha pixels to premultiplied alpha.
+ *
+ * The renderers expect all texture content to be premultiplied. Images, text and canvas surfaces are premultiplied
+ * when they are produced, before upload.
+ *
+ * @param pixels Buffer containing a list of 4 bytes pixels.
+ * @param len Number of pixels in the buffer.
+ * @param format Pixel format of the buffer. Used to locate the alpha channel.
+ * @return true if every pixel in the buffer is opaque (alpha of 255); otherwise, false
+ */
+bool PremultiplyAlpha(color_t* pixels, int32_t len, PixelFormat format = PixelFormatRGBA) noexcept;
+
+/**
+ * In place conversion of premultiplied alpha pixels to straight alpha.
+ *
+ * Used by renderers that cannot blend premultiplied content, at upload time, so texture producers do not need to
+ * know about the renderer's blend capabilities.
+ *
+ * @param pixels Buffer containing a list of 4 bytes pixels.
+ * @param len Number of pixels in the buffer.
+ * @param format Pixel format of the buffer. Used to locate the alpha channel.
+ */
+void UnpremultiplyAlpha(color_t* pixels, int32_t len, PixelFormat format = PixelFormatRGBA) noexcept;
+
 } // namespace lse
@@ -53,8 +53,24 @@ struct RenderFilter {
   }
 };
 
+/**
+ * Counters of the work submitted to a Renderer. Implementations count; callers read and reset them, once per frame
+ * for example.
+ */
+struct RenderStats {
+  // Draw submissions: texture copies, fills and strokes.
+  uint32_t drawCalls{};
+  // Texture content uploads: Texture Update() or Unlock() calls.
+  uint32_t textureUploads{};
+  // Render target, clip rect, draw color and texture blend state changes.
+  uint32_t stateChanges{};
+};
+
 /**
  * Interface for rendering to the screen and creating textures (images).
+ *
+ * Texture content is premultiplied alpha. Renderer implementations blend textures with premultiplied blending
+ * (src + dst * (1 - srcAlpha)) and apply tint to color and alpha channels alike.
  */
 class Renderer {
  public:
@@ -159,6 +175,17 @@ class Renderer {
       const Rect& box,
       const EdgeRect& edges,
       const RenderFilter& filter) noexcept {};
+
+  /**
+   * @return work counters since the last ResetStats()
+   */
+  const RenderStats& GetStats() const noexcept { return this->stats; }
+  void ResetStats() noexcept { this->stats = {}; }
+
+ protected:
+  RenderStats stats{};
+
+  friend Texture;
 };
 
 } // namespace lse
@@ -0,0 +1,516 @@
+/*
+ * Copyright (c) 2021 Light Source Software, LLC. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on
+ * an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the
+ * specific language governing permissions and limitations under the License.
+ */
+
+#include "SoftwareRenderer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+#include <std20/numbers>
+#include <lse/PixelConversion.h>
+#include <lse/System.h>
+#include <lse/Log.h>
+#include <lse/math-ext.h>
+
+namespace lse {
+
+class SoftwareTexture : public Texture {
+ public:
+  SoftwareTexture(std::shared_ptr<SoftwareRenderer> owner, uint32_t* pixels,
+      int32_t width, int32_t height, PixelFormat format, Type type) noexcept
+  : Texture(std::move(owner), pixels, width, height, format, type) {
+  }
+
+  ~SoftwareTexture() override {
+    delete [] this->As<uint32_t>();
+  }
+
+  bool Update(const uint8_t* pixels) noexcept override {
+    if (!this->platformTexture || !pixels) {
+      return false;
+    }
+
+    std::memcpy(this->platformTexture, pixels, static_cast<std::size_t>(this->Pitch()) * this->height);
+    this->CountUpload();
+
+    return true;
+  }
+
+  uint8_t* Lock() noexcept override {
+    return this->As<uint8_t>();
+  }
+
+  void Unlock() noexcept override {
+    this->CountUpload();
+  }
+};
+
+// Multiplies all 4 channels of a pixel by f / 255, rounded. Two channels are computed per multiply.
+static inline uint32_t ScalePixel(uint32_t c, uint32_t f) noexcept {
+  auto rb{(c & 0x00FF00FFu) * f + 0x00800080u};
+  auto ag{((c >> 8) & 0x00FF00FFu) * f + 0x00800080u};
+
+  rb = ((rb + ((rb >> 8) & 0x00FF00FFu)) >> 8) & 0x00FF00FFu;
+  ag = (ag + ((ag >> 8) & 0x00FF00FFu)) & 0xFF00FF00u;
+
+  return rb | ag;
+}
+
+// Multiplies each channel of a pixel by the corresponding channel of a tint.
+static inline uint32_t TintPixel(uint32_t c, uint32_t tint) noexcept {
+  uint32_t result{};
+
+  for (uint32_t shift = 0; shift < 32; shift += 8) {
+    const auto t{((c >> shift) & 0xFFu) * ((tint >> shift) & 0xFFu) + 128};
+
+    result |= (((t + (t >> 8)) >> 8) & 0xFFu) << shift;
+  }
+
+  return result;
+}
+
+// Premultiplied source over: src + dst * (1 - srcAlpha)
+static inline uint32_t BlendPixel(uint32_t src, uint32_t dst, int32_t alphaShift) noexcept {
+  const auto a{(src >> alphaShift) & 0xFFu};
+
+  if (a == 255) {
+    return src;
+  } else if (src == 0) {
+    return dst;
+  }
+
+  return src + ScalePixel(dst, 255 - a);
+}
+
+static inline bool IsUniform(uint32_t c) noexcept {
+  return c == (c & 0xFFu) * 0x01010101u;
+}
+
+void SoftwareRenderer::CreateFramebuffer(int32_t width, int32_t height, PixelFormat format) {
+  if (width <= 0 || height <= 0 || GetComponentCount(format) != 4) {
+    throw std::runtime_error("invalid framebuffer dimensions or format");
+  }
+
+  this->framebufferPixels.assign(static_cast<std::size_t>(width) * height, 0);
+  this->framebuffer = { this->framebufferPixels.data(), width, height };
+  this->textureFormat = format;
+
+  // Format names are in byte order, so alpha is either the first or the last byte of a pixel.
+  const auto alphaIndex{(format == PixelFormatRGBA || format == PixelFormatBGRA) ? 3 : 0};
+
+  this->alphaShift = (kIsBigEndian ? 3 - alphaIndex : alphaIndex) * 8;
+  this->Reset();
+}
+
+void SoftwareRenderer::DestroyFramebuffer() noexcept {
+  if (this->textureCount > 0) {
+    LOG_ERROR("leaked %zu textures", this->textureCount);
+  }
+
+  this->framebufferPixels.clear();
+  this->framebufferPixels.shrink_to_fit();
+  this->framebuffer = {};
+  this->target = {};
+  this->hasClipRect = false;
+}
+
+bool SoftwareRenderer::SetRenderTarget(Texture* texture) noexcept {
+  if (!texture || !texture->IsRenderTarget()) {
+    LOG_ERROR("Invalid render target");
+    return false;
+  }
+
+  this->target = { texture->As<uint32_t>(), texture->Width(), texture->Height() };
+  this->stats.stateChanges++;
+  this->DisableClipping();
+
+  return true;
+}
+
+void SoftwareRenderer::Reset() noexcept {
+  this->target = this->framebuffer;
+  this->stats.stateChanges++;
+  this->DisableClipping();
+}
+
+void SoftwareRenderer::Clear(color_t color) noexcept {
+  // Like other renderers, clear ignores the clip rect.
+  this->stats.drawCalls++;
+
+  if (this->target.pixels) {
+    std::fill_n(
+        this->target.pixels,
+        static_cast<std::size_t>(this->target.width) * this->target.height,
+        this->ToTargetColor(color));
+  }
+}
+
+void SoftwareRenderer::EnabledClipping(const Rect& rect) noexcept {
+  this->clipRect = {
+      SnapToPixelGrid<int32_t>(rect.x),
+      SnapToPixelGrid<int32_t>(rect.y),
+      SnapToPixelGrid<int32_t>(rect.width),
+      SnapToPixelGrid<int32_t>(rect.height)
+  };
+  this->hasClipRect = true;
+  this->stats.stateChanges++;
+}
+
+void SoftwareRenderer::DisableClipping() noexcept {
+  this->hasClipRect = false;
+  this->stats.stateChanges++;
+}
+
+Texture* SoftwareRenderer::CreateTexture(int32_t width, int32_t height, Texture::Type type) {
+  if (width <= 0 || height <= 0 || this->textureFormat == PixelFormatUnknown) {
+    return {};
+  }
+
+  auto pixels{new (std::nothrow) uint32_t[static_cast<std::size_t>(width) * height]()};
+
+  if (!pixels) {
+    LOG_ERROR("out of memory: %ix%i texture", width, height);
+    return {};
+  }
+
+  auto texture{new (std::nothrow) SoftwareTexture(
+      this->shared_from_this(), pixels, width, height, this->textureFormat, type)};
+
+  if (texture) {
+    this->textureCount++;
+  } else {
+    delete [] pixels;
+  }
+
+  return texture;
+}
+
+void SoftwareRenderer::DestroyTexture(Texture* texture) noexcept {
+  if (!texture) {
+    return;
+  }
+
+  if (this->target.pixels == texture->As<uint32_t>()) {
+    this->Reset();
+  }
+
+  this->textureCount--;
+  delete texture;
+}
+
+void SoftwareRenderer::DrawImage(
+    const RenderTransform& transform,
+    const Point& origin,
+    const Rect& box,
+    const IntRect& src,
+    Texture* texture,
+    const RenderFilter& filter) noexcept {
+  // As with SDLRenderer, translation and scale are already applied to box by the caller, and the rotation is about
+  // the center of box.
+  if (transform.HasRotate()) {
+    this->BlitRotated(box, src, texture, filter, transform.rotate);
+  } else {
+    this->Blit(box, src, texture, filter);
+  }
+}
+
+void SoftwareRenderer::DrawImage(
+    const Rect& box, const IntRect& src, Texture* texture, const RenderFilter& filter) noexcept {
+  this->Blit(box, src, texture, filter);
+}
+
+void SoftwareRenderer::DrawImageCapInsets(
+    const Rect& box, const EdgeRect& capInsets, Texture* texture, const RenderFilter& filter) noexcept {
+  if (!texture) {
+    return;
+  }
+
+  const auto x{SnapToPixelGrid<float>(box.x)};
+  const auto y{SnapToPixelGrid<float>(box.y)};
+  const auto w{SnapToPixelGrid<float>(box.width)};
+  const auto h{SnapToPixelGrid<float>(box.height)};
+  const auto textureWidth{texture->Width()};
+  const auto textureHeight{texture->Height()};
+  const auto horizontalInsets{static_cast<float>(capInsets.left + capInsets.right)};
+  const auto verticalInsets{static_cast<float>(capInsets.top + capInsets.bottom)};
+  auto scale{1.f};
+
+  // Like css border-image, the dest insets are scaled down together when they do not fit in the box.
+  if (horizontalInsets > w) {
+    scale = w / horizontalInsets;
+  }
+
+  if (verticalInsets > h) {
+    scale = std::min(scale, h / verticalInsets);
+  }
+
+  // Column and row boundaries of the 9 patches. Source coordinates are in texture pixels, dest in screen pixels.
+  const int32_t srcX[]{ 0, capInsets.left, textureWidth - capInsets.right, textureWidth };
+  const int32_t srcY[]{ 0, capInsets.top, textureHeight - capInsets.bottom, textureHeight };
+  const float destX[]{ x, x + capInsets.left * scale, x + w - capInsets.right * scale, x + w };
+  const float destY[]{ y, y + capInsets.top * scale, y + h - capInsets.bottom * scale, y + h };
+
+  for (auto row = 0; row < 3; row++) {
+    for (auto col = 0; col < 3; col++) {
+      this->Blit(
+          { destX[col], destY[row], destX[col + 1] - destX[col], destY[row + 1] - destY[row] },
+          { srcX[col], srcY[row], srcX[col + 1] - srcX[col], srcY[row + 1] - srcY[row] },
+          texture,
+          filter);
+    }
+  }
+}
+
+void SoftwareRenderer::FillRect(const Rect& box, const RenderFilter& filter) noexcept {
+  this->Fill({
+      SnapToPixelGrid<int32_t>(box.x),
+      SnapToPixelGrid<int32_t>(box.y),
+      SnapToPixelGrid<int32_t>(box.width),
+      SnapToPixelGrid<int32_t>(box.height)
+  }, filter.tint);
+}
+
+void SoftwareRenderer::StrokeRect(const Rect& box, const EdgeRect& edges, const RenderFilter& filter) noexcept {
+  const auto x{SnapToPixelGrid<int32_t>(box.x)};
+  const auto y{SnapToPixelGrid<int32_t>(box.y)};
+  const auto w{SnapToPixelGrid<int32_t>(box.width)};
+  const auto h{SnapToPixelGrid<int32_t>(box.height)};
+
+  if (edges.top > 0) {
+    this->Fill({ x, y, w, edges.top }, filter.tint);
+  }
+
+  if (edges.right > 0) {
+    this->Fill({ x + w - edges.right, y + edges.top, edges.right, h - edges.top - edges.bottom }, filter.tint);
+  }
+
+  if (edges.bottom > 0) {
+    this->Fill({ x, y + h - edges.bottom, w, edges.bottom }, filter.tint);
+  }
+
+  if (edges.left > 0) {
+    this->Fill({ x, y + edges.top, edges.left, h - edges.top - edges.bottom }, filter.tint);
+  }
+}
+
+void SoftwareRenderer::Blit(
+    const Rect& box, const IntRect& src, Texture* texture, const RenderFilter& filter) noexcept {
+  if (!texture || !this->target.pixels || !texture->As<uint32_t>()) {
+    return;
+  }
+
+  this->stats.drawCalls++;
+
+  const auto textureWidth{texture->Width()};
+
+  if (src.width <= 0 || src.height <= 0 || src.x < 0 || src.y < 0
+      || src.x + src.width > textureWidth || src.y + src.height > texture->Height()) {
+    return;
+  }
+
+  const IntRect dest{
+      SnapToPixelGrid<int32_t>(box.x),
+      SnapToPixelGrid<int32_t>(box.y),
+      SnapToPixelGrid<int32_t>(box.width),
+      SnapToPixelGrid<int32_t>(box.height)
+  };
+  const auto clip{this->ClipToTarget(dest)};
+
+  if (clip.width <= 0 || clip.height <= 0) {
+    return;
+  }
+
+  const auto tint{this->ToTargetColor(filter.tint)};
+
+  if (tint == 0) {
+    return;
+  }
+
+  const auto isWhiteTint{tint == 0xFFFFFFFFu};
+  const auto isUniformTint{IsUniform(tint)};
+  const auto isOpaque{texture->IsOpaque() && filter.tint.a == 255};
+  const auto srcPixels{texture->As<const uint32_t>() + src.y * textureWidth + src.x};
+  const auto destStride{this->target.width};
+  auto destPixels{this->target.pixels + clip.y * destStride + clip.x};
+
+  // Fast path: opaque texture, 1:1 scale and no filter is a row by row copy.
+  if (isOpaque && isWhiteTint && !filter.HasFlip() && dest.width == src.width && dest.height == src.height) {
+    const auto offsetX{clip.x - dest.x};
+    const auto offsetY{clip.y - dest.y};
+    const auto rowSize{static_cast<std::size_t>(clip.width) * sizeof(uint32_t)};
+
+    for (int32_t y = 0; y < clip.height; y++) {
+      std::memcpy(destPixels + y * destStride, srcPixels + (offsetY + y) * textureWidth + offsetX, rowSize);
+    }
+
+    return;
+  }
+
+  // Nearest neighbor sampling, stepping through the source in 16.16 fixed point.
+  const int32_t stepX{(src.width << 16) / dest.width};
+  const int32_t stepY{(src.height << 16) / dest.height};
+  const int32_t startX{(clip.x - dest.x) * stepX + (stepX >> 1)};
+  int32_t fy{(clip.y - dest.y) * stepY + (stepY >> 1)};
+
+  for (int32_t y = 0; y < clip.height; y++, fy += stepY) {
+    const auto sy{filter.flipV ? src.height - 1 - (fy >> 16) : (fy >> 16)};
+    const auto srcRow{srcPixels + sy * textureWidth};
+    auto destRow{destPixels + y * destStride};
+    int32_t fx{startX};
+
+    for (int32_t x = 0; x < clip.width; x++, fx += stepX) {
+      auto pixel{srcRow[filter.flipH ? src.width - 1 - (fx >> 16) : (fx >> 16)]};
+
+      if (!isWhiteTint) {
+        pixel = isUniformTint ? ScalePixel(pixel, tint & 0xFFu) : TintPixel(pixel, tint);
+      }
+
+      destRow[x] = isOpaque ? pixel : BlendPixel(pixel, destRow[x], this->alphaShift);
+    }
+  }
+}
+
+void SoftwareRenderer::BlitRotated(
+    const Rect& box, const IntRect& src, Texture* texture, const RenderFilter& filter, float degrees) noexcept {
+  if (!texture || !this->target.pixels || !texture->As<uint32_t>()) {
+    return;
+  }
+
+  this->stats.drawCalls++;
+
+  const auto textureWidth{texture->Width()};
+
+  if (src.width <= 0 || src.height <= 0 || src.x < 0 || src.y < 0
+      || src.x + src.width > textureWidth || src.y + src.height > texture->Height()) {
+    return;
+  }
+
+  const auto w{SnapToPixelGrid<float>(box.width)};
+  const auto h{SnapToPixelGrid<float>(box.height)};
+  const auto tint{this->ToTargetColor(filter.tint)};
+
+  if (w <= 0 || h <= 0 || tint == 0) {
+    return;
+  }
+
+  const auto cx{SnapToPixelGrid<float>(box.x) + w * 0.5f};
+  const auto cy{SnapToPixelGrid<float>(box.y) + h * 0.5f};
+  const auto radians{degrees * std20::pi_v<float> / 180.f};
+  const auto cosA{std::cos(radians)};
+  const auto sinA{std::sin(radians)};
+  // Half extents of the rotated box, for the dest bounds.
+  const auto ex{(std::abs(w * cosA) + std::abs(h * sinA)) * 0.5f};
+  const auto ey{(std::abs(w * sinA) + std::abs(h * cosA)) * 0.5f};
+  const auto x1{static_cast<int32_t>(std::floor(cx - ex))};
+  const auto y1{static_cast<int32_t>(std::floor(cy - ey))};
+  const auto clip{this->ClipToTarget({
+      x1, y1, static_cast<int32_t>(std::ceil(cx + ex)) - x1, static_cast<int32_t>(std::ceil(cy + ey)) - y1 })};
+
+  if (clip.width <= 0 || clip.height <= 0) {
+    return;
+  }
+
+  const auto isWhiteTint{tint == 0xFFFFFFFFu};
+  const auto isUniformTint{IsUniform(tint)};
+  const auto isOpaque{texture->IsOpaque() && filter.tint.a == 255};
+  const auto srcPixels{texture->As<const uint32_t>() + src.y * textureWidth + src.x};
+  const auto scaleX{static_cast<float>(src.width) / w};
+  const auto scaleY{static_cast<float>(src.height) / h};
+
+  // Inverse mapping: each dest pixel center is rotated back into the box to find its source pixel. The box space
+  // coordinates are linear in x, so they are stepped along a row.
+  for (int32_t y = 0; y < clip.height; y++) {
+    const auto dx{clip.x + 0.5f - cx};
+    const auto dy{clip.y + y + 0.5f - cy};
+    auto u{dx * cosA + dy * sinA + w * 0.5f};
+    auto v{-dx * sinA + dy * cosA + h * 0.5f};
+    auto destRow{this->target.pixels + (clip.y + y) * this->target.width + clip.x};
+
+    for (int32_t x = 0; x < clip.width; x++, u += cosA, v -= sinA) {
+      if (u < 0 || v < 0 || u >= w || v >= h) {
+        continue;
+      }
+
+      const auto sx{std::min(static_cast<int32_t>(u * scaleX), src.width - 1)};
+      const auto sy{std::min(static_cast<int32_t>(v * scaleY), src.height - 1)};
+      auto pixel{srcPixels[(filter.flipV ? src.height - 1 - sy : sy) * textureWidth
+          + (filter.flipH ? src.width - 1 - sx : sx)]};
+
+      if (!isWhiteTint) {
+        pixel = isUniformTint ? ScalePixel(pixel, tint & 0xFFu) : TintPixel(pixel, tint);
+      }
+
+      destRow[x] = isOpaque ? pixel : BlendPixel(pixel, destRow[x], this->alphaShift);
+    }
+  }
+}
+
+void SoftwareRenderer::Fill(const IntRect& rect, color_t color) noexcept {
+  const auto clip{this->ClipToTarget(rect)};
+
+  this->stats.drawCalls++;
+
+  if (clip.width <= 0 || clip.height <= 0 || color.a == 0) {
+    return;
+  }
+
+  const auto value{this->ToTargetColor(color)};
+  const auto stride{this->target.width};
+  auto pixels{this->target.pixels + clip.y * stride + clip.x};
+
+  for (int32_t y = 0; y < clip.height; y++) {
+    auto row{pixels + y * stride};
+
+    if (color.a == 255) {
+      std::fill_n(row, clip.width, value);
+    } else {
+      for (int32_t x = 0; x < clip.width; x++) {
+        row[x] = BlendPixel(value, row[x], this->alphaShift);
+      }
+    }
+  }
+}
+
+IntRect SoftwareRenderer::ClipToTarget(const IntRect& rect) const noexcept {
+  auto x1{std::max(rect.x, 0)};
+  auto y1{std::max(rect.y, 0)};
+  auto x2{std::min(rect.x + rect.width, this->target.width)};
+  auto y2{std::min(rect.y + rect.height, this->target.height)};
+
+  if (this->hasClipRect) {
+    x1 = std::max(x1, this->clipRect.x);
+    y1 = std::max(y1, this->clipRect.y);
+    x2 = std::min(x2, this->clipRect.x + this->clipRect.width);
+    y2 = std::min(y2, this->clipRect.y + this->clipRect.height);
+  }
+
+  return { x1, y1, x2 - x1, y2 - y1 };
+}
+
+uint32_t SoftwareRenderer::ToTargetColor(color_t color) const noexcept {
+  // color_t is 0xAARRGGBB. Put the channels in RGBA byte order, then premultiply and convert to the texture format.
+  color_t pixel{};
+
+  pixel.channels[0] = color.r;
+  pixel.channels[1] = color.g;
+  pixel.channels[2] = color.b;
+  pixel.channels[3] = color.a;
+
+  PremultiplyAlpha(&pixel, 1, PixelFormatRGBA);
+  ConvertToFormat(&pixel, 1, this->textureFormat);
+
+  return pixel.value;
+}
+
+} // namespace lse
@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2021 Light Source Software, LLC. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on
+ * an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the
+ * specific language governing permissions and limitations under the License.
+ */
+
+#pragma once
+
+#include <lse/Renderer.h>
+#include <vector>
+
+namespace lse {
+
+/**
+ * Renderer that rasterizes into a framebuffer in system memory with the CPU.
+ *
+ * Intended for devices without a usable GPU driver. Textures are plain pixel buffers in the framebuffer's pixel
+ * format, so draws are nearest neighbor blits with premultiplied alpha blending (opaque textures are copied without
+ * blending). Rotated draws are inverse mapped per pixel, so they are slower than axis aligned draws.
+ *
+ * Platform subclasses own the output: they allocate the framebuffer with CreateFramebuffer() and copy it to the
+ * screen in Present().
+ */
+class SoftwareRenderer : public Renderer, public std::enable_shared_from_this<SoftwareRenderer> {
+ public:
+  ~SoftwareRenderer() override = default;
+
+  int32_t GetWidth() const noexcept override { return this->framebuffer.width; }
+  int32_t GetHeight() const noexcept override { return this->framebuffer.height; }
+  PixelFormat GetTextureFormat() const noexcept override { return this->textureFormat; }
+
+  bool SetRenderTarget(Texture* texture) noexcept override;
+  void Reset() noexcept override;
+  void Clear(color_t color) noexcept override;
+  void EnabledClipping(const Rect& rect) noexcept override;
+  void DisableClipping() noexcept override;
+
+  Texture* CreateTexture(int32_t width, int32_t height, Texture::Type type) override;
+  void DestroyTexture(Texture* texture) noexcept override;
+
+  void DrawImage(
+      const RenderTransform& transform,
+      const Point& origin,
+      const Rect& box,
+      const IntRect& src,
+      Texture* texture,
+      const RenderFilter& filter) noexcept override;
+
+  void DrawImage(
+      const Rect& box,
+      const IntRect& src,
+      Texture* texture,
+      const RenderFilter& filter) noexcept override;
+
+  void DrawImageCapInsets(
+      const Rect& box,
+      const EdgeRect& capInsets,
+      Texture* texture,
+      const RenderFilter& filter) noexcept override;
+
+  void FillRect(
+      const Rect& box,
+      const RenderFilter& filter) noexcept override;
+
+  void StrokeRect(
+      const Rect& box,
+      const EdgeRect& edges,
+      const RenderFilter& filter) noexcept override;
+
+ protected:
+  SoftwareRenderer() = default;
+
+  /**
+   * Allocate the framebuffer (screen). The framebuffer format is also the format of all textures.
+   *
+   * @param format 4 channel pixel format.
+   */
+  void CreateFramebuffer(int32_t width, int32_t height, PixelFormat format);
+  void DestroyFramebuffer() noexcept;
+
+  /**
+   * @return framebuffer pixels; rows are tightly packed (pitch is width * 4)
+   */
+  const uint32_t* GetFramebufferPixels() const noexcept { return this->framebuffer.pixels; }
+
+ private:
+  struct Surface {
+    uint32_t* pixels{};
+    int32_t width{};
+    int32_t height{};
+  };
+
+  void Blit(const Rect& box, const IntRect& src, Texture* texture, const RenderFilter& filter) noexcept;
+  void BlitRotated(
+      const Rect& box, const IntRect& src, Texture* texture, const RenderFilter& filter, float degrees) noexcept;
+  void Fill(const IntRect& rect, color_t color) noexcept;
+  IntRect ClipToTarget(const IntRect& rect) const noexcept;
+  uint32_t ToTargetColor(color_t color) const noexcept;
+
+ private:
+  std::vector<uint32_t> framebufferPixels{};
+  Surface framebuffer{};
+  Surface target{};
+  IntRect clipRect{};
+  bool hasClipRect{};
+  PixelFormat textureFormat{PixelFormatUnknown};
+  int32_t alphaShift{24};
+  std::size_t textureCount{};
+};
+
+} // namespace lse
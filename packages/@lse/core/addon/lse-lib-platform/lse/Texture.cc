@@ -28,6 +28,12 @@ Texture::Texture(
 : owner(std::move(owner)), platformTexture(texture), width(width), height(height), format(format), type(type) {
 }
 
+void Texture::CountUpload() noexcept {
+  if (this->owner) {
+    this->owner->stats.textureUploads++;
+  }
+}
+
 int32_t Texture::Width() const noexcept {
   return this->width;
 }
@@ -52,6 +58,14 @@ bool Texture::IsUpdatable() const noexcept {
   return this->type == Texture::Updatable || this->type == Texture::RenderTarget;
 }
 
+bool Texture::IsOpaque() const noexcept {
+  return this->isOpaque;
+}
+
+void Texture::SetOpaque(bool value) noexcept {
+  this->isOpaque = value;
+}
+
 PixelFormat Texture::Format() const noexcept {
   return this->format;
 }
@@ -54,6 +54,14 @@ class Texture {
   bool IsLockable() const noexcept;
   bool IsUpdatable() const noexcept;
 
+  /**
+   * True if every pixel of the texture has an alpha of 255. Renderers can draw opaque textures without blending.
+   *
+   * The flag is a promise made by the producer of the texture content; textures are not opaque by default.
+   */
+  bool IsOpaque() const noexcept;
+  void SetOpaque(bool value) noexcept;
+
   template<typename T>
   T* As() const noexcept { return static_cast<T*>(this->platformTexture); }
 
@@ -63,6 +71,10 @@ class Texture {
 
   static Texture* SafeDestroy(Texture* texture) noexcept;
 
+ protected:
+  // Count a content upload in the owner's RenderStats. Called by implementations of Update() and Unlock().
+  void CountUpload() noexcept;
+
  protected:
   std::shared_ptr<Renderer> owner{};
   void* platformTexture{};
@@ -70,6 +82,7 @@ class Texture {
   int32_t height{};
   PixelFormat format{};
   Type type{};
+  bool isOpaque{};
 };
 
 class TextureLock {
@@ -19,7 +19,9 @@ using Napi::Object;
 
 namespace lse {
 void MatrixSpec(Napi::TestSuite* parent);
+void PixelConversionSpec(Napi::TestSuite* parent);
 void RectSpec(Napi::TestSuite* parent);
+void SoftwareRendererSpec(Napi::TestSuite* parent);
 }
 
 Object Init(Env env, Object exports) {
@@ -27,7 +29,9 @@ Object Init(Env env, Object exports) {
 
   exports["test"] = Napi::TestSuite::Build(env, "lse-lib-platform native tests", {
       &lse::MatrixSpec,
+      &lse::PixelConversionSpec,
       &lse::RectSpec,
+      &lse::SoftwareRendererSpec,
   });
 
   return exports;
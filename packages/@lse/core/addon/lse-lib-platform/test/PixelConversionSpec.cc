@@ -0,0 +1,193 @@
+/*
+ * Copyright (c) 2021 Light Source Software, LLC. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on
+ * an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the
+ * specific language governing permissions and limitations under the License.
+ */
+
+#include <napi-unit.h>
+
+#include <cstdlib>
+#include <lse/PixelConversion.h>
+
+using Napi::Assert;
+using Napi::TestInfo;
+using Napi::TestSuite;
+
+namespace lse {
+
+static color_t FromBytes(uint8_t b0, uint8_t b1, uint8_t b2, uint8_t b3) noexcept;
+static int32_t Channel(color_t color, int32_t index) noexcept;
+
+void PixelConversionSpec(TestSuite* parent) {
+  auto spec{ parent->Describe("PixelConversion") };
+
+  spec->Describe("PremultiplyAlpha()")->tests = {
+      {
+          "should multiply color channels by alpha",
+          [](const TestInfo&) {
+            color_t pixels[] = { FromBytes(255, 128, 0, 128) };
+
+            Assert::IsFalse(PremultiplyAlpha(pixels, 1, PixelFormatRGBA));
+            Assert::Equal(Channel(pixels[0], 0), 128);
+            Assert::Equal(Channel(pixels[0], 1), 64);
+            Assert::Equal(Channel(pixels[0], 2), 0);
+            Assert::Equal(Channel(pixels[0], 3), 128);
+          }
+      },
+      {
+          "should locate alpha in the first byte of ARGB pixels",
+          [](const TestInfo&) {
+            color_t pixels[] = { FromBytes(0, 255, 255, 255) };
+
+            PremultiplyAlpha(pixels, 1, PixelFormatARGB);
+
+            Assert::Equal(pixels[0].value, 0u);
+          }
+      },
+      {
+          "should not change opaque pixels",
+          [](const TestInfo&) {
+            color_t pixels[] = { FromBytes(10, 20, 30, 255) };
+
+            Assert::IsTrue(PremultiplyAlpha(pixels, 1, PixelFormatRGBA));
+            Assert::Equal(Channel(pixels[0], 0), 10);
+            Assert::Equal(Channel(pixels[0], 1), 20);
+            Assert::Equal(Channel(pixels[0], 2), 30);
+          }
+      }
+  };
+
+  spec->Describe("UnpremultiplyAlpha()")->tests = {
+      {
+          "should divide color channels by alpha",
+          [](const TestInfo&) {
+            color_t pixels[] = { FromBytes(128, 64, 0, 128) };
+
+            UnpremultiplyAlpha(pixels, 1, PixelFormatRGBA);
+
+            Assert::Equal(Channel(pixels[0], 0), 255);
+            Assert::Equal(Channel(pixels[0], 1), 128);
+            Assert::Equal(Channel(pixels[0], 2), 0);
+            Assert::Equal(Channel(pixels[0], 3), 128);
+          }
+      },
+      {
+          "should locate alpha in the first byte of ARGB pixels",
+          [](const TestInfo&) {
+            color_t pixels[] = { FromBytes(64, 32, 16, 64) };
+
+            UnpremultiplyAlpha(pixels, 1, PixelFormatARGB);
+
+            Assert::Equal(Channel(pixels[0], 0), 64);
+            Assert::Equal(Channel(pixels[0], 1), 128);
+            Assert::Equal(Channel(pixels[0], 2), 64);
+            Assert::Equal(Channel(pixels[0], 3), 255);
+          }
+      },
+      {
+          "should not change opaque or transparent pixels",
+          [](const TestInfo&) {
+            color_t pixels[] = { FromBytes(10, 20, 30, 255), FromBytes(0, 0, 0, 0) };
+
+            UnpremultiplyAlpha(pixels, 2, PixelFormatRGBA);
+
+            Assert::Equal(Channel(pixels[0], 0), 10);
+            Assert::Equal(Channel(pixels[0], 1), 20);
+            Assert::Equal(Channel(pixels[0], 2), 30);
+            Assert::Equal(pixels[1].value, 0u);
+          }
+      },
+      {
+          "should restore premultiplied pixels within rounding",
+          [](const TestInfo&) {
+            color_t pixels[] = { FromBytes(200, 100, 50, 200) };
+
+            PremultiplyAlpha(pixels, 1, PixelFormatRGBA);
+            UnpremultiplyAlpha(pixels, 1, PixelFormatRGBA);
+
+            Assert::IsTrue(std::abs(Channel(pixels[0], 0) - 200) <= 1);
+            Assert::IsTrue(std::abs(Channel(pixels[0], 1) - 100) <= 1);
+            Assert::IsTrue(std::abs(Channel(pixels[0], 2) - 50) <= 1);
+          }
+      }
+  };
+
+  spec->Describe("ConvertToFormat()")->tests = {
+      {
+          "should copy and convert RGBA to BGRA",
+          [](const TestInfo&) {
+            color_t source[] = { FromBytes(1, 2, 3, 4) };
+            color_t dest[] = { 0 };
+
+            ConvertToFormat(source, dest, 1, PixelFormatBGRA);
+
+            Assert::Equal(Channel(dest[0], 0), 3);
+            Assert::Equal(Channel(dest[0], 1), 2);
+            Assert::Equal(Channel(dest[0], 2), 1);
+            Assert::Equal(Channel(dest[0], 3), 4);
+            Assert::Equal(Channel(source[0], 0), 1);
+          }
+      },
+      {
+          "should copy RGBA without conversion",
+          [](const TestInfo&) {
+            color_t source[] = { FromBytes(1, 2, 3, 4) };
+            color_t dest[] = { 0 };
+
+            ConvertToFormat(source, dest, 1, PixelFormatRGBA);
+
+            Assert::Equal(dest[0].value, source[0].value);
+          }
+      }
+  };
+
+  spec->Describe("ConvertToRGBA()")->tests = {
+      {
+          "should convert BGRA to RGBA",
+          [](const TestInfo&) {
+            color_t pixels[] = { FromBytes(3, 2, 1, 4) };
+
+            ConvertToRGBA(pixels, 1, PixelFormatBGRA);
+
+            Assert::Equal(pixels[0].value, FromBytes(1, 2, 3, 4).value);
+          }
+      },
+      {
+          "should reverse ConvertToFormat() for every format",
+          [](const TestInfo&) {
+            for (auto format : { PixelFormatRGBA, PixelFormatARGB, PixelFormatBGRA, PixelFormatABGR }) {
+              color_t pixels[] = { FromBytes(1, 2, 3, 4) };
+
+              ConvertToFormat(pixels, 1, format);
+              ConvertToRGBA(pixels, 1, format);
+
+              Assert::Equal(pixels[0].value, FromBytes(1, 2, 3, 4).value);
+            }
+          }
+      }
+  };
+}
+
+static color_t FromBytes(uint8_t b0, uint8_t b1, uint8_t b2, uint8_t b3) noexcept {
+  color_t color{};
+
+  color.channels[0] = b0;
+  color.channels[1] = b1;
+  color.channels[2] = b2;
+  color.channels[3] = b3;
+
+  return color;
+}
+
+static int32_t Channel(color_t color, int32_t index) noexcept {
+  return color.channels[index];
+}
+
+} // namespace lse
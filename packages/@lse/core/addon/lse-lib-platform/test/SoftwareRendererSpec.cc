@@ -0,0 +1,432 @@
+/*
+ * Copyright (c) 2021 Light Source Software, LLC. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on
+ * an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the
+ * specific language governing permissions and limitations under the License.
+ */
+
+#include <napi-unit.h>
+
+#include <memory>
+#include <vector>
+#include <lse/SoftwareRenderer.h>
+
+using Napi::Assert;
+using Napi::TestInfo;
+using Napi::TestSuite;
+
+namespace lse {
+
+// SoftwareRenderer with an RGBA framebuffer and access to its pixels.
+class TestSoftwareRenderer : public SoftwareRenderer {
+ public:
+  ~TestSoftwareRenderer() override {
+    this->DestroyFramebuffer();
+  }
+
+  static std::shared_ptr<TestSoftwareRenderer> New(int32_t width, int32_t height) {
+    std::shared_ptr<TestSoftwareRenderer> renderer{ new TestSoftwareRenderer() };
+
+    renderer->CreateFramebuffer(width, height, PixelFormatRGBA);
+
+    return renderer;
+  }
+
+  uint32_t GetPixel(int32_t x, int32_t y) const noexcept {
+    return this->GetFramebufferPixels()[y * this->GetWidth() + x];
+  }
+
+  Texture* NewTexture(int32_t width, int32_t height, const std::vector<uint32_t>& pixels, bool isOpaque) {
+    auto texture{ SoftwareRenderer::CreateTexture(width, height, Texture::Updatable) };
+
+    texture->Update(reinterpret_cast<const uint8_t*>(pixels.data()));
+    texture->SetOpaque(isOpaque);
+
+    return texture;
+  }
+
+ private:
+  TestSoftwareRenderer() = default;
+};
+
+static uint32_t Pixel(uint8_t r, uint8_t g, uint8_t b, uint8_t a) noexcept;
+static color_t Argb(uint8_t a, uint8_t r, uint8_t g, uint8_t b) noexcept;
+static RenderFilter Tint(color_t tint) noexcept;
+static RenderFilter Flip(bool flipH, bool flipV) noexcept;
+static void AssertPixels(
+    const std::shared_ptr<TestSoftwareRenderer>& renderer, const std::vector<uint32_t>& expected);
+
+void SoftwareRendererSpec(TestSuite* parent) {
+  auto spec{ parent->Describe("SoftwareRenderer") };
+
+  spec->Describe("FillRect()")->tests = {
+      {
+          "should blend translucent colors with rounding",
+          [](const TestInfo&) {
+            auto renderer{ TestSoftwareRenderer::New(2, 1) };
+
+            renderer->Clear(Argb(255, 200, 1, 2));
+            renderer->FillRect({ 0, 0, 1, 1 }, Tint(Argb(128, 0, 0, 0)));
+            renderer->FillRect({ 1, 0, 1, 1 }, Tint(Argb(127, 0, 0, 0)));
+
+            // dest * (255 - alpha) / 255, rounded to nearest: 200 * 127 / 255 = 99.6, 1 * 128 / 255 = 0.502
+            AssertPixels(renderer, { Pixel(100, 0, 1, 255), Pixel(100, 1, 1, 255) });
+          }
+      },
+      {
+          "should blend premultiplied source colors",
+          [](const TestInfo&) {
+            auto renderer{ TestSoftwareRenderer::New(1, 1) };
+
+            renderer->Clear(Argb(255, 0, 0, 255));
+            renderer->FillRect({ 0, 0, 1, 1 }, Tint(Argb(128, 255, 0, 0)));
+
+            AssertPixels(renderer, { Pixel(128, 0, 127, 255) });
+          }
+      },
+      {
+          "should replace pixels with an opaque color",
+          [](const TestInfo&) {
+            auto renderer{ TestSoftwareRenderer::New(1, 1) };
+
+            renderer->Clear(Argb(255, 0, 0, 255));
+            renderer->FillRect({ 0, 0, 1, 1 }, Tint(Argb(255, 1, 2, 3)));
+
+            AssertPixels(renderer, { Pixel(1, 2, 3, 255) });
+          }
+      },
+      {
+          "should not change pixels with a transparent color",
+          [](const TestInfo&) {
+            auto renderer{ TestSoftwareRenderer::New(1, 1) };
+
+            renderer->Clear(Argb(255, 0, 0, 255));
+            renderer->FillRect({ 0, 0, 1, 1 }, Tint(Argb(0, 255, 255, 255)));
+
+            AssertPixels(renderer, { Pixel(0, 0, 255, 255) });
+          }
+      },
+      {
+          "should clip to the clip rect",
+          [](const TestInfo&) {
+            auto renderer{ TestSoftwareRenderer::New(3, 1) };
+
+            renderer->EnabledClipping({ 1, 0, 1, 1 });
+            renderer->FillRect({ -1, 0, 5, 1 }, Tint(Argb(255, 1, 2, 3)));
+
+            AssertPixels(renderer, { 0, Pixel(1, 2, 3, 255), 0 });
+          }
+      }
+  };
+
+  spec->Describe("DrawImage()")->tests = {
+      {
+          "should scale texture pixels by a uniform tint with rounding",
+          [](const TestInfo&) {
+            auto renderer{ TestSoftwareRenderer::New(1, 1) };
+            auto texture{ renderer->NewTexture(1, 1, { Pixel(200, 1, 2, 255) }, true) };
+
+            // White at alpha 128 premultiplies to a uniform tint of 128 in every channel.
+            renderer->DrawImage({ 0, 0, 1, 1 }, { 0, 0, 1, 1 }, texture, Tint(Argb(128, 255, 255, 255)));
+            renderer->DestroyTexture(texture);
+
+            // 200 * 128 / 255 = 100.4, 1 * 128 / 255 = 0.502, 2 * 128 / 255 = 1.004
+            AssertPixels(renderer, { Pixel(100, 1, 1, 128) });
+          }
+      },
+      {
+          "should copy an opaque texture",
+          [](const TestInfo&) {
+            auto renderer{ TestSoftwareRenderer::New(3, 2) };
+            auto texture{ renderer->NewTexture(2, 1, { Pixel(1, 0, 0, 255), Pixel(2, 0, 0, 255) }, true) };
+
+            renderer->Clear(Argb(255, 0, 0, 255));
+            renderer->DrawImage({ 1, 1, 2, 1 }, { 0, 0, 2, 1 }, texture, {});
+            renderer->DestroyTexture(texture);
+
+            AssertPixels(renderer, {
+                Pixel(0, 0, 255, 255), Pixel(0, 0, 255, 255), Pixel(0, 0, 255, 255),
+                Pixel(0, 0, 255, 255), Pixel(1, 0, 0, 255), Pixel(2, 0, 0, 255)
+            });
+          }
+      },
+      {
+          "should draw opaque and translucent textures with the same result",
+          [](const TestInfo&) {
+            const std::vector<uint32_t> pixels{
+                Pixel(10, 20, 30, 255), Pixel(40, 50, 60, 255),
+                Pixel(70, 80, 90, 255), Pixel(100, 110, 120, 255)
+            };
+            const IntRect src{ 0, 0, 2, 2 };
+            // Unscaled draws of opaque textures take the copy path; scaled draws take the sampling path.
+            const Rect boxes[]{ { -1, 1, 2, 2 }, { 1, -1, 3, 4 } };
+
+            for (auto& box : boxes) {
+              auto opaque{ TestSoftwareRenderer::New(3, 3) };
+              auto blended{ TestSoftwareRenderer::New(3, 3) };
+              auto opaqueTexture{ opaque->NewTexture(2, 2, pixels, true) };
+              auto blendedTexture{ blended->NewTexture(2, 2, pixels, false) };
+
+              opaque->Clear(Argb(255, 0, 0, 255));
+              opaque->DrawImage(box, src, opaqueTexture, {});
+              opaque->DestroyTexture(opaqueTexture);
+              blended->Clear(Argb(255, 0, 0, 255));
+              blended->DrawImage(box, src, blendedTexture, {});
+              blended->DestroyTexture(blendedTexture);
+
+              for (int32_t i = 0; i < 9; i++) {
+                Assert::Equal(opaque->GetPixel(i % 3, i / 3), blended->GetPixel(i % 3, i / 3));
+              }
+            }
+          }
+      },
+      {
+          "should blend a translucent texture",
+          [](const TestInfo&) {
+            auto renderer{ TestSoftwareRenderer::New(1, 1) };
+            auto texture{ renderer->NewTexture(1, 1, { Pixel(128, 0, 0, 128) }, false) };
+
+            renderer->Clear(Argb(255, 0, 0, 255));
+            renderer->DrawImage({ 0, 0, 1, 1 }, { 0, 0, 1, 1 }, texture, {});
+            renderer->DestroyTexture(texture);
+
+            AssertPixels(renderer, { Pixel(128, 0, 127, 255) });
+          }
+      },
+      {
+          "should clip a dest partly outside of the target",
+          [](const TestInfo&) {
+            auto renderer{ TestSoftwareRenderer::New(2, 2) };
+            auto texture{ renderer->NewTexture(2, 2, {
+                Pixel(1, 0, 0, 255), Pixel(2, 0, 0, 255),
+                Pixel(3, 0, 0, 255), Pixel(4, 0, 0, 255)
+            }, true) };
+
+            renderer->DrawImage({ -1, -1, 2, 2 }, { 0, 0, 2, 2 }, texture, {});
+            renderer->DrawImage({ 1, 1, 2, 2 }, { 0, 0, 2, 2 }, texture, {});
+            renderer->DestroyTexture(texture);
+
+            AssertPixels(renderer, { Pixel(4, 0, 0, 255), 0, 0, Pixel(1, 0, 0, 255) });
+          }
+      },
+      {
+          "should sample a scaled dest partly outside of the target",
+          [](const TestInfo&) {
+            auto renderer{ TestSoftwareRenderer::New(3, 1) };
+            auto texture{ renderer->NewTexture(2, 1, { Pixel(1, 0, 0, 255), Pixel(2, 0, 0, 255) }, false) };
+
+            // Dest x -2 to 2 maps source pixel 0 to dest -2 and -1, source pixel 1 to dest 0 and 1.
+            renderer->DrawImage({ -2, 0, 4, 1 }, { 0, 0, 2, 1 }, texture, {});
+            renderer->DestroyTexture(texture);
+
+            AssertPixels(renderer, { Pixel(2, 0, 0, 255), Pixel(2, 0, 0, 255), 0 });
+          }
+      },
+      {
+          "should clip to the clip rect",
+          [](const TestInfo&) {
+            auto renderer{ TestSoftwareRenderer::New(3, 3) };
+            auto texture{ renderer->NewTexture(3, 3, std::vector<uint32_t>(9, Pixel(1, 2, 3, 255)), true) };
+
+            renderer->EnabledClipping({ 1, 1, 5, 5 });
+            renderer->DrawImage({ 0, 0, 3, 3 }, { 0, 0, 3, 3 }, texture, {});
+            renderer->DisableClipping();
+            renderer->DestroyTexture(texture);
+
+            AssertPixels(renderer, {
+                0, 0, 0,
+                0, Pixel(1, 2, 3, 255), Pixel(1, 2, 3, 255),
+                0, Pixel(1, 2, 3, 255), Pixel(1, 2, 3, 255)
+            });
+          }
+      },
+      {
+          "should not draw outside of the target",
+          [](const TestInfo&) {
+            auto renderer{ TestSoftwareRenderer::New(2, 1) };
+            auto texture{ renderer->NewTexture(1, 1, { Pixel(1, 2, 3, 255) }, true) };
+
+            renderer->DrawImage({ 2, 0, 1, 1 }, { 0, 0, 1, 1 }, texture, {});
+            renderer->DrawImage({ -1, 0, 1, 1 }, { 0, 0, 1, 1 }, texture, {});
+            renderer->EnabledClipping({ 0, 0, 1, 1 });
+            renderer->DrawImage({ 1, 0, 1, 1 }, { 0, 0, 1, 1 }, texture, {});
+            renderer->DestroyTexture(texture);
+
+            AssertPixels(renderer, { 0, 0 });
+          }
+      },
+      {
+          "should flip horizontally",
+          [](const TestInfo&) {
+            auto renderer{ TestSoftwareRenderer::New(3, 1) };
+            auto texture{ renderer->NewTexture(3, 1, {
+                Pixel(1, 0, 0, 255), Pixel(2, 0, 0, 255), Pixel(3, 0, 0, 255)
+            }, true) };
+
+            renderer->DrawImage({ 0, 0, 3, 1 }, { 0, 0, 3, 1 }, texture, Flip(true, false));
+
+            AssertPixels(renderer, { Pixel(3, 0, 0, 255), Pixel(2, 0, 0, 255), Pixel(1, 0, 0, 255) });
+
+            // Clipping removes the dest pixels on the left, which sample the right side of the source.
+            renderer->Clear({});
+            renderer->DrawImage({ -1, 0, 3, 1 }, { 0, 0, 3, 1 }, texture, Flip(true, false));
+            renderer->DestroyTexture(texture);
+
+            AssertPixels(renderer, { Pixel(2, 0, 0, 255), Pixel(1, 0, 0, 255), 0 });
+          }
+      },
+      {
+          "should flip vertically",
+          [](const TestInfo&) {
+            auto renderer{ TestSoftwareRenderer::New(1, 3) };
+            auto texture{ renderer->NewTexture(1, 3, {
+                Pixel(1, 0, 0, 255), Pixel(2, 0, 0, 255), Pixel(3, 0, 0, 255)
+            }, true) };
+
+            renderer->DrawImage({ 0, 0, 1, 3 }, { 0, 0, 1, 3 }, texture, Flip(false, true));
+
+            AssertPixels(renderer, { Pixel(3, 0, 0, 255), Pixel(2, 0, 0, 255), Pixel(1, 0, 0, 255) });
+
+            renderer->Clear({});
+            renderer->DrawImage({ 0, -1, 1, 3 }, { 0, 0, 1, 3 }, texture, Flip(false, true));
+            renderer->DestroyTexture(texture);
+
+            AssertPixels(renderer, { Pixel(2, 0, 0, 255), Pixel(1, 0, 0, 255), 0 });
+          }
+      },
+      {
+          "should flip a sub-rect of the texture",
+          [](const TestInfo&) {
+            auto renderer{ TestSoftwareRenderer::New(2, 2) };
+            auto texture{ renderer->NewTexture(3, 3, {
+                Pixel(1, 0, 0, 255), Pixel(2, 0, 0, 255), Pixel(3, 0, 0, 255),
+                Pixel(4, 0, 0, 255), Pixel(5, 0, 0, 255), Pixel(6, 0, 0, 255),
+                Pixel(7, 0, 0, 255), Pixel(8, 0, 0, 255), Pixel(9, 0, 0, 255)
+            }, true) };
+
+            renderer->DrawImage({ 0, 0, 2, 2 }, { 1, 1, 2, 2 }, texture, Flip(true, true));
+            renderer->DestroyTexture(texture);
+
+            AssertPixels(renderer, {
+                Pixel(9, 0, 0, 255), Pixel(8, 0, 0, 255),
+                Pixel(6, 0, 0, 255), Pixel(5, 0, 0, 255)
+            });
+          }
+      },
+      {
+          "should rotate about the center of the box",
+          [](const TestInfo&) {
+            auto renderer{ TestSoftwareRenderer::New(2, 2) };
+            auto texture{ renderer->NewTexture(2, 2, {
+                Pixel(1, 0, 0, 255), Pixel(2, 0, 0, 255),
+                Pixel(3, 0, 0, 255), Pixel(4, 0, 0, 255)
+            }, true) };
+            RenderTransform transform{};
+
+            transform.rotate = 90;
+            renderer->DrawImage(transform, { 0, 0 }, { 0, 0, 2, 2 }, { 0, 0, 2, 2 }, texture, {});
+            renderer->DestroyTexture(texture);
+
+            // Clockwise quarter turn.
+            AssertPixels(renderer, {
+                Pixel(3, 0, 0, 255), Pixel(1, 0, 0, 255),
+                Pixel(4, 0, 0, 255), Pixel(2, 0, 0, 255)
+            });
+          }
+      },
+      {
+          "should scale and clip a rotated draw",
+          [](const TestInfo&) {
+            auto renderer{ TestSoftwareRenderer::New(3, 2) };
+            auto texture{ renderer->NewTexture(2, 1, { Pixel(1, 0, 0, 255), Pixel(2, 0, 0, 255) }, false) };
+            RenderTransform transform{};
+
+            // A 4x2 box starting 1 pixel left of the target, upside down: source pixel 1 lands on the left.
+            transform.rotate = 180;
+            renderer->DrawImage(transform, { 0, 0 }, { -1, 0, 4, 2 }, { 0, 0, 2, 1 }, texture, {});
+            renderer->DestroyTexture(texture);
+
+            AssertPixels(renderer, {
+                Pixel(2, 0, 0, 255), Pixel(1, 0, 0, 255), Pixel(1, 0, 0, 255),
+                Pixel(2, 0, 0, 255), Pixel(1, 0, 0, 255), Pixel(1, 0, 0, 255)
+            });
+          }
+      }
+  };
+
+  spec->Describe("DrawImageCapInsets()")->tests = {
+      {
+          "should scale insets down when they do not fit in the box",
+          [](const TestInfo&) {
+            auto renderer{ TestSoftwareRenderer::New(2, 2) };
+            std::vector<uint32_t> pixels;
+
+            for (uint8_t i = 1; i <= 16; i++) {
+              pixels.push_back(Pixel(i, 0, 0, 255));
+            }
+
+            auto texture{ renderer->NewTexture(4, 4, pixels, true) };
+
+            // The 2 pixel insets are scaled to 1 pixel, so only the corners are drawn, each sampled at its center.
+            renderer->DrawImageCapInsets({ 0, 0, 2, 2 }, { 2, 2, 2, 2 }, texture, {});
+            renderer->DestroyTexture(texture);
+
+            AssertPixels(renderer, {
+                Pixel(6, 0, 0, 255), Pixel(8, 0, 0, 255),
+                Pixel(14, 0, 0, 255), Pixel(16, 0, 0, 255)
+            });
+          }
+      }
+  };
+}
+
+static uint32_t Pixel(uint8_t r, uint8_t g, uint8_t b, uint8_t a) noexcept {
+  color_t color{};
+
+  color.channels[0] = r;
+  color.channels[1] = g;
+  color.channels[2] = b;
+  color.channels[3] = a;
+
+  return color.value;
+}
+
+static color_t Argb(uint8_t a, uint8_t r, uint8_t g, uint8_t b) noexcept {
+  return { a, r, g, b };
+}
+
+static RenderFilter Tint(color_t tint) noexcept {
+  RenderFilter filter{};
+
+  filter.tint = tint;
+
+  return filter;
+}
+
+static RenderFilter Flip(bool flipH, bool flipV) noexcept {
+  RenderFilter filter{};
+
+  filter.flipH = flipH;
+  filter.flipV = flipV;
+
+  return filter;
+}
+
+static void AssertPixels(
+    const std::shared_ptr<TestSoftwareRenderer>& renderer, const std::vector<uint32_t>& expected) {
+  const auto width{ renderer->GetWidth() };
+
+  Assert::Equal(expected.size(), static_cast<std::size_t>(width * renderer->GetHeight()));
+
+  for (std::size_t i = 0; i < expected.size(); i++) {
+    Assert::Equal(renderer->GetPixel(static_cast<int32_t>(i) % width, static_cast<int32_t>(i) / width), expected[i]);
+  }
+}
+
+} // namespace lse
@@ -115,6 +115,11 @@ constexpr const char* kSDLFrameworkLib = "SDL2";
     APPLY(SDL_SetWindowTitle)                               \
     APPLY(SDL_GetWindowDisplayMode)                         \
     APPLY(SDL_GetWindowFlags)                               \
+    APPLY(SDL_GetWindowSurface)                             \
+    APPLY(SDL_UpdateWindowSurfaceRects)                     \
+    APPLY(SDL_LockSurface)                                  \
+    APPLY(SDL_UnlockSurface)                                \
+    APPLY(SDL_ConvertPixels)                                \
     APPLY(SDL_ShowCursor)                                   \
     APPLY(SDL_RWFromFile)                                   \
     APPLY(SDL_RWFromMem)                                    \
@@ -137,7 +142,8 @@ constexpr const char* kSDLFrameworkLib = "SDL2";
     APPLY(SDL_RenderCopyF)                                  \
     APPLY(SDL_RenderCopyExF)                                \
     APPLY(SDL_RenderFillRectsF)                             \
-    APPLY(SDL_RenderFillRectF)
+    APPLY(SDL_RenderFillRectF)                              \
+    APPLY(SDL_ComposeCustomBlendMode)
 
 // Load SDL2 functions manually.
 //
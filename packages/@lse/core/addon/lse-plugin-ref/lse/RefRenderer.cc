@@ -22,6 +22,7 @@ class RefTexture final : public Texture {
   }
 
   bool Update(const uint8_t* pixels) noexcept override {
+    this->CountUpload();
     return true;
   }
 
@@ -33,6 +34,7 @@ class RefTexture final : public Texture {
   void Unlock() noexcept override {
     delete [] this->lockedPixels;
     this->lockedPixels = nullptr;
+    this->CountUpload();
   }
 
  private:
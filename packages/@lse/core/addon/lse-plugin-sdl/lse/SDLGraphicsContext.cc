@@ -14,6 +14,7 @@
 #include <lse/SDLGraphicsContext.h>
 
 #include <lse/SDLRenderer.h>
+#include <lse/SDLSurfaceRenderer.h>
 #include <lse/Log.h>
 #include <lse/string-ext.h>
 
@@ -22,13 +23,21 @@ namespace lse {
 static Uint32 GetFullscreenFlag(const GraphicsContextConfig& config) noexcept;
 
 SDLGraphicsContext::SDLGraphicsContext(const GraphicsContextConfig& config) : GraphicsContext() {
-  this->sdlRenderer = SDLRenderer::New();
-  this->SetRenderer(this->sdlRenderer);
+  if (EqualsIgnoreCase(config.renderer, "software")) {
+    this->surfaceRenderer = SDLSurfaceRenderer::New();
+    this->SetRenderer(this->surfaceRenderer);
+  } else {
+    this->sdlRenderer = SDLRenderer::New();
+    this->SetRenderer(this->sdlRenderer);
+  }
+
   this->SetConfig(config);
 }
 
 void SDLGraphicsContext::Attach() {
-  if (!this->sdlRenderer) {
+  auto renderer{this->GetRenderer()};
+
+  if (!renderer) {
     return;
   }
 
@@ -72,21 +81,27 @@ void SDLGraphicsContext::Attach() {
     this->refreshRate = displayMode.refresh_rate;
   }
 
-  this->sdlRenderer->Attach(this->window);
+  if (this->surfaceRenderer) {
+    this->surfaceRenderer->Attach(this->window);
+  } else {
+    this->sdlRenderer->Attach(this->window);
+  }
 
-  this->width = this->sdlRenderer->GetWidth();
-  this->height = this->sdlRenderer->GetHeight();
+  this->width = renderer->GetWidth();
+  this->height = renderer->GetHeight();
   this->fullscreen = isWindowFullscreen;
   this->displayIndex = displayIndex;
 }
 
 void SDLGraphicsContext::Detach() {
-  if (!this->sdlRenderer) {
+  if (this->surfaceRenderer) {
+    this->surfaceRenderer->Detach();
+  } else if (this->sdlRenderer) {
+    this->sdlRenderer->Detach();
+  } else {
     return;
   }
 
-  this->sdlRenderer->Detach();
-
   if (this->window) {
     SDL2::SDL_DestroyWindow(this->window);
     this->window = nullptr;
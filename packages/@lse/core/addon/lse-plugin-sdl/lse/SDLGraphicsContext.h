@@ -19,9 +19,13 @@
 namespace lse {
 
 class SDLRenderer;
+class SDLSurfaceRenderer;
 
 /**
  * SDL GraphicsContext implementation.
+ *
+ * Renders with an SDL_Renderer (GPU) by default. If the config requests the "software" renderer, frames are
+ * rasterized by the CPU and presented through the window surface.
  */
 class SDLGraphicsContext final : public GraphicsContext {
  public:
@@ -36,6 +40,7 @@ class SDLGraphicsContext final : public GraphicsContext {
  private:
   SDL_Window* window{};
   std::shared_ptr<SDLRenderer> sdlRenderer;
+  std::shared_ptr<SDLSurfaceRenderer> surfaceRenderer;
 };
 
 } // namespace lse
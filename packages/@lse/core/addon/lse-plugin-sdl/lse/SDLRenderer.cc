@@ -15,6 +15,7 @@
 
 #include <array>
 #include <cstring>
+#include <vector>
 #include <lse/SDLUtil.h>
 #include <lse/PixelConversion.h>
 #include <lse/Log.h>
@@ -28,8 +29,8 @@ static const std::array<uint8_t, 4> kSinglePixelWhite{ 255, 255, 255, 255 };
 class SDLTexture : public Texture {
  public:
   SDLTexture(std::shared_ptr<SDLRenderer> owner, SDL_Texture* texture,
-      int32_t width, int32_t height, PixelFormat format, Type type) noexcept
-  : Texture(std::move(owner), texture, width, height, format, type) {
+      int32_t width, int32_t height, PixelFormat format, Type type, bool isStraightAlpha) noexcept
+  : Texture(std::move(owner), texture, width, height, format, type), isStraightAlpha(isStraightAlpha) {
   }
 
   bool Update(const uint8_t* pixels) noexcept override {
@@ -38,12 +39,21 @@ class SDLTexture : public Texture {
     }
 
     auto pitch{this->width * 4};
+    std::vector<uint8_t> straight;
+
+    if (this->isStraightAlpha && pixels) {
+      straight.assign(pixels, pixels + static_cast<std::size_t>(pitch) * this->height);
+      UnpremultiplyAlpha(reinterpret_cast<color_t*>(straight.data()), this->width * this->height, this->format);
+      pixels = straight.data();
+    }
 
     if (SDL2::SDL_UpdateTexture(this->As<SDL_Texture>(), nullptr, pixels, pitch) != 0) {
       LOG_ERROR(SDL2::SDL_GetError());
       return false;
     }
 
+    this->CountUpload();
+
     return true;
   }
 
@@ -60,16 +70,64 @@ class SDLTexture : public Texture {
       return {};
     }
 
-    return static_cast<uint8_t*>(pixels);
+    this->lockedPixels = static_cast<uint8_t*>(pixels);
+    this->lockedPitch = pitch;
+
+    return this->lockedPixels;
   }
 
   void Unlock() noexcept override {
     if (this->platformTexture) {
+      if (this->isStraightAlpha && this->lockedPixels) {
+        for (int32_t y = 0; y < this->height; y++) {
+          UnpremultiplyAlpha(
+              reinterpret_cast<color_t*>(this->lockedPixels + y * this->lockedPitch), this->width, this->format);
+        }
+      }
+
+      this->lockedPixels = nullptr;
       SDL2::SDL_UnlockTexture(this->As<SDL_Texture>());
+      this->CountUpload();
     }
   }
+
+  // Last blend mode and tint applied to the SDL texture. SDLRenderer only issues (and counts) changes.
+  SDL_BlendMode blendMode{SDL_BLENDMODE_NONE};
+  color_t tint{ColorWhite};
+
+ private:
+  // The render driver cannot blend premultiplied alpha, so premultiplied content is uploaded as straight alpha.
+  bool isStraightAlpha{};
+  uint8_t* lockedPixels{};
+  int32_t lockedPitch{};
 };
 
+// Custom blend modes are available since SDL 2.0.6, but render drivers, like SDL's software renderer, can still
+// reject them. The driver is checked once per attach with a throwaway texture.
+static SDL_BlendMode GetPremultipliedBlendMode(SDL_Renderer* renderer, PixelFormat format) noexcept {
+  if (!SDL2::SDL_ComposeCustomBlendMode) {
+    LOG_WARN("SDL_ComposeCustomBlendMode unavailable. Textures will be uploaded with straight alpha.");
+    return SDL_BLENDMODE_BLEND;
+  }
+
+  const auto blendMode{SDL2::SDL_ComposeCustomBlendMode(
+      SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD,
+      SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD)};
+  auto texture{SDL2::SDL_CreateTexture(renderer, ToSDLPixelFormat(format), SDL_TEXTUREACCESS_STATIC, 1, 1)};
+  const auto isSupported{texture && SDL2::SDL_SetTextureBlendMode(texture, blendMode) == 0};
+
+  if (!isSupported) {
+    LOG_WARN("Premultiplied alpha blend mode not supported: %s. Textures will be uploaded with straight alpha.",
+             SDL2::SDL_GetError());
+  }
+
+  if (texture) {
+    SDL2::SDL_DestroyTexture(texture);
+  }
+
+  return isSupported ? blendMode : SDL_BLENDMODE_BLEND;
+}
+
 SDLRenderer::SDLRenderer() {
   SDL_RendererInfo info;
 
@@ -117,6 +175,7 @@ void SDLRenderer::Present() noexcept {
 void SDLRenderer::Clear(color_t color) noexcept {
   this->SetRenderDrawColor(color);
   SDL2::SDL_RenderClear(this->renderer);
+  this->stats.drawCalls++;
 }
 
 bool SDLRenderer::SetRenderTarget(Texture* texture) noexcept {
@@ -130,6 +189,7 @@ bool SDLRenderer::SetRenderTarget(Texture* texture) noexcept {
     return false;
   }
 
+  this->stats.stateChanges++;
   this->ResetInternal();
 
   return true;
@@ -138,6 +198,7 @@ bool SDLRenderer::SetRenderTarget(Texture* texture) noexcept {
 void SDLRenderer::Reset() noexcept {
   if (this->renderer) {
     SDL2::SDL_SetRenderTarget(this->renderer, nullptr);
+    this->stats.stateChanges++;
     this->ResetInternal();
   }
 }
@@ -145,7 +206,6 @@ void SDLRenderer::Reset() noexcept {
 void SDLRenderer::ResetInternal() {
   this->DisableClipping();
   this->SetRenderDrawColor(ColorWhite);
-  SDL2::SDL_SetRenderDrawBlendMode(this->renderer, SDL_BLENDMODE_BLEND);
 }
 
 void SDLRenderer::EnabledClipping(const Rect& rect) noexcept {
@@ -157,10 +217,12 @@ void SDLRenderer::EnabledClipping(const Rect& rect) noexcept {
   };
 
   SDL2::SDL_RenderSetClipRect(this->renderer, &clipRect);
+  this->stats.stateChanges++;
 }
 
 void SDLRenderer::DisableClipping() noexcept {
   SDL2::SDL_RenderSetClipRect(this->renderer, nullptr);
+  this->stats.stateChanges++;
 }
 
 Texture* SDLRenderer::CreateTexture(int32_t width, int32_t height, Texture::Type type) {
@@ -177,12 +239,13 @@ Texture* SDLRenderer::CreateTexture(int32_t width, int32_t height, Texture::Type
     return {};
   }
 
-  SDL2::SDL_SetTextureBlendMode(sdlTexture, SDL_BLENDMODE_BLEND);
+  SDL2::SDL_SetTextureBlendMode(sdlTexture, this->textureBlendMode);
 
   auto texture{new (std::nothrow) SDLTexture(
-      this->shared_from_this(), sdlTexture, width, height, this->GetTextureFormat(), type)};
+      this->shared_from_this(), sdlTexture, width, height, this->GetTextureFormat(), type, this->isStraightAlpha)};
 
   if (texture) {
+    texture->blendMode = this->textureBlendMode;
     this->textures.insert(texture);
   }
 
@@ -211,6 +274,7 @@ void SDLRenderer::SetRenderDrawColor(color_t color) noexcept {
     // TODO: consider opacity
     SDL2::SDL_SetRenderDrawColor(this->renderer, color.r, color.g, color.b, color.a);
     this->drawColor = color;
+    this->stats.stateChanges++;
   }
 }
 
@@ -224,6 +288,11 @@ void SDLRenderer::Attach(SDL_Window* window) {
 
   SDL2::SDL_GetRendererOutputSize(this->renderer, &this->width, &this->height);
 
+  // Sync the cached draw state with the new renderer. The draw blend mode is not changed after this.
+  SDL2::SDL_SetRenderDrawColor(this->renderer, 255, 255, 255, 255);
+  SDL2::SDL_SetRenderDrawBlendMode(this->renderer, SDL_BLENDMODE_BLEND);
+  this->drawColor = ColorWhite;
+
   SDL_RendererInfo info{};
 
   if (SDL2::SDL_GetRendererInfo(this->renderer, &info) == 0) {
@@ -241,6 +310,11 @@ void SDLRenderer::Attach(SDL_Window* window) {
 
   LOGX_INFO("Texture Formats: %s", textureFormats);
 
+  // All texture content is premultiplied alpha. If the driver cannot blend it, textures are converted to straight
+  // alpha on upload and drawn with the standard blend mode.
+  this->textureBlendMode = GetPremultipliedBlendMode(this->renderer, this->textureFormat);
+  this->isStraightAlpha = this->textureBlendMode == SDL_BLENDMODE_BLEND;
+
   this->fillRectTexture = this->CreateTexture(1, 1, Texture::Updatable);
 
   if (!this->fillRectTexture) {
@@ -291,9 +365,8 @@ void SDLRenderer::DrawImage(
     return;
   }
 
-  auto tex{texture->As<SDL_Texture>()};
+  auto tex{this->PrepareTexture(texture, filter)};
   const auto& srcRect{reinterpret_cast<const SDL_Rect&>(src)};
-  SDLSetTextureTint(tex, filter);
 
   if (this->floatMode) {
     auto destRect{SDLSnapToPixelGrid<SDL_FRect>(box)};
@@ -318,6 +391,8 @@ void SDLRenderer::DrawImage(
         nullptr,
         SDLGetRenderFlip(filter));
   }
+
+  this->stats.drawCalls++;
 }
 
 void SDLRenderer::DrawImage(
@@ -326,9 +401,8 @@ void SDLRenderer::DrawImage(
     return;
   }
 
-  auto tex{texture->As<SDL_Texture>()};
+  auto tex{this->PrepareTexture(texture, filter)};
   const auto& srcRect{reinterpret_cast<const SDL_Rect&>(src)};
-  SDLSetTextureTint(tex, filter);
 
   if (this->floatMode) {
     auto destRect{SDLSnapToPixelGrid<SDL_FRect>(box)};
@@ -347,6 +421,8 @@ void SDLRenderer::DrawImage(
       SDL2::SDL_RenderCopy(this->renderer, tex, &srcRect, &destRect);
     }
   }
+
+  this->stats.drawCalls++;
 }
 
 static void LayoutCapInsetsSourceRects(const EdgeRect& capInsets, Texture* texture, SDL_Rect* src) noexcept {
@@ -406,9 +482,8 @@ void SDLRenderer::DrawImageCapInsets(
 
   static constexpr auto kSize = 9;
   SDL_Rect src[kSize];
-  auto nativeTexture{texture->As<SDL_Texture>()};
+  auto nativeTexture{this->PrepareTexture(texture, filter)};
 
-  SDLSetTextureTint(nativeTexture, filter);
   LayoutCapInsetsSourceRects(capInsets, texture, src);
 
   if (this->floatMode) {
@@ -428,10 +503,35 @@ void SDLRenderer::DrawImageCapInsets(
       SDL2::SDL_RenderCopy(this->renderer, nativeTexture, &src[i], &dest[i]);
     }
   }
+
+  this->stats.drawCalls += kSize;
+}
+
+SDL_Texture* SDLRenderer::PrepareTexture(Texture* texture, const RenderFilter& filter) noexcept {
+  // All textures drawn by this renderer were created by it.
+  auto sdlTexture{static_cast<SDLTexture*>(texture)};
+  auto nativeTexture{texture->As<SDL_Texture>()};
+
+  if (sdlTexture->tint != filter.tint) {
+    SDLSetTextureTint(nativeTexture, filter, !this->isStraightAlpha);
+    sdlTexture->tint = filter.tint;
+    this->stats.stateChanges++;
+  }
+
+  // Opaque textures drawn at full opacity replace the destination, so skip the blending fill rate cost.
+  const auto blendMode{texture->IsOpaque() && filter.tint.a == 255 ? SDL_BLENDMODE_NONE : this->textureBlendMode};
+
+  if (sdlTexture->blendMode != blendMode) {
+    SDL2::SDL_SetTextureBlendMode(nativeTexture, blendMode);
+    sdlTexture->blendMode = blendMode;
+    this->stats.stateChanges++;
+  }
+
+  return nativeTexture;
 }
 
 void SDLRenderer::FillRect(const Rect& box, const RenderFilter& filter) noexcept {
-  SDLSetDrawColor(this->renderer, filter);
+  this->SetRenderDrawColor(filter.tint);
 
   if (this->floatMode) {
     auto dest{SDLSnapToPixelGrid<SDL_FRect>(box)};
@@ -440,6 +540,8 @@ void SDLRenderer::FillRect(const Rect& box, const RenderFilter& filter) noexcept
     auto dest{SDLSnapToPixelGrid<SDL_Rect>(box)};
     SDL2::SDL_RenderFillRect(this->renderer, &dest);
   }
+
+  this->stats.drawCalls++;
 }
 
 template<typename R, typename D>
@@ -476,7 +578,7 @@ static int32_t LayoutBorder(const Rect& box, const EdgeRect& edges, R* dest) {
 }
 
 void SDLRenderer::StrokeRect(const Rect& box, const EdgeRect& edges, const RenderFilter& filter) noexcept {
-  SDLSetDrawColor(this->renderer, filter);
+  this->SetRenderDrawColor(filter.tint);
 
   if (this->floatMode) {
     SDL_FRect dest[4];
@@ -489,6 +591,8 @@ void SDLRenderer::StrokeRect(const Rect& box, const EdgeRect& edges, const Rende
 
     SDL2::SDL_RenderFillRects(this->renderer, dest, count);
   }
+
+  this->stats.drawCalls++;
 }
 
 } // namespace lse
@@ -77,6 +77,7 @@ class SDLRenderer final : public Renderer, public std::enable_shared_from_this<S
  private:
   void ResetInternal();
   void SetRenderDrawColor(color_t color) noexcept;
+  SDL_Texture* PrepareTexture(Texture* texture, const RenderFilter& filter) noexcept;
   void UpdateTextureFormats(const SDL_RendererInfo& info) noexcept;
 
  private:
@@ -84,6 +85,9 @@ class SDLRenderer final : public Renderer, public std::enable_shared_from_this<S
   phmap::flat_hash_set<Texture*> textures{};
   bool floatMode{false};
   PixelFormat textureFormat{PixelFormatUnknown};
+  SDL_BlendMode textureBlendMode{SDL_BLENDMODE_BLEND};
+  // Set at attach when the render driver cannot blend premultiplied alpha.
+  bool isStraightAlpha{};
   color_t drawColor{};
   Texture* fillRectTexture{};
   int32_t width{0};
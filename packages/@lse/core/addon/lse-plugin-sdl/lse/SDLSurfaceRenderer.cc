@@ -0,0 +1,193 @@
+/*
+ * Copyright (c) 2021 Light Source Software, LLC. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on
+ * an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the
+ * specific language governing permissions and limitations under the License.
+ */
+
+#include <lse/SDLSurfaceRenderer.h>
+
+#include <algorithm>
+#include <cstring>
+#include <lse/SDLUtil.h>
+#include <lse/Log.h>
+#include <lse/string-ext.h>
+
+namespace lse {
+
+// Tiles are wide and short, so a compare reads long runs of contiguous memory.
+constexpr int32_t kTileWidth{64};
+constexpr int32_t kTileHeight{16};
+
+static uint32_t GetFramebufferFormat(uint32_t surfaceFormat) noexcept;
+
+std::shared_ptr<SDLSurfaceRenderer> SDLSurfaceRenderer::New() {
+  return std::make_shared<SDLSurfaceRenderer>();
+}
+
+void SDLSurfaceRenderer::Attach(SDL_Window* window) {
+  auto windowSurface{SDL2::SDL_GetWindowSurface(window)};
+
+  if (!windowSurface) {
+    throw std::runtime_error(Format("Failed to get the window surface. SDL Error: %s", SDL2::SDL_GetError()));
+  }
+
+  this->framebufferFormat = GetFramebufferFormat(windowSurface->format->format);
+  this->CreateFramebuffer(windowSurface->w, windowSurface->h, ToPixelFormat(this->framebufferFormat));
+  this->presented.assign(static_cast<std::size_t>(windowSurface->w) * windowSurface->h, 0);
+  this->window = window;
+  // Set on the first Present(), which sends the whole frame.
+  this->surface = nullptr;
+
+  LOGX_INFO("SDL_Surface: %ix%i driver=%s surfaceFormat=%s textureFormat=%s",
+            this->GetWidth(),
+            this->GetHeight(),
+            SDL2::SDL_GetCurrentVideoDriver(),
+            SDL2::SDL_GetPixelFormatName(windowSurface->format->format),
+            SDL2::SDL_GetPixelFormatName(this->framebufferFormat));
+}
+
+void SDLSurfaceRenderer::Detach() {
+  this->DestroyFramebuffer();
+  this->presented.clear();
+  this->presented.shrink_to_fit();
+  this->dirtyRects.clear();
+  // The window surface is owned by the window.
+  this->surface = nullptr;
+  this->window = nullptr;
+}
+
+void SDLSurfaceRenderer::Present() noexcept {
+  if (!this->window) {
+    return;
+  }
+
+  auto windowSurface{SDL2::SDL_GetWindowSurface(this->window)};
+
+  if (!windowSurface) {
+    LOG_ERROR(SDL2::SDL_GetError());
+    return;
+  }
+
+  const auto stride{this->GetWidth()};
+  const auto width{std::min(stride, windowSurface->w)};
+  const auto height{std::min(this->GetHeight(), windowSurface->h)};
+  const auto frame{this->GetFramebufferPixels()};
+  auto previous{this->presented.data()};
+
+  this->dirtyRects.clear();
+
+  if (windowSurface != this->surface) {
+    // First frame or the window surface was recreated: the surface content is unknown.
+    this->dirtyRects.push_back({ 0, 0, width, height });
+    this->surface = windowSurface;
+  } else {
+    for (int32_t y = 0; y < height; y += kTileHeight) {
+      const auto tileHeight{std::min(kTileHeight, height - y)};
+      int32_t runStart{-1};
+
+      // Adjacent changed tiles in a row are merged into one rect.
+      for (int32_t x = 0; x < width; x += kTileWidth) {
+        const auto tileSize{static_cast<std::size_t>(std::min(kTileWidth, width - x)) * sizeof(uint32_t)};
+        auto isDirty{false};
+
+        for (int32_t row = y; row < y + tileHeight && !isDirty; row++) {
+          const auto offset{row * stride + x};
+
+          isDirty = std::memcmp(frame + offset, previous + offset, tileSize) != 0;
+        }
+
+        if (isDirty) {
+          if (runStart < 0) {
+            runStart = x;
+          }
+        } else if (runStart >= 0) {
+          this->dirtyRects.push_back({ runStart, y, x - runStart, tileHeight });
+          runStart = -1;
+        }
+      }
+
+      if (runStart >= 0) {
+        this->dirtyRects.push_back({ runStart, y, width - runStart, tileHeight });
+      }
+    }
+  }
+
+  if (this->dirtyRects.empty()) {
+    return;
+  }
+
+  const auto mustLock{SDL_MUSTLOCK(windowSurface)};
+
+  if (mustLock && SDL2::SDL_LockSurface(windowSurface) != 0) {
+    LOG_ERROR(SDL2::SDL_GetError());
+    return;
+  }
+
+  for (const auto& rect : this->dirtyRects) {
+    for (int32_t row = rect.y; row < rect.y + rect.h; row++) {
+      const auto offset{row * stride + rect.x};
+
+      std::memcpy(previous + offset, frame + offset, static_cast<std::size_t>(rect.w) * sizeof(uint32_t));
+    }
+
+    this->CopyToSurface(windowSurface, rect);
+  }
+
+  if (mustLock) {
+    SDL2::SDL_UnlockSurface(windowSurface);
+  }
+
+  if (SDL2::SDL_UpdateWindowSurfaceRects(
+      this->window, this->dirtyRects.data(), static_cast<int32_t>(this->dirtyRects.size())) != 0) {
+    LOG_ERROR(SDL2::SDL_GetError());
+  }
+}
+
+void SDLSurfaceRenderer::CopyToSurface(SDL_Surface* windowSurface, const SDL_Rect& rect) noexcept {
+  const auto stride{this->GetWidth()};
+  const auto format{windowSurface->format};
+  auto dest{static_cast<uint8_t*>(windowSurface->pixels) + rect.y * windowSurface->pitch
+      + rect.x * format->BytesPerPixel};
+
+  // Same format is a row copy; otherwise, SDL converts (16 bit displays, for example).
+  SDL2::SDL_ConvertPixels(
+      rect.w,
+      rect.h,
+      this->framebufferFormat,
+      this->GetFramebufferPixels() + rect.y * stride + rect.x,
+      stride * 4,
+      format->format,
+      dest,
+      windowSurface->pitch);
+}
+
+static uint32_t GetFramebufferFormat(uint32_t surfaceFormat) noexcept {
+  switch (surfaceFormat) {
+    case SDL_PIXELFORMAT_ARGB8888:
+    case SDL_PIXELFORMAT_RGBA8888:
+    case SDL_PIXELFORMAT_ABGR8888:
+    case SDL_PIXELFORMAT_BGRA8888:
+      return surfaceFormat;
+    // Padded 32 bit formats share a layout with an alpha format. The alpha values written to padding are ignored.
+    case SDL_PIXELFORMAT_RGB888:
+      return SDL_PIXELFORMAT_ARGB8888;
+    case SDL_PIXELFORMAT_BGR888:
+      return SDL_PIXELFORMAT_ABGR8888;
+    case SDL_PIXELFORMAT_RGBX8888:
+      return SDL_PIXELFORMAT_RGBA8888;
+    case SDL_PIXELFORMAT_BGRX8888:
+      return SDL_PIXELFORMAT_BGRA8888;
+    default:
+      // Rendered in 32 bit and converted to the surface format on present.
+      return SDL_PIXELFORMAT_ARGB8888;
+  }
+}
+
+} // namespace lse
@@ -0,0 +1,50 @@
+/*
+ * Copyright (c) 2021 Light Source Software, LLC. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on
+ * an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the
+ * specific language governing permissions and limitations under the License.
+ */
+
+#pragma once
+
+#include <lse/SoftwareRenderer.h>
+#include <vector>
+#include <lse/SDL2.h>
+
+namespace lse {
+
+/**
+ * Software renderer that presents to an SDL window surface.
+ *
+ * For devices without a GPU driver (framebuffer only). Frames are rasterized by SoftwareRenderer. On Present(), the
+ * frame is compared to the previously presented frame in tiles, and only the changed tiles are copied to the window
+ * surface and pushed to the display with SDL_UpdateWindowSurfaceRects. A static screen costs a compare, not a
+ * full screen copy.
+ */
+class SDLSurfaceRenderer final : public SoftwareRenderer {
+ public:
+  static std::shared_ptr<SDLSurfaceRenderer> New();
+
+  void Present() noexcept override;
+
+  void Attach(SDL_Window* window);
+  void Detach();
+
+ private:
+  void CopyToSurface(SDL_Surface* surface, const SDL_Rect& rect) noexcept;
+
+ private:
+  SDL_Window* window{};
+  SDL_Surface* surface{};
+  uint32_t framebufferFormat{SDL_PIXELFORMAT_UNKNOWN};
+  std::vector<uint32_t> presented{};
+  std::vector<SDL_Rect> dirtyRects{};
+};
+
+} // namespace lse
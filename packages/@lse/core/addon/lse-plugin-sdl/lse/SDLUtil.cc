@@ -24,13 +24,18 @@ SDL_Renderer* DestroyRenderer(SDL_Renderer* renderer) noexcept {
   return nullptr;
 }
 
-void SDLSetDrawColor(SDL_Renderer* renderer, const RenderFilter& filter) noexcept {
-  SDL2::SDL_SetRenderDrawColor(renderer, filter.tint.r, filter.tint.g, filter.tint.b, filter.tint.a);
-}
+void SDLSetTextureTint(SDL_Texture* texture, const RenderFilter& filter, bool isPremultiplied) noexcept {
+  // Premultiplied textures need a premultiplied tint, too. Otherwise, opacity would only scale alpha.
+  const auto& tint{filter.tint};
+
+  if (tint.a == 255 || !isPremultiplied) {
+    SDL2::SDL_SetTextureColorMod(texture, tint.r, tint.g, tint.b);
+  } else {
+    SDL2::SDL_SetTextureColorMod(
+        texture, (tint.r * tint.a + 127) / 255, (tint.g * tint.a + 127) / 255, (tint.b * tint.a + 127) / 255);
+  }
 
-void SDLSetTextureTint(SDL_Texture* texture, const RenderFilter& filter) noexcept {
-  SDL2::SDL_SetTextureColorMod(texture, filter.tint.r, filter.tint.g, filter.tint.b);
-  SDL2::SDL_SetTextureAlphaMod(texture, filter.tint.a);
+  SDL2::SDL_SetTextureAlphaMod(texture, tint.a);
 }
 
 SDL_RendererFlip SDLGetRenderFlip(const RenderFilter& filter) noexcept {
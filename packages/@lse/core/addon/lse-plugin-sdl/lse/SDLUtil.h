@@ -33,8 +33,7 @@ struct RenderFilter;
 // Renderer/Drawing utilities
 
 SDL_Renderer* DestroyRenderer(SDL_Renderer* renderer) noexcept;
-void SDLSetDrawColor(SDL_Renderer* renderer, const RenderFilter& filter) noexcept;
-void SDLSetTextureTint(SDL_Texture* texture, const RenderFilter& filter) noexcept;
+void SDLSetTextureTint(SDL_Texture* texture, const RenderFilter& filter, bool isPremultiplied) noexcept;
 SDL_RendererFlip SDLGetRenderFlip(const RenderFilter& filter) noexcept;
 
 // Type conversions
@@ -35,7 +35,10 @@ export const {
   CFontManager,
   CImageManager,
   CBoxSceneNode,
+  CCanvasSceneNode,
   CImageSceneNode,
+  CListSceneNode,
+  CPixelSceneNode,
   CRootSceneNode,
   CTextSceneNode
 } = addon
@@ -74,7 +77,15 @@ export const {
   LogLevel,
   FontStatus,
   FontStyle,
-  FontWeight
+  FontWeight,
+  CanvasCommand,
+  SceneCommand,
+  /**
+   * @enum {number}
+   * @readonly
+   * @name module:@lse/core.core-enum.PixelFormat
+   */
+  PixelFormat
 } = addon
 
 // Function / Object Exports
@@ -14,6 +14,12 @@
 import { CImageManager } from '../addon/index.mjs'
 
 /**
+ * Image and text texture cache of a graphics context.
+ *
+ * Textures belong to a renderer, so the scenes drawing to one graphics context share one ImageManager: an image
+ * requested by several nodes, in one or more of those scenes, is decoded and uploaded once. Text textures are shared
+ * the same way: text nodes showing the same lines with the same font, size and alignment paint one texture.
+ *
  * @class module:@lse/core.ImageManager
  */
 export class ImageManager {
@@ -21,6 +27,73 @@ export class ImageManager {
 
   // TODO: add preload api
 
+  /**
+   * Memory limit, in bytes, of the CPU-side copies (shadows) of image pixels kept after texture upload.
+   *
+   * When a scene is detached, image textures are destroyed. On attach, images with a shadow re-upload their texture
+   * immediately; images without a shadow are loaded and decoded again. Lowering the limit releases shadows. 0 (the
+   * default) disables shadows.
+   *
+   * @type {number}
+   */
+  get shadowLimit () {
+    return this._native.getShadowStats().limit
+  }
+
+  set shadowLimit (value) {
+    this._native.setShadowLimit(Number.isInteger(value) && value > 0 ? value : 0)
+  }
+
+  /**
+   * Shadow memory stats: limit (bytes), usedBytes and count (number of images with a shadow).
+   *
+   * @type {Object}
+   */
+  get shadowStats () {
+    return this._native.getShadowStats()
+  }
+
+  /**
+   * Sharing stats.
+   *
+   * imageCount is the number of cached images. acquireCount is the number of image requests (img src, background
+   * image, etc) and shareCount the number of requests served by an image already cached for another scene; a uri
+   * repeated within one scene is not counted. savedBytes is the decoded size of the shared images: the memory, and
+   * texture uploads, not duplicated by sharing. textShareCount and textSavedBytes are the same counters for text
+   * textures.
+   *
+   * @type {Object}
+   */
+  get stats () {
+    return this._native.getStats()
+  }
+
+  /**
+   * @ignore
+   */
+  $attach () {
+    // scenes attach the native image manager to their renderer
+  }
+
+  /**
+   * @ignore
+   */
+  $detach () {
+    // scenes detach the native image manager
+  }
+
+  /**
+   * @ignore
+   */
+  $destroy () {
+    if (!this._native) {
+      return
+    }
+
+    this._native.destroy()
+    this._native = null
+  }
+
   /**
    * @ignore
    */
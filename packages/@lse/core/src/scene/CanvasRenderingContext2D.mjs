@@ -0,0 +1,449 @@
+/*
+ * Copyright (c) 2021 Light Source Software, LLC. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on
+ * an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the
+ * specific language governing permissions and limitations under the License.
+ */
+
+import { CanvasCommand, parseColor } from '../addon/index.mjs'
+
+const {
+  BEGIN_PATH,
+  CLOSE_PATH,
+  MOVE_TO,
+  LINE_TO,
+  BEZIER_CURVE_TO,
+  QUADRATIC_CURVE_TO,
+  ARC,
+  RECT,
+  FILL,
+  STROKE,
+  FILL_RECT,
+  STROKE_RECT,
+  DRAW_IMAGE,
+  SET_FILL_STYLE,
+  SET_STROKE_STYLE,
+  SET_LINE_WIDTH,
+  SET_LINE_CAP,
+  SET_LINE_JOIN,
+  SET_MITER_LIMIT,
+  SET_GLOBAL_ALPHA,
+  SAVE,
+  RESTORE,
+  TRANSLATE,
+  ROTATE,
+  SCALE,
+  TRANSFORM,
+  SET_TRANSFORM
+} = CanvasCommand
+
+const kLineCap = new Map([['butt', 0], ['round', 1], ['square', 2]])
+const kLineJoin = new Map([['miter', 0], ['round', 1], ['bevel', 2]])
+const kFillRule = new Map([['nonzero', 0], ['evenodd', 1]])
+const kInitialCapacity = 256
+
+/**
+ * Records CanvasRenderingContext2D style drawing commands for a CanvasSceneNode.
+ *
+ * Drawing calls are recorded into a command buffer. Nothing is sent to the native node until commit() is called, at
+ * which point the whole drawing is transferred in a single native call. The native node keeps the drawing and
+ * rasterizes it again only when a new drawing is committed or the node is resized.
+ *
+ * fillStyle and strokeStyle accept css color strings or 0xAARRGGBB numbers. drawImage() accepts an image uri
+ * string or an object with a uri property.
+ *
+ * @memberof module:@lse/core
+ * @hideconstructor
+ */
+class CanvasRenderingContext2D {
+  _node = null
+  _buffer = new Float64Array(kInitialCapacity)
+  _length = 0
+  _images = []
+  _stack = []
+  _fillStyle = 'black'
+  _strokeStyle = 'black'
+  _lineWidth = 1
+  _lineCap = 'butt'
+  _lineJoin = 'miter'
+  _miterLimit = 10
+  _globalAlpha = 1
+
+  constructor (node) {
+    this._node = node
+  }
+
+  /**
+   * @returns {module:@lse/core.CanvasSceneNode} The node this context draws to.
+   */
+  get canvas () {
+    return this._node
+  }
+
+  get fillStyle () {
+    return this._fillStyle
+  }
+
+  set fillStyle (value) {
+    const color = toColor(value)
+
+    if (color !== undefined) {
+      this._fillStyle = value
+      this._push1(SET_FILL_STYLE, color)
+    }
+  }
+
+  get strokeStyle () {
+    return this._strokeStyle
+  }
+
+  set strokeStyle (value) {
+    const color = toColor(value)
+
+    if (color !== undefined) {
+      this._strokeStyle = value
+      this._push1(SET_STROKE_STYLE, color)
+    }
+  }
+
+  get lineWidth () {
+    return this._lineWidth
+  }
+
+  set lineWidth (value) {
+    if (isPositive(value)) {
+      this._lineWidth = value
+      this._push1(SET_LINE_WIDTH, value)
+    }
+  }
+
+  get lineCap () {
+    return this._lineCap
+  }
+
+  set lineCap (value) {
+    if (kLineCap.has(value)) {
+      this._lineCap = value
+      this._push1(SET_LINE_CAP, kLineCap.get(value))
+    }
+  }
+
+  get lineJoin () {
+    return this._lineJoin
+  }
+
+  set lineJoin (value) {
+    if (kLineJoin.has(value)) {
+      this._lineJoin = value
+      this._push1(SET_LINE_JOIN, kLineJoin.get(value))
+    }
+  }
+
+  get miterLimit () {
+    return this._miterLimit
+  }
+
+  set miterLimit (value) {
+    if (isPositive(value)) {
+      this._miterLimit = value
+      this._push1(SET_MITER_LIMIT, value)
+    }
+  }
+
+  get globalAlpha () {
+    return this._globalAlpha
+  }
+
+  set globalAlpha (value) {
+    if (Number.isFinite(value) && value >= 0 && value <= 1) {
+      this._globalAlpha = value
+      this._push1(SET_GLOBAL_ALPHA, value)
+    }
+  }
+
+  save () {
+    const { _fillStyle, _strokeStyle, _lineWidth, _lineCap, _lineJoin, _miterLimit, _globalAlpha } = this
+
+    this._stack.push([_fillStyle, _strokeStyle, _lineWidth, _lineCap, _lineJoin, _miterLimit, _globalAlpha])
+    this._push0(SAVE)
+  }
+
+  restore () {
+    const state = this._stack.pop()
+
+    if (state) {
+      [this._fillStyle, this._strokeStyle, this._lineWidth, this._lineCap, this._lineJoin, this._miterLimit,
+        this._globalAlpha] = state
+      this._push0(RESTORE)
+    }
+  }
+
+  beginPath () {
+    this._push0(BEGIN_PATH)
+  }
+
+  closePath () {
+    this._push0(CLOSE_PATH)
+  }
+
+  moveTo (x, y) {
+    this._push2(MOVE_TO, x, y)
+  }
+
+  lineTo (x, y) {
+    this._push2(LINE_TO, x, y)
+  }
+
+  bezierCurveTo (cp1x, cp1y, cp2x, cp2y, x, y) {
+    this._push6(BEZIER_CURVE_TO, cp1x, cp1y, cp2x, cp2y, x, y)
+  }
+
+  quadraticCurveTo (cpx, cpy, x, y) {
+    this._push4(QUADRATIC_CURVE_TO, cpx, cpy, x, y)
+  }
+
+  arc (x, y, radius, startAngle, endAngle, counterclockwise = false) {
+    this._push6(ARC, x, y, radius, startAngle, endAngle, counterclockwise ? 1 : 0)
+  }
+
+  rect (x, y, width, height) {
+    this._push4(RECT, x, y, width, height)
+  }
+
+  fill (fillRule = 'nonzero') {
+    this._push1(FILL, kFillRule.get(fillRule) ?? 0)
+  }
+
+  stroke () {
+    this._push0(STROKE)
+  }
+
+  fillRect (x, y, width, height) {
+    this._push4(FILL_RECT, x, y, width, height)
+  }
+
+  strokeRect (x, y, width, height) {
+    this._push4(STROKE_RECT, x, y, width, height)
+  }
+
+  /**
+   * Draw an image. Supports the (image, dx, dy), (image, dx, dy, dw, dh) and
+   * (image, sx, sy, sw, sh, dx, dy, dw, dh) forms of the canvas api.
+   *
+   * Images are drawn by the renderer, so rotate and skew transforms are not applied to images.
+   */
+  drawImage (image, ...args) {
+    const uri = typeof image === 'string' ? image : image?.uri
+
+    if (!uri || typeof uri !== 'string') {
+      return
+    }
+
+    let sx = 0
+    let sy = 0
+    let sw = -1
+    let sh = -1
+    let dx
+    let dy
+    let dw = -1
+    let dh = -1
+
+    switch (args.length) {
+      case 2:
+        [dx, dy] = args
+        break
+      case 4:
+        [dx, dy, dw, dh] = args
+        break
+      case 8:
+        [sx, sy, sw, sh, dx, dy, dw, dh] = args
+        break
+      default:
+        return
+    }
+
+    if (!isFinite2(sx, sy) || !isFinite2(sw, sh) || !isFinite2(dx, dy) || !isFinite2(dw, dh)) {
+      return
+    }
+
+    let index = this._images.indexOf(uri)
+
+    if (index < 0) {
+      index = this._images.push(uri) - 1
+    }
+
+    this._ensure(10)
+
+    const { _buffer } = this
+    let i = this._length
+
+    _buffer[i++] = DRAW_IMAGE
+    _buffer[i++] = index
+    _buffer[i++] = sx
+    _buffer[i++] = sy
+    _buffer[i++] = sw
+    _buffer[i++] = sh
+    _buffer[i++] = dx
+    _buffer[i++] = dy
+    _buffer[i++] = dw
+    _buffer[i++] = dh
+
+    this._length = i
+  }
+
+  translate (x, y) {
+    this._push2(TRANSLATE, x, y)
+  }
+
+  rotate (angle) {
+    this._push1(ROTATE, angle)
+  }
+
+  scale (x, y) {
+    this._push2(SCALE, x, y)
+  }
+
+  transform (a, b, c, d, e, f) {
+    this._push6(TRANSFORM, a, b, c, d, e, f)
+  }
+
+  setTransform (a, b, c, d, e, f) {
+    this._push6(SET_TRANSFORM, a, b, c, d, e, f)
+  }
+
+  resetTransform () {
+    this._push6(SET_TRANSFORM, 1, 0, 0, 1, 0, 0)
+  }
+
+  /**
+   * Discard all recorded commands and reset the drawing state to defaults.
+   *
+   * The drawing currently displayed by the node is not affected until commit() is called.
+   */
+  reset () {
+    this._length = 0
+    this._images = []
+    this._stack = []
+    this._fillStyle = this._strokeStyle = 'black'
+    this._lineWidth = 1
+    this._lineCap = 'butt'
+    this._lineJoin = 'miter'
+    this._miterLimit = 10
+    this._globalAlpha = 1
+  }
+
+  /**
+   * Send the recorded commands to the node, replacing the current drawing.
+   */
+  commit () {
+    this._node.$native.setCommands(this._buffer.subarray(0, this._length), this._images)
+  }
+
+  _ensure (count) {
+    const { _buffer, _length } = this
+
+    if (_length + count > _buffer.length) {
+      const buffer = new Float64Array(Math.max(_buffer.length * 2, _length + count))
+
+      buffer.set(_buffer.subarray(0, _length))
+      this._buffer = buffer
+    }
+  }
+
+  _push0 (command) {
+    this._ensure(1)
+    this._buffer[this._length++] = command
+  }
+
+  _push1 (command, a) {
+    if (!Number.isFinite(a)) {
+      return
+    }
+
+    this._ensure(2)
+
+    const { _buffer } = this
+    const i = this._length
+
+    _buffer[i] = command
+    _buffer[i + 1] = a
+    this._length = i + 2
+  }
+
+  _push2 (command, a, b) {
+    if (!isFinite2(a, b)) {
+      return
+    }
+
+    this._ensure(3)
+
+    const { _buffer } = this
+    const i = this._length
+
+    _buffer[i] = command
+    _buffer[i + 1] = a
+    _buffer[i + 2] = b
+    this._length = i + 3
+  }
+
+  _push4 (command, a, b, c, d) {
+    if (!isFinite2(a, b) || !isFinite2(c, d)) {
+      return
+    }
+
+    this._ensure(5)
+
+    const { _buffer } = this
+    const i = this._length
+
+    _buffer[i] = command
+    _buffer[i + 1] = a
+    _buffer[i + 2] = b
+    _buffer[i + 3] = c
+    _buffer[i + 4] = d
+    this._length = i + 5
+  }
+
+  _push6 (command, a, b, c, d, e, f) {
+    if (!isFinite2(a, b) || !isFinite2(c, d) || !isFinite2(e, f)) {
+      return
+    }
+
+    this._ensure(7)
+
+    const { _buffer } = this
+    const i = this._length
+
+    _buffer[i] = command
+    _buffer[i + 1] = a
+    _buffer[i + 2] = b
+    _buffer[i + 3] = c
+    _buffer[i + 4] = d
+    _buffer[i + 5] = e
+    _buffer[i + 6] = f
+    this._length = i + 7
+  }
+}
+
+// Like the canvas api, drawing calls with non-finite arguments are ignored.
+const isFinite2 = (a, b) => Number.isFinite(a) && Number.isFinite(b)
+
+const toColor = (value) => {
+  if (typeof value === 'string') {
+    return parseColor(value)
+  } else if (Number.isInteger(value)) {
+    return value >>> 0
+  }
+
+  return undefined
+}
+
+const isPositive = (value) => Number.isFinite(value) && value > 0
+
+export { CanvasRenderingContext2D }
@@ -12,11 +12,21 @@
  */
 
 import { CScene } from '../addon/index.mjs'
-import { BoxSceneNode, ImageSceneNode, TextSceneNode, RootSceneNode } from './SceneNode.mjs'
+import {
+  BoxSceneNode,
+  CanvasSceneNode,
+  ImageSceneNode,
+  ListSceneNode,
+  PixelSceneNode,
+  TextSceneNode,
+  RootSceneNode
+} from './SceneNode.mjs'
+import { SceneCommandBuffer } from './SceneCommandBuffer.mjs'
+import { SceneLayer } from './SceneLayer.mjs'
+import { IntersectionObserver, ResizeObserver } from './SceneObserver.mjs'
 import { createAttachedEvent, createDestroyedEvent, createDestroyingEvent, createDetachedEvent } from '../event/index.mjs'
 import { EventName } from '../event/EventName.mjs'
 import { EventTarget } from '../event/EventTarget.mjs'
-import { ImageManager } from '../image/ImageManager.mjs'
 
 const kEmptyFrameListener = Object.freeze([0, null])
 let sFrameRequestId = 0
@@ -30,14 +40,28 @@ let sFrameRequestId = 0
  */
 class Scene extends EventTarget {
   _native = null
+  _commands = null
   _context = null
   _root = null
+  _baseLayer = null
+  // Layers created by createLayer(), in creation order.
+  _layers = []
   _stage = null
   _activeNode = null
+  // Live nodes by id. Maps the node ids returned by native queries back to nodes.
+  _nodes = new Map()
+  // Output buffer of native getGeometry() calls.
+  _geometry = new Float32Array(10)
   _fgFrameListeners = []
   _bgFrameListeners = []
   _attached = false
-  _imageManager = new ImageManager()
+  // Lists whose range changed while the native scene updated. Bound before the frame is painted.
+  _bindBeforePaint = new Set()
+  _rendering = false
+  // Observers created by createResizeObserver() and createIntersectionObserver(), by id.
+  _observers = new Map()
+  // Shared by the scenes of the graphics context.
+  _imageManager = null
 
   constructor (stage, config) {
     super([
@@ -49,7 +73,9 @@ class Scene extends EventTarget {
 
     this._stage = stage
     this._context = stage.system.$createGraphicsContext(config)
+    this._imageManager = stage.$acquireImageManager(this._context)
     this._native = new CScene(stage.$native, stage.font.$native, this._imageManager.$native, this._context)
+    this._commands = new SceneCommandBuffer(this._native)
     this._root = new RootSceneNode(this)
     const { style } = this._root
 
@@ -61,6 +87,7 @@ class Scene extends EventTarget {
     style.position = 'absolute'
 
     this._native.setRoot(this._root.$native)
+    this._baseLayer = new SceneLayer(this, this._root, 0)
 
     if (typeof config?.title === 'string') {
       this.title = config.title
@@ -75,6 +102,82 @@ class Scene extends EventTarget {
     return this._root
   }
 
+  /**
+   * Layer of the main tree (root), at zIndex 0.
+   *
+   * @type {module:@lse/core.SceneLayer}
+   */
+  get baseLayer () {
+    return this._baseLayer
+  }
+
+  /**
+   * All layers, including the base layer, in composite order.
+   *
+   * @type {Array<module:@lse/core.SceneLayer>}
+   */
+  get layers () {
+    // Array sort is stable: layers with equal zIndex stay in creation order, after the base layer.
+    return [this._baseLayer, ...this._layers].sort((a, b) => a.zIndex - b.zIndex)
+  }
+
+  /**
+   * Create a layer: a new scene graph root composited over (or under) the main tree.
+   *
+   * Changes to the nodes of a layer only dirty that layer. See SceneLayer.
+   *
+   * @param options {Object}
+   * @param options.zIndex {number} composite order of the layer; default 1 (over the main tree)
+   * @param options.cached {boolean} composite the layer into its own render target; default false
+   * @returns {module:@lse/core.SceneLayer} the new layer. Add nodes to its root.
+   */
+  createLayer ({ zIndex = 1, cached = false } = {}) {
+    const root = this.createNode('box')
+    const { style } = root
+    const layer = new SceneLayer(this, root, Number.isInteger(zIndex) ? zIndex : 1)
+
+    style.top = 0
+    style.right = 0
+    style.bottom = 0
+    style.left = 0
+    style.position = 'absolute'
+
+    this._native.addLayer(root.$id, layer.zIndex)
+    this._layers.push(layer)
+    layer.cached = cached
+
+    return layer
+  }
+
+  /**
+   * Create an observer of the layout size of nodes.
+   *
+   * The callback is called after a frame is rendered with an entry, { target, width, height }, for each observed
+   * node whose size changed in the frame.
+   *
+   * @param callback {function(Object[], module:@lse/core.ResizeObserver)}
+   * @returns {module:@lse/core.ResizeObserver}
+   */
+  createResizeObserver (callback) {
+    return this.$addObserver(new ResizeObserver(this, callback))
+  }
+
+  /**
+   * Create an observer of the visibility of nodes in the viewport.
+   *
+   * The callback is called after a frame is rendered with an entry for each observed node whose visible fraction
+   * crossed a threshold in the frame. See IntersectionObserver.
+   *
+   * @param callback {function(Object[], module:@lse/core.IntersectionObserver)}
+   * @param options {Object}
+   * @param options.threshold {number|number[]} visible fractions, 0 to 1, that trigger the callback when crossed;
+   * default 0 (the node enters or leaves the viewport)
+   * @returns {module:@lse/core.IntersectionObserver}
+   */
+  createIntersectionObserver (callback, { threshold = 0 } = {}) {
+    return this.$addObserver(new IntersectionObserver(this, callback, threshold))
+  }
+
   get image () {
     return this._imageManager
   }
@@ -107,6 +210,108 @@ class Scene extends EventTarget {
     this._context.setTitle(value)
   }
 
+  /**
+   * Maximum time, in milliseconds, spent painting (rasterizing text, canvas drawings, etc) per frame. Paints that do
+   * not fit in the budget are deferred to later frames. 0 means no limit.
+   */
+  get paintBudget () {
+    return this._native.getPaintBudget()
+  }
+
+  set paintBudget (value) {
+    this._native.setPaintBudget(Number.isFinite(value) && value > 0 ? value : 0)
+  }
+
+  get nodePoolStats () {
+    return this._native.getNodePoolStats()
+  }
+
+  /**
+   * Per phase work counters of the most recent frames (up to 60), oldest first.
+   *
+   * Each entry has the frame number, the node counts of the layout, compute style, paint and composite phases, the
+   * number of nodes culled by composite, the number of layout-only nodes composite passed through without drawing,
+   * the renderer's draw calls, texture uploads and state changes, and the frame time in microseconds. Stats are
+   * always collected, so tests and apps can watch them for regressions.
+   *
+   * @type {Array<Object>}
+   */
+  get frameStats () {
+    return this._native.getFrameStats()
+  }
+
+  /**
+   * Cost of the most recent attach.
+   *
+   * attachTime is the time, in microseconds, spent in the native attach, including texture uploads from image
+   * shadows (see ImageManager.shadowLimit). imageUploadCount is the number of images restored from shadows and
+   * imageLoadCount is the number of images queued to load and decode again after attach.
+   *
+   * @type {Object}
+   */
+  get attachStats () {
+    return this._native.getAttachStats()
+  }
+
+  /**
+   * Find the top most visible node at a screen point.
+   *
+   * The query runs against native cached node geometry, so it costs one call regardless of the depth of the tree.
+   *
+   * @param x {number} screen x coordinate, in pixels
+   * @param y {number} screen y coordinate, in pixels
+   * @returns {module:@lse/core.SceneNode} the node at x, y or null
+   */
+  hitTest (x, y) {
+    this._commands.flush()
+
+    return this._nodes.get(this._native.hitTest(x, y)) ?? null
+  }
+
+  /**
+   * Record the scene into a binary snapshot, for loadSnapshot() in a later process.
+   *
+   * The snapshot is the draw list of a composite: backgrounds, borders and images, with layout, styles, transforms
+   * and opacity already applied. Images are referenced by uri. Text, canvas and pixel nodes are not recorded. Call
+   * after a frame, so the snapshot reflects the computed styles of the current scene graph.
+   *
+   * @returns {Buffer} snapshot bytes
+   */
+  saveSnapshot () {
+    this._commands.flush()
+
+    return this._native.saveSnapshot()
+  }
+
+  /**
+   * Show a snapshot in place of the scene graph, until releaseSnapshot() is called.
+   *
+   * The snapshot is drawn natively from the first frame, without layout or style computation. The app builds its
+   * scene graph as usual while the snapshot is shown and calls releaseSnapshot() when the graph is ready to be shown.
+   *
+   * @param data {ArrayBuffer|TypedArray} snapshot bytes from saveSnapshot()
+   * @throws Error if data is not a valid snapshot
+   */
+  loadSnapshot (data) {
+    this._native.loadSnapshot(data)
+  }
+
+  /**
+   * Stop showing a snapshot. The next frame composites the scene graph.
+   */
+  releaseSnapshot () {
+    this._native.releaseSnapshot()
+  }
+
+  /**
+   * Is a snapshot shown in place of the scene graph?
+   *
+   * @type {boolean}
+   */
+  get hasSnapshot () {
+    return this._native.hasSnapshot()
+  }
+
   get activeNode () {
     return this._activeNode
   }
@@ -161,7 +366,60 @@ class Scene extends EventTarget {
       this._bgFrameListeners.length = 0
     }
 
-    this._native.render(tick, lastTick)
+    const commands = this._commands
+    const native = this._native
+    let hasObserverRecords
+
+    commands.flush()
+    commands.deferFlush = this._rendering = true
+
+    try {
+      native.update(tick, lastTick)
+
+      if (this._bindBeforePaint.size) {
+        this._bindPendingLists()
+        // Lay out the bound items, so they are painted in this frame rather than the next.
+        native.update(tick, lastTick)
+      }
+
+      hasObserverRecords = native.render(tick, lastTick)
+    } finally {
+      commands.deferFlush = this._rendering = false
+    }
+
+    if (hasObserverRecords) {
+      this.$deliverObserverRecords()
+    }
+  }
+
+  _bindPendingLists () {
+    const commands = this._commands
+
+    // The native scene is between update() and render(), where the scene graph can be mutated. The commands of the
+    // binds are applied right away, so the next update() lays out the bound items.
+    commands.deferFlush = false
+
+    for (const list of this._bindBeforePaint) {
+      list.$native && list.$bindRange()
+    }
+
+    this._bindBeforePaint.clear()
+    commands.flush()
+    commands.deferFlush = true
+  }
+
+  /**
+   * @ignore
+   */
+  get $isRendering () {
+    return this._rendering
+  }
+
+  /**
+   * @ignore
+   */
+  $bindBeforePaint (list) {
+    this._bindBeforePaint.add(list)
   }
 
   /**
@@ -211,11 +469,26 @@ class Scene extends EventTarget {
 
     this._fgFrameListeners = []
     this._fgFrameListeners = []
+    this._bindBeforePaint.clear()
     this._activeNode = null
+
+    for (const observer of [...this._observers.values()]) {
+      observer.disconnect()
+    }
+
+    for (const layer of [...this._layers]) {
+      this.$destroyLayer(layer)
+    }
+
     this._root?.destroy()
     this._root = null
+    this._commands?.flush()
+    this._commands = null
+    this._nodes.clear()
     this._native?.destroy()
     this._native = null
+    this._stage.$releaseImageManager(this._context)
+    this._imageManager = null
     this._context = null
     this._stage = null
 
@@ -230,11 +503,133 @@ class Scene extends EventTarget {
   get $native () {
     return this._native
   }
+
+  /**
+   * @ignore
+   */
+  get $commands () {
+    return this._commands
+  }
+
+  /**
+   * @ignore
+   */
+  get $nodes () {
+    return this._nodes
+  }
+
+  /**
+   * @ignore
+   */
+  $hasLayer (node) {
+    return this._layers.some(layer => layer.root === node)
+  }
+
+  /**
+   * @ignore
+   */
+  $addObserver (observer) {
+    this._observers.set(observer.$id, observer)
+
+    return observer
+  }
+
+  /**
+   * @ignore
+   */
+  $disconnectObserver (observer) {
+    if (this._observers.delete(observer.$id)) {
+      this._native.removeObserver(observer.$id)
+    }
+  }
+
+  /**
+   * @ignore
+   */
+  $deliverObserverRecords () {
+    const recordsByObserver = new Map()
+
+    // Records are in evaluation order. Group them, so each observer is called once per frame.
+    for (const record of this._native.takeObserverRecords()) {
+      const records = recordsByObserver.get(record.observerId)
+
+      records ? records.push(record) : recordsByObserver.set(record.observerId, [record])
+    }
+
+    for (const [id, records] of recordsByObserver) {
+      try {
+        this._observers.get(id)?.$deliver(records, this._nodes)
+      } catch (e) {
+        // TODO: exception in user callback.. log?
+      }
+    }
+  }
+
+  /**
+   * @ignore
+   */
+  $destroyLayer (layer) {
+    if (layer === this._baseLayer) {
+      throw Error('The base layer cannot be destroyed.')
+    }
+
+    const index = this._layers.indexOf(layer)
+
+    if (index < 0) {
+      return
+    }
+
+    const { root } = layer
+
+    this._layers.splice(index, 1)
+    this._native.removeLayer(root.$id)
+    layer._root = null
+
+    root.destroy()
+  }
+
+  /**
+   * @ignore
+   */
+  $getBounds (node) {
+    const { _geometry } = this
+
+    // The native scene must see pending mutations.
+    this._commands.flush()
+
+    if (!this._native.getGeometry(node.$id, _geometry)) {
+      return null
+    }
+
+    return { x: _geometry[0], y: _geometry[1], width: _geometry[2], height: _geometry[3] }
+  }
+
+  /**
+   * Find the focusable node nearest to a node in a direction, using the native scene's spatial index of focusable
+   * nodes.
+   *
+   * @param from {SceneNode} origin of the move. If null, the first focusable node in within is returned.
+   * @param direction {Direction} direction of the move
+   * @param within {SceneNode} if set, only focusable nodes in the subtree of within are considered
+   * @returns {SceneNode} the nearest focusable node in direction or null
+   * @ignore
+   */
+  $findFocus (from, direction, within = null) {
+    // The native scene must see pending mutations, including focusable changes.
+    this._commands.flush()
+
+    const id = this._native.findFocus(from?.$id ?? 0, direction, within?.$id ?? 0)
+
+    return this._nodes.get(id) ?? null
+  }
 }
 
 const nodeClass = new Map([
   ['box', BoxSceneNode],
+  ['canvas', CanvasSceneNode],
   ['img', ImageSceneNode],
+  ['list', ListSceneNode],
+  ['pixels', PixelSceneNode],
   ['text', TextSceneNode]
 ])
 
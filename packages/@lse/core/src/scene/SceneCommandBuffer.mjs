@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) 2021 Light Source Software, LLC. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on
+ * an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the
+ * specific language governing permissions and limitations under the License.
+ */
+
+import { SceneCommand } from '../addon/index.mjs'
+
+const {
+  APPEND_CHILD,
+  INSERT_BEFORE,
+  REMOVE_CHILD,
+  SET_HIDDEN,
+  DESTROY,
+  SET_FOCUSABLE
+} = SceneCommand
+
+// Words per command: the command and 3 node id arguments. Must match kSceneCommandSize in Scene.h.
+const kCommandSize = 4
+const kCapacity = 1024 * kCommandSize
+
+/**
+ * Records scene graph mutations for the native Scene.
+ *
+ * Mutations are written to a Uint32Array as commands with node ids for arguments. The whole buffer is applied by the
+ * native Scene in one call (flush()) before a frame is rendered, rather than crossing into native for every
+ * appendChild, insertBefore, etc. When the buffer is full, it is flushed early, so command order is preserved. While
+ * deferFlush is set (the native Scene is rendering), a full buffer grows instead, so commands are never applied
+ * mid-frame.
+ *
+ * Callers validate arguments before recording, as errors from the native side are not reported until flush().
+ *
+ * @ignore
+ */
+export class SceneCommandBuffer {
+  _scene
+  _buffer = new Uint32Array(kCapacity)
+  _length = 0
+  // Native nodes referenced by pending commands. Keeps them alive (not garbage collected) until the flush.
+  _natives = []
+  // Set by Scene while the native Scene renders.
+  deferFlush = false
+
+  constructor (scene) {
+    this._scene = scene
+  }
+
+  get length () {
+    return this._length / kCommandSize
+  }
+
+  appendChild (parent, child) {
+    this._push(APPEND_CHILD, parent, child, null)
+  }
+
+  insertBefore (parent, child, before) {
+    this._push(INSERT_BEFORE, parent, child, before)
+  }
+
+  removeChild (parent, child) {
+    this._push(REMOVE_CHILD, parent, child, null)
+  }
+
+  setHidden (node, hidden) {
+    this._push(SET_HIDDEN, node, null, null)
+    this._buffer[this._length - kCommandSize + 2] = hidden ? 1 : 0
+  }
+
+  setFocusable (node, focusable) {
+    this._push(SET_FOCUSABLE, node, null, null)
+    this._buffer[this._length - kCommandSize + 2] = focusable ? 1 : 0
+  }
+
+  destroy (node) {
+    this._push(DESTROY, node, null, null)
+  }
+
+  /**
+   * Apply the recorded commands to the native Scene.
+   */
+  flush () {
+    const { _length, _natives } = this
+
+    if (!_length) {
+      return
+    }
+
+    // Reset first, so a failed command does not leave the buffer wedged.
+    this._length = 0
+
+    try {
+      this._scene.applyCommands(this._buffer.subarray(0, _length))
+    } finally {
+      _natives.length = 0
+    }
+  }
+
+  _push (command, a, b, c) {
+    if (this._length === this._buffer.length) {
+      if (this.deferFlush) {
+        this._grow()
+      } else {
+        this.flush()
+      }
+    }
+
+    const { _buffer, _natives } = this
+    const i = this._length
+
+    _buffer[i] = command
+    _buffer[i + 1] = a.$id
+    _natives.push(a.$native)
+
+    if (b) {
+      _buffer[i + 2] = b.$id
+      _natives.push(b.$native)
+    } else {
+      _buffer[i + 2] = 0
+    }
+
+    if (c) {
+      _buffer[i + 3] = c.$id
+      _natives.push(c.$native)
+    } else {
+      _buffer[i + 3] = 0
+    }
+
+    this._length = i + kCommandSize
+  }
+
+  _grow () {
+    const buffer = new Uint32Array(this._buffer.length + kCapacity)
+
+    buffer.set(this._buffer)
+    this._buffer = buffer
+  }
+}
@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2021 Light Source Software, LLC. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on
+ * an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the
+ * specific language governing permissions and limitations under the License.
+ */
+
+/**
+ * A root of the scene graph composited independently of the other layers.
+ *
+ * Overlays (toasts, FPS counters, cursors, modals) go in their own layer, so changes to them do not dirty the main
+ * tree. Layers are composited in ascending zIndex order; the main tree (Scene.root) is the base layer, at zIndex 0.
+ *
+ * A cached layer is composited into its own render target and redrawn only when a node in it changes. Caching the
+ * base layer lets an animating overlay recomposite over it at the cost of one full screen texture draw.
+ *
+ * @memberof module:@lse/core
+ * @hideconstructor
+ */
+class SceneLayer {
+  _scene
+  _root
+  _zIndex
+  _cached = false
+
+  constructor (scene, root, zIndex) {
+    this._scene = scene
+    this._root = root
+    this._zIndex = zIndex
+  }
+
+  /**
+   * Root node of this layer. The root fills the viewport.
+   *
+   * @type {module:@lse/core.SceneNode}
+   */
+  get root () {
+    return this._root
+  }
+
+  /**
+   * Composite order of this layer. Layers with equal zIndex are composited in creation order.
+   *
+   * @type {number}
+   */
+  get zIndex () {
+    return this._zIndex
+  }
+
+  set zIndex (value) {
+    value = Number.isInteger(value) ? value : 0
+
+    if (value !== this._zIndex && this._root) {
+      this._scene.$native.setLayerZIndex(this._root.$id, value)
+      this._zIndex = value
+    }
+  }
+
+  /**
+   * If true, this layer is composited into its own render target and redrawn only when a node in it changes.
+   *
+   * Costs a screen sized texture. Use for layers that change less often than the layers above them.
+   *
+   * @type {boolean}
+   */
+  get cached () {
+    return this._cached
+  }
+
+  set cached (value) {
+    value = !!value
+
+    if (value !== this._cached && this._root) {
+      this._scene.$native.setLayerCached(this._root.$id, value)
+      this._cached = value
+    }
+  }
+
+  /**
+   * Remove this layer from the scene and destroy its nodes. The base layer cannot be destroyed.
+   */
+  destroy () {
+    this._scene.$destroyLayer(this)
+  }
+}
+
+export { SceneLayer }
@@ -14,12 +14,17 @@
 import { createBlurEvent, createFocusEvent } from '../event/index.mjs'
 import {
   CBoxSceneNode,
+  CCanvasSceneNode,
   CImageSceneNode,
+  CListSceneNode,
+  CPixelSceneNode,
   CRootSceneNode,
   CTextSceneNode,
+  PixelFormat,
   setStyleParent
 } from '../addon/index.mjs'
 import { StyleInstance } from '../style/StyleInstance.mjs'
+import { CanvasRenderingContext2D } from './CanvasRenderingContext2D.mjs'
 import { emptyArray } from '../util/index.mjs'
 
 /**
@@ -27,7 +32,6 @@ import { emptyArray } from '../util/index.mjs'
  * @hideconstructor
  */
 class SceneNode {
-  focusable = false
   onKeyUp = null
   onKeyDown = null
   onFocus = null
@@ -35,16 +39,20 @@ class SceneNode {
   onFocusIn = null
   onFocusOut = null
   _hasFocus = false
+  _focusable = false
   _parent = null
   _scene = null
   _style = null
   _class = null
   _children = emptyArray
   _native
+  _id = 0
 
   constructor (scene, native) {
     this._native = native
+    this._id = native.getId()
     this._scene = scene
+    scene.$nodes.set(this._id, this)
 
     if (!this.isLeaf()) {
       this._children = []
@@ -97,6 +105,37 @@ class SceneNode {
     return this._children
   }
 
+  /**
+   * If true, this node can receive focus.
+   *
+   * Focusable nodes are also indexed by the native scene for spatial (waypoint('spatial')) navigation.
+   *
+   * @type {boolean}
+   */
+  get focusable () {
+    return this._focusable
+  }
+
+  set focusable (value) {
+    value = !!value
+
+    if (value !== this._focusable && this._native) {
+      this._focusable = value
+      this._scene.$commands.setFocusable(this, value)
+    }
+  }
+
+  /**
+   * Get the screen-space bounding box of this node.
+   *
+   * Computed from native cached geometry (layout, transforms and scroll offsets of ancestors) in one call.
+   *
+   * @returns {Object} { x, y, width, height } in pixels; null if this node is not attached to the scene graph
+   */
+  getBounds () {
+    return this._native ? this._scene.$getBounds(this) : null
+  }
+
   /**
    * Sets focus to this node.
    *
@@ -164,8 +203,9 @@ class SceneNode {
 
   appendChild (node) {
     this.isLeaf() && throwAddChildError()
+    this._isValidChild(node) || throwChildArgError()
 
-    nativeAppendChild(this._native, node?._native)
+    this._scene.$commands.appendChild(this, node)
     this._children.push(node)
     node._parent = this
   }
@@ -173,22 +213,24 @@ class SceneNode {
   insertBefore (node, before) {
     this.isLeaf() && throwAddChildError()
 
-    const { _children, _native } = this
+    this._isValidChild(node) || throwChildArgError()
+
+    const { _children } = this
     const index = _children.findIndex(value => value === before)
 
     index >= 0 || throwBeforeArgError()
 
-    _native.insertBefore(node?._native, before?._native)
+    this._scene.$commands.insertBefore(this, node, before)
     _children.splice(index, 0, node)
     node._parent = this
   }
 
   removeChild (node) {
-    const { _children, _native } = this
+    const { _children } = this
     const index = _children.findIndex(value => value === node)
 
     if (index !== -1) {
-      nativeRemoveChild(_native, node._native)
+      this._scene.$commands.removeChild(this, node)
       _children[index]._parent = null
       _children.splice(index, 1)
     }
@@ -227,11 +269,27 @@ class SceneNode {
     return this._native
   }
 
+  /**
+   * @ignore
+   */
+  get $id () {
+    return this._id
+  }
+
+  /**
+   * @ignore
+   */
+  _isValidChild (node) {
+    // Mutations are applied by the native scene later, so check here what the native scene would reject.
+    return node instanceof SceneNode && !(node instanceof RootSceneNode) && node !== this && !node._parent &&
+      node._native && node._scene === this._scene && !this._scene.$hasLayer(node)
+  }
+
   /**
    * @ignore
    */
   _destroy () {
-    const { _parent, _children, _native } = this
+    const { _parent, _children, _scene } = this
 
     _parent?.removeChild(this)
 
@@ -239,7 +297,8 @@ class SceneNode {
       _children[_children.length - 1]._destroy()
     }
 
-    nativeDestroy(_native)
+    _scene.$commands.destroy(this)
+    _scene.$nodes.delete(this._id)
 
     this._children = emptyArray
     this._scene = this._style = this._class = this._native = null
@@ -362,10 +421,376 @@ class TextSceneNode extends SceneNode {
   }
 }
 
+/**
+ * Node that displays a retained 2D drawing.
+ *
+ * Drawing commands are recorded with the node's CanvasRenderingContext2D and committed to native code in a single
+ * call. The drawing is rasterized natively only when a new drawing is committed or the node's size changes.
+ *
+ * @memberof module:@lse/core
+ * @extends module:@lse/core.SceneNode
+ * @hideconstructor
+ */
+class CanvasSceneNode extends SceneNode {
+  _context = null
+
+  constructor (scene) {
+    super(scene, new CCanvasSceneNode(scene.$native))
+  }
+
+  /**
+   * Get the drawing context of this node.
+   *
+   * @param {string} [contextId='2d'] Only '2d' is supported.
+   * @returns {module:@lse/core.CanvasRenderingContext2D|null}
+   */
+  getContext (contextId = '2d') {
+    if (contextId !== '2d') {
+      return null
+    }
+
+    return this._context || (this._context = new CanvasRenderingContext2D(this))
+  }
+
+  /**
+   * Replace the drawing of this node.
+   *
+   * The context is reset, the callback records the new drawing and the result is committed in one native call.
+   *
+   * @param {function(module:@lse/core.CanvasRenderingContext2D)} callback
+   */
+  draw (callback) {
+    const context = this.getContext()
+
+    context.reset()
+    callback(context)
+    context.commit()
+  }
+
+  /**
+   * Remove the drawing from this node.
+   */
+  clear () {
+    this._context?.reset()
+    this._native.setCommands(null)
+  }
+
+  /**
+   * Number of values (commands and their arguments) in the committed drawing.
+   *
+   * @type {number}
+   */
+  get commandCount () {
+    return this._native.getCommandCount()
+  }
+
+  isLeaf () {
+    return true
+  }
+
+  _destroy () {
+    this._context = null
+    super._destroy()
+  }
+}
+
+/**
+ * Displays a stream of raw pixel frames, such as the output of an emulator or video decoder.
+ *
+ * Frames are copied directly from the javascript buffer into a texture in a single pass. If frames are written in the
+ * renderer's texture format (see textureFormat), the copy is a plain memcpy. Otherwise, frames must be RGBA and are
+ * converted during the copy.
+ *
+ * @memberof module:@lse/core
+ * @extends module:@lse/core.SceneNode
+ * @hideconstructor
+ */
+class PixelSceneNode extends SceneNode {
+  constructor (scene) {
+    super(scene, new CPixelSceneNode(scene.$native))
+  }
+
+  /**
+   * Pixel format of the textures used by this node. Frames in this format are uploaded without conversion.
+   *
+   * @returns {module:@lse/core.core-enum.PixelFormat} PixelFormat or PixelFormat.UNKNOWN if the scene is not attached
+   */
+  get textureFormat () {
+    return this._native.getTextureFormat()
+  }
+
+  /**
+   * Set the frame to display.
+   *
+   * The frame is uploaded immediately and displayed on the next frame. The buffer can be reused as soon as this
+   * method returns.
+   *
+   * @param {ArrayBuffer|TypedArray} pixels Frame pixels, 4 bytes per pixel. Color channels must be premultiplied by
+   * alpha; opaque frames need no special handling.
+   * @param {number} width Width of the frame in pixels
+   * @param {number} height Height of the frame in pixels
+   * @param {number} [pitch=width * 4] Number of bytes per row in pixels
+   * @param {module:@lse/core.core-enum.PixelFormat} [format=PixelFormat.RGBA] Format of pixels. Must be RGBA or
+   * textureFormat.
+   * @returns {boolean} true if the frame was uploaded; false if the scene is not attached
+   */
+  update (pixels, width, height, pitch = width * 4, format = PixelFormat.RGBA) {
+    return this._native.setFrame(pixels, width, height, pitch, format)
+  }
+
+  /**
+   * Remove the current frame.
+   */
+  clear () {
+    this._native.clearFrame()
+  }
+
+  /**
+   * Width, in pixels, of the current frame; 0 if there is no frame.
+   *
+   * @type {number}
+   */
+  get frameWidth () {
+    return this._native.getFrameWidth()
+  }
+
+  /**
+   * Height, in pixels, of the current frame; 0 if there is no frame.
+   *
+   * @type {number}
+   */
+  get frameHeight () {
+    return this._native.getFrameHeight()
+  }
+
+  isLeaf () {
+    return true
+  }
+}
+
+/**
+ * Virtualized list container for long menus, media libraries, settings, etc.
+ *
+ * Only the items in the visible range, plus overscan items on each side, are realized as child nodes, so a list of
+ * any length costs about as much as a screenful of items. Items have a fixed extent (itemExtent) along the main axis.
+ * Item subtrees are created with onCreateItem and filled with onBindItem as items enter the range. Items that leave
+ * the range are hidden and reused for items entering the range, rather than destroyed.
+ *
+ * Scrolling (scrollOffset or scrollToIndex()) translates the items at composite time and does not relayout. Set
+ * horizontal, itemExtent, onCreateItem and onBindItem before itemCount.
+ *
+ * @memberof module:@lse/core
+ * @extends module:@lse/core.SceneNode
+ * @hideconstructor
+ */
+class ListSceneNode extends SceneNode {
+  /**
+   * Creates the subtree of an item: (list) => SceneNode. Must return a new node of this scene.
+   */
+  onCreateItem = null
+
+  /**
+   * Fills an item subtree with the content of the item at index: (item, index) => void.
+   */
+  onBindItem = null
+  _items = new Map()
+  _recycled = []
+
+  constructor (scene) {
+    super(scene, new CListSceneNode(scene.$native))
+    this._native.setCallback((first, last) => this._onRangeChange(first, last))
+  }
+
+  get itemCount () {
+    return this._native.itemCount
+  }
+
+  set itemCount (value) {
+    this._native.itemCount = value
+  }
+
+  /**
+   * Height (vertical list) or width (horizontal list) of every item, in pixels.
+   */
+  get itemExtent () {
+    return this._native.itemExtent
+  }
+
+  set itemExtent (value) {
+    this._native.itemExtent = value
+    this.refresh()
+  }
+
+  /**
+   * Number of items realized beyond each end of the visible range. Default is 2.
+   */
+  get overscan () {
+    return this._native.overscan
+  }
+
+  set overscan (value) {
+    this._native.overscan = value
+  }
+
+  get horizontal () {
+    return this._native.horizontal
+  }
+
+  set horizontal (value) {
+    this._native.horizontal = value
+  }
+
+  get scrollOffset () {
+    return this._native.scrollOffset
+  }
+
+  /**
+   * Scroll position in pixels, clamped to [0, maxScrollOffset].
+   */
+  set scrollOffset (value) {
+    this._native.scrollOffset = value
+  }
+
+  get maxScrollOffset () {
+    return this._native.maxScrollOffset
+  }
+
+  /**
+   * @returns {{first: number, last: number}} Indices of the realized items: [first, last)
+   */
+  get range () {
+    return this._native.getRange()
+  }
+
+  /**
+   * Scroll so the item at index is at the start of the list.
+   */
+  scrollToIndex (index) {
+    this.scrollOffset = index * this.itemExtent
+  }
+
+  /**
+   * Bind all realized items again. Call when the data behind the list changes.
+   */
+  refresh () {
+    const { _items } = this
+
+    for (const item of _items.values()) {
+      this._recycle(item)
+    }
+
+    _items.clear()
+
+    const { first, last } = this.range
+
+    this._bind(first, last)
+  }
+
+  /**
+   * @ignore
+   */
+  $bindRange () {
+    const { first, last } = this.range
+
+    this._bind(first, last)
+  }
+
+  _onRangeChange (first, last) {
+    // Property setters change the range synchronously. Layout changes the range in the compute style phase of a
+    // frame, where the scene graph must not be mutated, so the scene binds the list before the frame is painted.
+    if (this._scene.$isRendering) {
+      this._scene.$bindBeforePaint(this)
+    } else {
+      this._bind(first, last)
+    }
+  }
+
+  _bind (first, last) {
+    const { _items, _recycled, onCreateItem, onBindItem } = this
+
+    if (!onCreateItem || !onBindItem) {
+      return
+    }
+
+    for (const [index, item] of _items) {
+      if (index < first || index >= last) {
+        _items.delete(index)
+        this._recycle(item)
+      }
+    }
+
+    const { itemExtent, horizontal } = this
+    const commands = this._scene.$commands
+
+    for (let index = first; index < last; index++) {
+      if (_items.has(index)) {
+        continue
+      }
+
+      let item = _recycled.pop()
+
+      if (item) {
+        commands.setHidden(item, false)
+      } else {
+        item = this._createItem(horizontal)
+      }
+
+      const { style } = item
+
+      if (horizontal) {
+        style.left = index * itemExtent
+        style.width = itemExtent
+      } else {
+        style.top = index * itemExtent
+        style.height = itemExtent
+      }
+
+      onBindItem(item, index)
+      _items.set(index, item)
+    }
+  }
+
+  _createItem (horizontal) {
+    const item = this.onCreateItem(this)
+    const { style } = item
+
+    this.appendChild(item)
+
+    style.position = 'absolute'
+
+    if (horizontal) {
+      style.top = 0
+      style.bottom = 0
+    } else {
+      style.left = 0
+      style.right = 0
+    }
+
+    return item
+  }
+
+  _recycle (item) {
+    this._scene.$commands.setHidden(item, true)
+    this._recycled.push(item)
+  }
+
+  _destroy () {
+    this._native.setCallback(null)
+    this._items.clear()
+    this._recycled.length = 0
+    this.onCreateItem = this.onBindItem = null
+    super._destroy()
+  }
+}
+
 const throwAddChildError = () => {
   throw Error('leaf nodes cannot have children')
 }
 
+const throwChildArgError = () => {
+  throw Error('node is not a SceneNode that can be added as a child')
+}
+
 const throwBeforeArgError = () => {
   throw Error('before is not a child')
 }
@@ -373,9 +798,6 @@ const throwBeforeArgError = () => {
 // if native calls are present in a function, the function will not be eligible for v8 jit. isolate the calls into
 // separate function so the callers can be eligible for optimization. (Just doing this for frequently called functions)
 const nativeBindStyle = (native) => native.bindStyle(new StyleInstance())
-const nativeAppendChild = (native, child) => native.appendChild(child)
-const nativeRemoveChild = (native, child) => native.removeChild(child)
-const nativeDestroy = (native) => native.destroy()
 
 const setImageStatusCallback = (node) => {
   const self = node
@@ -392,4 +814,12 @@ const clearImageStatusCallback = (node) => {
   node._native.setCallback(null)
 }
 
-export { BoxSceneNode, ImageSceneNode, RootSceneNode, TextSceneNode }
+export {
+  BoxSceneNode,
+  CanvasSceneNode,
+  ImageSceneNode,
+  ListSceneNode,
+  PixelSceneNode,
+  RootSceneNode,
+  TextSceneNode
+}
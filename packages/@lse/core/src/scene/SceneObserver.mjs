@@ -0,0 +1,147 @@
+/*
+ * Copyright (c) 2021 Light Source Software, LLC. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on
+ * an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the
+ * specific language governing permissions and limitations under the License.
+ */
+
+// Observer types. Values match NodeObserverType in lse/NodeObserver.h.
+const ObserverTypeResize = 1
+const ObserverTypeIntersection = 2
+
+let sObserverId = 0
+
+/**
+ * Base of the node observers created by Scene.
+ *
+ * Observed nodes are evaluated natively after layout each frame, only when node geometry changed. The callback is
+ * called, after the frame is rendered, with the entries of all the observed nodes that changed in the frame.
+ *
+ * @memberof module:@lse/core
+ * @hideconstructor
+ */
+class SceneObserver {
+  _scene
+  _id
+  _callback
+
+  constructor (scene, type, callback, thresholds) {
+    if (typeof callback !== 'function') {
+      throw Error('callback must be a function')
+    }
+
+    this._scene = scene
+    this._id = ++sObserverId
+    this._callback = callback
+    scene.$native.addObserver(this._id, type, thresholds)
+  }
+
+  /**
+   * Start observing a node. The callback receives an entry for the node on the next frame.
+   *
+   * @param node {module:@lse/core.SceneNode}
+   */
+  observe (node) {
+    if (!this._scene?.$native?.observe(this._id, node?.$id ?? 0)) {
+      throw Error('cannot observe node')
+    }
+  }
+
+  /**
+   * Stop observing a node.
+   *
+   * @param node {module:@lse/core.SceneNode}
+   */
+  unobserve (node) {
+    this._scene?.$native?.unobserve(this._id, node?.$id ?? 0)
+  }
+
+  /**
+   * Stop observing all nodes. The observer cannot be used after disconnect.
+   */
+  disconnect () {
+    this._scene?.$disconnectObserver(this)
+    this._scene = null
+  }
+
+  /**
+   * @ignore
+   */
+  get $id () {
+    return this._id
+  }
+
+  /**
+   * @ignore
+   */
+  $deliver (records, nodes) {
+    const entries = []
+
+    for (const record of records) {
+      const target = nodes.get(record.nodeId)
+
+      if (target) {
+        entries.push(this.$createEntry(target, record))
+      }
+    }
+
+    if (entries.length) {
+      this._callback(entries, this)
+    }
+  }
+}
+
+/**
+ * Reports changes to the layout size of nodes.
+ *
+ * Entries: { target, width, height }
+ *
+ * @memberof module:@lse/core
+ * @extends module:@lse/core.SceneObserver
+ * @hideconstructor
+ */
+class ResizeObserver extends SceneObserver {
+  constructor (scene, callback) {
+    super(scene, ObserverTypeResize, callback, [])
+  }
+
+  /**
+   * @ignore
+   */
+  $createEntry (target, { width, height }) {
+    return { target, width, height }
+  }
+}
+
+/**
+ * Reports when the visible fraction of nodes crosses a threshold. The visible fraction is the area of the node's
+ * screen bounds within the viewport, and within the boxes of ancestors that clip their children (overflow hidden,
+ * scroll containers and lists), divided by the area of the bounds. Hidden nodes and nodes removed from the scene
+ * graph are not intersecting.
+ *
+ * Entries: { target, boundingRect: { x, y, width, height }, intersectionRatio, isIntersecting }
+ *
+ * @memberof module:@lse/core
+ * @extends module:@lse/core.SceneObserver
+ * @hideconstructor
+ */
+class IntersectionObserver extends SceneObserver {
+  constructor (scene, callback, threshold) {
+    super(scene, ObserverTypeIntersection, callback, Array.isArray(threshold) ? threshold : [threshold ?? 0])
+  }
+
+  /**
+   * @ignore
+   */
+  $createEntry (target, { x, y, width, height, ratio, isIntersecting }) {
+    return { target, boundingRect: { x, y, width, height }, intersectionRatio: ratio, isIntersecting }
+  }
+}
+
+export { SceneObserver, ResizeObserver, IntersectionObserver }
@@ -0,0 +1,44 @@
+/*
+ * Copyright (c) 2021 Light Source Software, LLC. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on
+ * an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the
+ * specific language governing permissions and limitations under the License.
+ */
+
+const spatialTag = 'spatial'
+
+/**
+ * Waypoint that moves focus to the nearest focusable descendant in the direction of navigation, by layout position.
+ *
+ * Suited to grids and free-form layouts, where the focus order does not follow the child order. Candidates are found
+ * by a single query of the native scene's spatial index of focusable nodes, so a move costs about the same in a grid
+ * of 10 or 10,000 items.
+ *
+ * @ignore
+ */
+export class SpatialWaypoint {
+  tag = spatialTag
+
+  navigate (context) {
+    const { owner, direction } = context
+    const { scene } = owner
+    const next = scene.$findFocus(scene.activeNode, direction, owner)
+
+    // At the edge of the owner, let a parent waypoint handle the move.
+    return next ? context.move(next) : context.pass()
+  }
+
+  resolve (context) {
+    const { owner, direction } = context
+    const { scene } = owner
+
+    // Focus is entering the owner: pick the node nearest to the node losing focus. Otherwise, the first node.
+    return scene.$findFocus(scene.activeNode, direction, owner) ?? scene.$findFocus(null, direction, owner)
+  }
+}
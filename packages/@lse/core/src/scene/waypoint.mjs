@@ -12,10 +12,11 @@
  */
 
 import { FixedListWaypoint } from './FixedListWaypoint.mjs'
+import { SpatialWaypoint } from './SpatialWaypoint.mjs'
 
 /**
  * @method module:@lse/core.waypoint
  */
 export const waypoint = (tag) => {
-  return new FixedListWaypoint(tag)
+  return tag === 'spatial' ? new SpatialWaypoint() : new FixedListWaypoint(tag)
 }
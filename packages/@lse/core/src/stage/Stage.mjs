@@ -32,6 +32,7 @@ import { SystemManager } from '../system/SystemManager.mjs'
 import { loadPlugin } from '../addon/loadPlugin.mjs'
 import { EventTarget } from '../event/EventTarget.mjs'
 import { FontManager } from '../font/FontManager.mjs'
+import { ImageManager } from '../image/ImageManager.mjs'
 
 const kFlagWasQuitRequested = 1
 const kFlagIsAttached = 2
@@ -49,6 +50,9 @@ class Stage extends EventTarget {
   _native = new CStage()
   _plugins = new Map()
   _scenes = new Map()
+  // Image managers by graphics context: { image, refs }. Textures belong to a renderer, so only the scenes drawing to
+  // one graphics context can share images.
+  _imageManagers = new Map()
   _flags = 0
   _mainLoopHandle = null
   _frameRate = 0
@@ -256,6 +260,8 @@ class Stage extends EventTarget {
     this._scenes.clear()
 
     listManagers(this).reverse().forEach(manager => logexcept(() => manager.$destroy(), site))
+    this._imageManagers.forEach(({ image }) => logexcept(() => image.$destroy(), site))
+    this._imageManagers.clear()
 
     listPlugins(this).reverse().forEach(plugin => logexcept(() => plugin?.destroy(), site))
     this._plugins.clear()
@@ -311,6 +317,37 @@ class Stage extends EventTarget {
     this._mainLoopHandle = null
   }
 
+  /**
+   * Get the image manager shared by the scenes of a graphics context. Each call must be matched by a call to
+   * $releaseImageManager().
+   *
+   * @ignore
+   */
+  $acquireImageManager (context) {
+    let entry = this._imageManagers.get(context)
+
+    if (!entry) {
+      entry = { image: new ImageManager(), refs: 0 }
+      this._imageManagers.set(context, entry)
+    }
+
+    entry.refs++
+
+    return entry.image
+  }
+
+  /**
+   * @ignore
+   */
+  $releaseImageManager (context) {
+    const entry = this._imageManagers.get(context)
+
+    if (entry && --entry.refs <= 0) {
+      this._imageManagers.delete(context)
+      entry.image.$destroy()
+    }
+  }
+
   $updateFrameRate () {
     this._frameRate = this.$scene?._context.getRefreshRate() || 60
   }
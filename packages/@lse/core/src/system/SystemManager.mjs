@@ -69,7 +69,9 @@ class SystemManager {
   /**
    * @ignore
    */
-  $createGraphicsContext ({ displayId = 'auto', width = 'auto', height = 'auto', fullscreen = 'auto' }) {
+  $createGraphicsContext ({
+    displayId = 'auto', width = 'auto', height = 'auto', fullscreen = 'auto', renderer = 'auto'
+  }) {
     if (!this._plugin) {
       throw Error('SystemManager has no plugin installed!')
     }
@@ -118,7 +120,13 @@ class SystemManager {
       }
     }
 
-    return this._plugin.createGraphicsContext({ displayId, width, height, fullscreen })
+    if (renderer === 'auto') {
+      renderer = ''
+    } else if (renderer !== 'software') {
+      throw Error(`renderer [${renderer}] must be 'auto' or 'software'`)
+    }
+
+    return this._plugin.createGraphicsContext({ displayId, width, height, fullscreen, renderer })
   }
 }
 
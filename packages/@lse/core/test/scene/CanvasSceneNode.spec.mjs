@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) 2021 Light Source Software, LLC. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on
+ * an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the
+ * specific language governing permissions and limitations under the License.
+ */
+
+import chai from 'chai'
+import { afterSceneTest, beforeSceneTest } from '../test-env.mjs'
+import { CanvasSceneNode } from '../../src/scene/SceneNode.mjs'
+
+const { assert } = chai
+
+describe('CanvasSceneNode', () => {
+  let scene
+  beforeEach(() => { scene = beforeSceneTest() })
+  afterEach(() => { scene = afterSceneTest() })
+  describe('constructor()', () => {
+    it('should create uninitialized node when passed an invalid Scene', () => {
+      for (const input of [null, undefined, {}]) {
+        assert.throws(() => new CanvasSceneNode(input))
+      }
+    })
+  })
+  describe('appendChild()', () => {
+    it('should always throw Error', () => {
+      assert.throws(() => scene.createNode('canvas').appendChild(scene.createNode('box')))
+    })
+  })
+  describe('getContext()', () => {
+    it('should return the same 2d context', () => {
+      const node = scene.createNode('canvas')
+
+      assert.strictEqual(node.getContext('2d'), node.getContext())
+      assert.strictEqual(node.getContext().canvas, node)
+    })
+    it('should return null for unsupported context ids', () => {
+      assert.isNull(scene.createNode('canvas').getContext('webgl'))
+    })
+  })
+  describe('draw()', () => {
+    it('should commit a drawing', () => {
+      const node = scene.createNode('canvas')
+
+      node.draw(ctx => {
+        ctx.fillStyle = 'red'
+        ctx.fillRect(0, 0, 50, 50)
+        ctx.save()
+        ctx.translate(50, 50)
+        ctx.beginPath()
+        ctx.arc(0, 0, 25, 0, Math.PI * 2)
+        ctx.quadraticCurveTo(10, 10, 20, 0)
+        ctx.closePath()
+        ctx.strokeStyle = '#00FF00'
+        ctx.lineWidth = 4
+        ctx.stroke()
+        ctx.fill('evenodd')
+        ctx.restore()
+        ctx.drawImage('test/resources/640x480.png', 0, 0, 10, 10)
+      })
+
+      assert.isAbove(node.commandCount, 0)
+    })
+    it('should ignore invalid style values', () => {
+      const node = scene.createNode('canvas')
+
+      node.draw(ctx => {
+        ctx.fillStyle = 'not a color'
+        ctx.lineWidth = -1
+        ctx.lineCap = 'invalid'
+        ctx.globalAlpha = 2
+
+        assert.equal(ctx.fillStyle, 'black')
+        assert.equal(ctx.lineWidth, 1)
+        assert.equal(ctx.lineCap, 'butt')
+        assert.equal(ctx.globalAlpha, 1)
+      })
+    })
+    it('should ignore drawing calls with non-finite arguments', () => {
+      const node = scene.createNode('canvas')
+
+      node.draw(ctx => {
+        ctx.moveTo(NaN, 0)
+        ctx.lineTo(0, Infinity)
+        ctx.rect(0, 0, undefined, 10)
+        ctx.drawImage('test/resources/640x480.png', 0, NaN)
+      })
+
+      assert.equal(node.commandCount, 0)
+    })
+    it('should grow the command buffer for large drawings', () => {
+      const node = scene.createNode('canvas')
+
+      node.draw(ctx => {
+        ctx.beginPath()
+        for (let i = 0; i < 1000; i++) {
+          ctx.lineTo(i, i)
+        }
+        ctx.stroke()
+      })
+
+      // 1000 lineTo commands of 3 values each, past the initial buffer capacity.
+      assert.isAtLeast(node.commandCount, 3000)
+    })
+  })
+  describe('$native.setCommands()', () => {
+    it('should throw for non-finite or non-integral commands', () => {
+      const node = scene.createNode('canvas')
+
+      for (const commands of [[NaN], [0.5], [Infinity], [3, NaN, 0], [12, 0.5, 0, 0, 0, 0, 0, 0, 0, 0]]) {
+        assert.throws(() => node.$native.setCommands(new Float64Array(commands), ['test/resources/640x480.png']))
+      }
+
+      assert.equal(node.commandCount, 0)
+    })
+  })
+  describe('clear()', () => {
+    it('should remove the drawing', () => {
+      const node = scene.createNode('canvas')
+
+      node.draw(ctx => ctx.fillRect(0, 0, 10, 10))
+      assert.isAbove(node.commandCount, 0)
+
+      node.clear()
+      assert.equal(node.commandCount, 0)
+    })
+  })
+})
@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) 2021 Light Source Software, LLC. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on
+ * an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the
+ * specific language governing permissions and limitations under the License.
+ */
+
+import chai from 'chai'
+import { afterSceneTest, beforeSceneTest } from '../test-env.mjs'
+import { ListSceneNode } from '../../src/scene/SceneNode.mjs'
+
+const { assert } = chai
+
+describe('ListSceneNode', () => {
+  let scene
+  let bound
+  beforeEach(() => {
+    scene = beforeSceneTest()
+    bound = new Map()
+  })
+  afterEach(() => { scene = afterSceneTest() })
+  describe('constructor()', () => {
+    it('should create uninitialized node when passed an invalid Scene', () => {
+      for (const input of [null, undefined, {}]) {
+        assert.throws(() => new ListSceneNode(input))
+      }
+    })
+  })
+  describe('itemCount', () => {
+    it('should realize overscan items before layout', () => {
+      const list = createList()
+
+      list.itemCount = 10000
+
+      assert.deepEqual(list.range, { first: 0, last: 2 })
+      assert.lengthOf(list.children, 2)
+      assert.deepEqual([...bound.keys()].sort(), [0, 1])
+    })
+    it('should clear the range when set to 0', () => {
+      const list = createList()
+
+      list.itemCount = 10000
+      list.itemCount = 0
+
+      assert.deepEqual(list.range, { first: 0, last: 0 })
+      assert.equal(list.maxScrollOffset, 0)
+    })
+  })
+  describe('scrollOffset', () => {
+    it('should realize items around the scroll offset', () => {
+      const list = createList()
+
+      list.itemCount = 10000
+      list.scrollOffset = 500
+
+      assert.equal(list.scrollOffset, 500)
+      assert.deepEqual(list.range, { first: 48, last: 52 })
+
+      for (const index of [48, 49, 50, 51]) {
+        assert.strictEqual(bound.get(index).parent, list)
+      }
+    })
+    it('should recycle items that leave the range', () => {
+      const list = createList()
+
+      list.itemCount = 10000
+
+      for (let offset = 0; offset < 10000; offset += 10) {
+        list.scrollOffset = offset
+      }
+
+      assert.isAtMost(list.children.length, 8)
+    })
+    it('should clamp to the scrollable range', () => {
+      const list = createList()
+
+      list.itemCount = 10
+
+      list.scrollOffset = -100
+      assert.equal(list.scrollOffset, 0)
+
+      list.scrollOffset = 1000
+      assert.equal(list.scrollOffset, list.maxScrollOffset)
+    })
+  })
+  describe('layout', () => {
+    it('should bind items in the frame the viewport changes', () => {
+      const list = createList()
+
+      list.style.height = 20
+      list.itemCount = 100
+      scene.root.appendChild(list)
+      scene.$attach()
+      scene.$frame(0, 0)
+
+      assert.isFalse(scene.$isRendering)
+      assert.equal(scene.$commands.length, 0)
+
+      for (let index = list.range.first; index < list.range.last; index++) {
+        assert.strictEqual(bound.get(index).parent, list)
+      }
+    })
+    it('should lay out bound items before the frame is painted', () => {
+      const list = createList()
+
+      list.style.height = 20
+      list.itemCount = 100
+      scene.root.appendChild(list)
+      scene.$attach()
+      scene.$frame(0, 0)
+
+      const stats = scene.frameStats
+
+      assert.isAtLeast(stats[stats.length - 1].layoutCount, list.range.last - list.range.first)
+    })
+  })
+  describe('scrollToIndex()', () => {
+    it('should scroll item to the start of the list', () => {
+      const list = createList()
+
+      list.itemCount = 100
+      list.scrollToIndex(20)
+
+      assert.equal(list.scrollOffset, 200)
+    })
+  })
+  const createList = () => {
+    const list = scene.createNode('list')
+
+    list.onCreateItem = () => scene.createNode('box')
+    list.onBindItem = (item, index) => bound.set(index, item)
+    list.itemExtent = 10
+
+    return list
+  }
+})
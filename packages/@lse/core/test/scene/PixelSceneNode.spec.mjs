@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2021 Light Source Software, LLC. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on
+ * an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the
+ * specific language governing permissions and limitations under the License.
+ */
+
+import chai from 'chai'
+import { afterSceneTest, beforeSceneTest } from '../test-env.mjs'
+import { PixelSceneNode } from '../../src/scene/SceneNode.mjs'
+import { PixelFormat } from '../../src/addon/index.mjs'
+
+const { assert } = chai
+
+describe('PixelSceneNode', () => {
+  let scene
+  beforeEach(() => { scene = beforeSceneTest() })
+  afterEach(() => { scene = afterSceneTest() })
+  describe('constructor()', () => {
+    it('should create uninitialized node when passed an invalid Scene', () => {
+      for (const input of [null, undefined, {}]) {
+        assert.throws(() => new PixelSceneNode(input))
+      }
+    })
+  })
+  describe('appendChild()', () => {
+    it('should always throw Error', () => {
+      assert.throws(() => scene.createNode('pixels').appendChild(scene.createNode('box')))
+    })
+  })
+  describe('update()', () => {
+    it('should accept an ArrayBuffer or TypedArray frame', () => {
+      const node = scene.createNode('pixels')
+
+      for (const pixels of [new ArrayBuffer(16), new Uint8Array(16), new Uint8ClampedArray(16), new Uint32Array(4)]) {
+        assert.isBoolean(node.update(pixels, 2, 2))
+      }
+    })
+    it('should accept a frame with padded rows', () => {
+      assert.isBoolean(scene.createNode('pixels').update(new Uint8Array(12 * 2), 2, 2, 12))
+    })
+    it('should throw Error for invalid frames', () => {
+      const node = scene.createNode('pixels')
+
+      assert.throws(() => node.update(null, 2, 2))
+      assert.throws(() => node.update([0, 0, 0, 0], 1, 1))
+      assert.throws(() => node.update(new Uint8Array(16), 0, 2))
+      assert.throws(() => node.update(new Uint8Array(15), 2, 2))
+      assert.throws(() => node.update(new Uint8Array(16), 2, 2, 4))
+      assert.throws(() => node.update(new Uint8Array(16), 2, 2, 8, -1))
+    })
+  })
+  describe('textureFormat', () => {
+    it('should be a PixelFormat value', () => {
+      assert.include(Object.values(PixelFormat), scene.createNode('pixels').textureFormat)
+    })
+  })
+  describe('clear()', () => {
+    it('should remove the frame', () => {
+      const node = scene.createNode('pixels')
+
+      scene.$attach()
+      assert.isTrue(node.update(new Uint8Array(16), 2, 2))
+      assert.equal(node.frameWidth, 2)
+      assert.equal(node.frameHeight, 2)
+
+      node.clear()
+      assert.equal(node.frameWidth, 0)
+      assert.equal(node.frameHeight, 0)
+    })
+  })
+})
@@ -14,7 +14,7 @@
 import chai from 'chai'
 import sinon from 'sinon'
 import { BoxSceneNode, TextSceneNode, ImageSceneNode, RootSceneNode } from '../../src/scene/SceneNode.mjs'
-import { afterSceneTest, beforeSceneTest } from '../test-env.mjs'
+import { afterSceneTest, beforeSceneTest, createBox } from '../test-env.mjs'
 
 const { assert } = chai
 
@@ -81,6 +81,157 @@ describe('Scene', () => {
       assert.strictEqual(scene.title, 'App Title')
     })
   })
+  describe('paintBudget', () => {
+    it('should default to no limit', () => {
+      assert.equal(scene.paintBudget, 0)
+    })
+    it('should set paint budget in milliseconds', () => {
+      scene.paintBudget = 4
+      assert.equal(scene.paintBudget, 4)
+    })
+    it('should remove the limit for invalid values', () => {
+      for (const value of [-1, NaN, null, '4', {}]) {
+        scene.paintBudget = 4
+        scene.paintBudget = value
+        assert.equal(scene.paintBudget, 0)
+      }
+    })
+  })
+  describe('nodePoolStats', () => {
+    it('should count nodes allocated from the pool', () => {
+      const { liveCount, allocationCount } = scene.nodePoolStats
+
+      scene.createNode('box')
+
+      const stats = scene.nodePoolStats
+
+      assert.equal(stats.liveCount, liveCount + 1)
+      assert.equal(stats.allocationCount, allocationCount + 1)
+      assert.isAbove(stats.slabCount, 0)
+      assert.isAbove(stats.reservedBytes, 0)
+    })
+  })
+  describe('frameStats', () => {
+    it('should return the stats of the most recent frames', () => {
+      const stats = scene.frameStats
+
+      assert.isArray(stats)
+      assert.isAtMost(stats.length, 60)
+
+      for (let i = 1; i < stats.length; i++) {
+        assert.equal(stats[i].frame, stats[i - 1].frame + 1)
+      }
+    })
+  })
+  describe('image', () => {
+    it('should be the image manager of the graphics context', () => {
+      const image = scene.stage.$acquireImageManager(scene._context)
+
+      assert.strictEqual(scene.image, image)
+      scene.stage.$releaseImageManager(scene._context)
+      assert.isOk(scene.image.$native)
+    })
+    it('should share images requested by multiple nodes of a scene', () => {
+      const { acquireCount, shareCount } = scene.image.stats
+
+      for (let i = 0; i < 2; i++) {
+        scene.createNode('img').src = 'test/resources/640x480.png'
+      }
+
+      const stats = scene.image.stats
+
+      assert.equal(stats.acquireCount, acquireCount + 2)
+      // only shares across scenes are counted
+      assert.equal(stats.shareCount, shareCount)
+    })
+  })
+  describe('attachStats', () => {
+    afterEach(() => { scene.image.shadowLimit = 0 })
+    it('should measure attach', () => {
+      scene.$detach()
+      scene.$attach()
+
+      const { attachTime, imageUploadCount, imageLoadCount } = scene.attachStats
+
+      assert.isAtLeast(attachTime, 0)
+      assert.isAtLeast(imageUploadCount, 0)
+      assert.isAtLeast(imageLoadCount, 0)
+    })
+    it('should restore images from shadows on reattach', async () => {
+      scene.image.shadowLimit = 64 * 1024 * 1024
+      scene.stage.start()
+
+      const node = scene.createNode('img')
+      const loaded = new Promise((resolve, reject) => {
+        node.onLoad = () => resolve()
+        node.onError = () => reject(Error('unexpected onError call'))
+      })
+
+      node.src = 'test/resources/640x480.png'
+      await loaded
+
+      assert.equal(scene.image.shadowStats.count, 1)
+      assert.equal(scene.image.shadowStats.usedBytes, 640 * 480 * 4)
+
+      scene.$detach()
+      scene.$attach()
+
+      assert.equal(scene.attachStats.imageUploadCount, 1)
+      assert.equal(scene.attachStats.imageLoadCount, 0)
+    })
+  })
+  describe('saveSnapshot()', () => {
+    afterEach(() => { scene.releaseSnapshot() })
+    it('should save a snapshot that can be loaded', () => {
+      scene.$attach()
+
+      const box = scene.createNode('box')
+
+      box.style.backgroundColor = 'red'
+      scene.root.appendChild(box)
+
+      const snapshot = scene.saveSnapshot()
+
+      assert.equal(snapshot.subarray(0, 4).toString(), 'LSES')
+
+      scene.loadSnapshot(snapshot)
+      assert.isTrue(scene.hasSnapshot)
+    })
+  })
+  describe('loadSnapshot()', () => {
+    it('should throw Error for invalid snapshot data', () => {
+      for (const input of [null, undefined, '', new Uint8Array(8), Buffer.from('LSES')]) {
+        assert.throws(() => scene.loadSnapshot(input))
+      }
+      assert.isFalse(scene.hasSnapshot)
+    })
+  })
+  describe('releaseSnapshot()', () => {
+    it('should be a no-op when no snapshot is loaded', () => {
+      scene.releaseSnapshot()
+      assert.isFalse(scene.hasSnapshot)
+    })
+  })
+  describe('hitTest()', () => {
+    it('should return the top most node at a point', () => {
+      const back = createBox(scene, 10, 10, 100, 100)
+      const front = createBox(scene, 50, 50, 100, 100)
+
+      scene.root.appendChild(back)
+      scene.root.appendChild(front)
+
+      assert.strictEqual(scene.hitTest(20, 20), back)
+      assert.strictEqual(scene.hitTest(60, 60), front)
+    })
+    it('should skip hidden nodes', () => {
+      const node = createBox(scene, 10, 10, 100, 100)
+
+      node.style.display = 'none'
+      scene.root.appendChild(node)
+
+      assert.notStrictEqual(scene.hitTest(20, 20), node)
+    })
+  })
   describe('activeNode', () => {
     it('should set active node and call onFocus on new focus', () => {
       const node = scene.createNode('box')
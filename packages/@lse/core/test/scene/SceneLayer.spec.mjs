@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2021 Light Source Software, LLC. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on
+ * an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the
+ * specific language governing permissions and limitations under the License.
+ */
+
+import chai from 'chai'
+import { afterSceneTest, beforeSceneTest, createBox } from '../test-env.mjs'
+
+const { assert } = chai
+
+describe('SceneLayer', () => {
+  let scene
+  beforeEach(() => { scene = beforeSceneTest() })
+  afterEach(() => { scene = afterSceneTest() })
+  describe('createLayer()', () => {
+    it('should create a layer over the base layer', () => {
+      const layer = scene.createLayer()
+
+      assert.equal(layer.zIndex, 1)
+      assert.isFalse(layer.cached)
+      assert.isNotNull(layer.root)
+      assert.deepEqual(scene.layers, [scene.baseLayer, layer])
+    })
+    it('should create a cached layer', () => {
+      assert.isTrue(scene.createLayer({ cached: true }).cached)
+    })
+    it('should order layers by zIndex', () => {
+      const top = scene.createLayer({ zIndex: 10 })
+      const bottom = scene.createLayer({ zIndex: -1 })
+
+      assert.deepEqual(scene.layers, [bottom, scene.baseLayer, top])
+
+      top.zIndex = -2
+
+      assert.deepEqual(scene.layers, [top, bottom, scene.baseLayer])
+    })
+  })
+  describe('root', () => {
+    it('should not be added to another node', () => {
+      const layer = scene.createLayer()
+
+      assert.throws(() => scene.root.appendChild(layer.root))
+    })
+    it('should be hit over the base layer', () => {
+      const layer = scene.createLayer()
+      const back = createBox(scene, 10, 10, 100, 100)
+      const front = createBox(scene, 10, 10, 100, 100)
+
+      scene.root.appendChild(back)
+      layer.root.appendChild(front)
+
+      assert.strictEqual(scene.hitTest(20, 20), front)
+    })
+  })
+  describe('destroy()', () => {
+    it('should remove the layer and destroy its nodes', () => {
+      const layer = scene.createLayer()
+      const { root } = layer
+
+      layer.destroy()
+
+      assert.isNull(layer.root)
+      assert.isNull(root.$native)
+      assert.deepEqual(scene.layers, [scene.baseLayer])
+    })
+    it('should throw for the base layer', () => {
+      assert.throws(() => scene.baseLayer.destroy())
+    })
+  })
+})
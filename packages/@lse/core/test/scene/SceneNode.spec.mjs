@@ -17,6 +17,7 @@ import { afterSceneTest, beforeSceneTest } from '../test-env.mjs'
 import { createStyleClass } from '../../src/style/createStyleClass.mjs'
 import { StyleInstance } from '../../src/style/StyleInstance.mjs'
 import { StyleClass } from '../../src/style/StyleClass.mjs'
+import { translate } from '../../src/style/transform.mjs'
 
 const { assert } = chai
 
@@ -103,6 +104,44 @@ describe('SceneNode', () => {
       assert.isTrue(scene.root.onFocusOut.called)
     })
   })
+  describe('getBounds()', () => {
+    it('should return the screen bounds of a node', () => {
+      const parent = addBoxToRoot()
+      const child = scene.createNode('box')
+
+      Object.assign(parent.style, { position: 'absolute', left: 10, top: 20, width: 200, height: 100 })
+      Object.assign(child.style, { position: 'absolute', left: 5, top: 5, width: 50, height: 40 })
+      parent.appendChild(child)
+
+      assert.deepEqual(parent.getBounds(), { x: 10, y: 20, width: 200, height: 100 })
+      assert.deepEqual(child.getBounds(), { x: 15, y: 25, width: 50, height: 40 })
+    })
+    it('should return the new bounds of a subtree after its parent moves', () => {
+      const sibling = addBoxToRoot()
+      const parent = addBoxToRoot()
+      const child = scene.createNode('box')
+
+      Object.assign(sibling.style, { position: 'absolute', left: 0, top: 0, width: 10, height: 10 })
+      Object.assign(parent.style, { position: 'absolute', left: 10, top: 20, width: 200, height: 100 })
+      Object.assign(child.style, { position: 'absolute', left: 5, top: 5, width: 50, height: 40 })
+      parent.appendChild(child)
+
+      assert.deepEqual(child.getBounds(), { x: 15, y: 25, width: 50, height: 40 })
+
+      parent.style.transform = [translate(100, 0)]
+      parent.style.left = 20
+
+      assert.deepEqual(child.getBounds(), { x: 125, y: 25, width: 50, height: 40 })
+      assert.deepEqual(sibling.getBounds(), { x: 0, y: 0, width: 10, height: 10 })
+
+      scene.$commands.setHidden(parent, true)
+
+      assert.deepEqual(child.getBounds(), { x: 0, y: 0, width: 0, height: 0 })
+    })
+    it('should return null for a node not in the scene graph', () => {
+      assert.isNull(scene.createNode('box').getBounds())
+    })
+  })
   describe('style', () => {
     it('should be an instance of Style', () => {
       const node = scene.createNode('box')
@@ -183,6 +222,36 @@ describe('SceneNode', () => {
       }
     })
   })
+  describe('scene graph mutations', () => {
+    it('should be applied to the native scene on the next frame', () => {
+      const node = scene.createNode('box')
+
+      node.appendChild(scene.createNode('img'))
+      node.insertBefore(scene.createNode('img'), node.children[0])
+      node.removeChild(node.children[1])
+      assert.equal(scene.$commands.length, 3)
+
+      scene.$frame(0, 0)
+
+      assert.equal(scene.$commands.length, 0)
+    })
+    it('should destroy a subtree with pending mutations', () => {
+      const node = addBoxToRoot()
+
+      node.appendChild(scene.createNode('img'))
+      node.destroy()
+
+      assert.doesNotThrow(() => scene.$commands.flush())
+      assert.lengthOf(scene.root.children, 0)
+    })
+    it('should throw Error when adding a node of another type', () => {
+      const node = scene.createNode('box')
+
+      for (const input of [scene.root, { $id: 1, $native: {} }]) {
+        assert.throws(() => node.appendChild(input))
+      }
+    })
+  })
   const addBoxToRoot = (props = {}) => {
     const box = scene.createNode('box')
 
@@ -0,0 +1,161 @@
+/*
+ * Copyright (c) 2021 Light Source Software, LLC. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on
+ * an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the
+ * specific language governing permissions and limitations under the License.
+ */
+
+import chai from 'chai'
+import { afterSceneTest, beforeSceneTest, createBox } from '../test-env.mjs'
+
+const { assert } = chai
+
+describe('SceneObserver', () => {
+  let scene
+  let observer
+  let entries
+  const callback = (e) => { entries.push(...e) }
+  beforeEach(() => {
+    scene = beforeSceneTest()
+    scene.$attach()
+    entries = []
+  })
+  afterEach(() => {
+    observer?.disconnect()
+    observer = null
+    scene = afterSceneTest()
+  })
+  describe('createResizeObserver()', () => {
+    it('should report the initial size of an observed node', () => {
+      const node = createBox(scene, 0, 0, 100, 50)
+
+      scene.root.appendChild(node)
+      observer = scene.createResizeObserver(callback)
+      observer.observe(node)
+      scene.$frame(0, 0)
+
+      assert.deepEqual(entries, [{ target: node, width: 100, height: 50 }])
+    })
+    it('should report only size changes', () => {
+      const node = createBox(scene, 0, 0, 100, 50)
+
+      scene.root.appendChild(node)
+      observer = scene.createResizeObserver(callback)
+      observer.observe(node)
+      scene.$frame(0, 0)
+      entries = []
+
+      node.style.left = 10
+      scene.$frame(0, 0)
+
+      assert.lengthOf(entries, 0)
+
+      node.style.width = 200
+      scene.$frame(0, 0)
+
+      assert.deepEqual(entries, [{ target: node, width: 200, height: 50 }])
+    })
+    it('should not report after unobserve', () => {
+      const node = createBox(scene, 0, 0, 100, 50)
+
+      scene.root.appendChild(node)
+      observer = scene.createResizeObserver(callback)
+      observer.observe(node)
+      observer.unobserve(node)
+      scene.$frame(0, 0)
+
+      assert.lengthOf(entries, 0)
+    })
+    it('should throw if callback is not a function', () => {
+      assert.throws(() => scene.createResizeObserver(null))
+    })
+  })
+  describe('createIntersectionObserver()', () => {
+    it('should report when a node enters and leaves the viewport', () => {
+      const node = createBox(scene, -200, 0, 100, 100)
+
+      scene.root.appendChild(node)
+      observer = scene.createIntersectionObserver(callback)
+      observer.observe(node)
+      scene.$frame(0, 0)
+
+      assert.lengthOf(entries, 1)
+      assert.isFalse(entries[0].isIntersecting)
+
+      node.style.left = 0
+      scene.$frame(0, 0)
+
+      assert.lengthOf(entries, 2)
+      assert.isTrue(entries[1].isIntersecting)
+      assert.equal(entries[1].intersectionRatio, 1)
+      assert.deepEqual(entries[1].boundingRect, { x: 0, y: 0, width: 100, height: 100 })
+
+      node.style.left = 10
+      scene.$frame(0, 0)
+
+      assert.lengthOf(entries, 2)
+    })
+    it('should report threshold crossings', () => {
+      const node = createBox(scene, -50, 0, 100, 100)
+
+      scene.root.appendChild(node)
+      observer = scene.createIntersectionObserver(callback, { threshold: [0.25, 0.75] })
+      observer.observe(node)
+      scene.$frame(0, 0)
+
+      assert.equal(entries[0].intersectionRatio, 0.5)
+
+      node.style.left = -10
+      scene.$frame(0, 0)
+
+      assert.lengthOf(entries, 2)
+      assert.closeTo(entries[1].intersectionRatio, 0.9, 0.001)
+    })
+    it('should clip nodes to the boxes of overflow hidden ancestors', () => {
+      const container = createBox(scene, 0, 0, 100, 100)
+      const node = createBox(scene, 50, 0, 100, 100)
+
+      container.style.overflow = 'hidden'
+      container.appendChild(node)
+      scene.root.appendChild(container)
+      observer = scene.createIntersectionObserver(callback, { threshold: [0.25, 0.75] })
+      observer.observe(node)
+      scene.$frame(0, 0)
+
+      assert.lengthOf(entries, 1)
+      assert.equal(entries[0].intersectionRatio, 0.5)
+
+      node.style.left = 100
+      scene.$frame(0, 0)
+
+      assert.lengthOf(entries, 2)
+      assert.isFalse(entries[1].isIntersecting)
+
+      container.style.overflow = 'visible'
+      scene.$frame(0, 0)
+
+      assert.lengthOf(entries, 3)
+      assert.equal(entries[2].intersectionRatio, 1)
+    })
+  })
+  describe('disconnect()', () => {
+    it('should stop reporting', () => {
+      const node = createBox(scene, 0, 0, 100, 50)
+
+      scene.root.appendChild(node)
+      observer = scene.createResizeObserver(callback)
+      observer.observe(node)
+      observer.disconnect()
+      scene.$frame(0, 0)
+
+      assert.lengthOf(entries, 0)
+      assert.throws(() => observer.observe(node))
+    })
+  })
+})
@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2021 Light Source Software, LLC. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on
+ * an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the
+ * specific language governing permissions and limitations under the License.
+ */
+
+import chai from 'chai'
+import { SpatialWaypoint } from '../../src/scene/SpatialWaypoint.mjs'
+import { afterSceneTest, beforeSceneTest } from '../test-env.mjs'
+import { Key } from '../../src/input/Key.mjs'
+import { createKeyDownEvent } from '../../src/event/index.mjs'
+import { eventCapturePhase } from '../../src/event/eventCapturePhase.mjs'
+import { Direction } from '../../src/input/Direction.mjs'
+
+const { assert } = chai
+
+describe('SpatialWaypoint', () => {
+  let scene
+  let grid
+  beforeEach(() => {
+    scene = beforeSceneTest()
+    grid = setupGrid(scene, 3, 3)
+  })
+  afterEach(() => {
+    scene = afterSceneTest()
+  })
+  describe('navigation', () => {
+    it('should move to the adjacent cell in each direction', () => {
+      for (const [direction, row, column] of [
+        [Direction.RIGHT, 1, 2],
+        [Direction.DOWN, 2, 2],
+        [Direction.LEFT, 2, 1],
+        [Direction.UP, 1, 1]]) {
+        navigate(scene, direction)
+        assert.strictEqual(scene.activeNode, grid.cells[row][column])
+      }
+    })
+    it('should stay on the edge cell when there is no cell in direction', () => {
+      grid.cells[0][2].focus()
+      navigate(scene, Direction.RIGHT)
+      assert.strictEqual(scene.activeNode, grid.cells[0][2])
+      navigate(scene, Direction.UP)
+      assert.strictEqual(scene.activeNode, grid.cells[0][2])
+    })
+    it('should skip nodes that are not focusable', () => {
+      grid.cells[1][2].focusable = false
+      grid.cells[0][2].focusable = false
+      navigate(scene, Direction.RIGHT)
+      assert.strictEqual(scene.activeNode, grid.cells[2][2])
+    })
+  })
+  describe('$findFocus()', () => {
+    it('should return the first focusable node when from is null', () => {
+      assert.strictEqual(scene.$findFocus(null, Direction.RIGHT, grid.group), grid.cells[0][0])
+    })
+    it('should only return nodes within the given subtree', () => {
+      const other = scene.createNode('box')
+
+      other.focusable = true
+      setBox(other, 1000, 60)
+      scene.root.appendChild(other)
+
+      assert.strictEqual(scene.$findFocus(grid.cells[1][2], Direction.RIGHT), other)
+      assert.isNull(scene.$findFocus(grid.cells[1][2], Direction.RIGHT, grid.group))
+    })
+  })
+})
+
+const navigate = (scene, direction) =>
+  eventCapturePhase(scene.activeNode, direction, createKeyDownEvent(null, Key.DPAD_RIGHT, false))
+
+const setBox = (node, left, top) => {
+  const { style } = node
+
+  style.position = 'absolute'
+  style.left = left
+  style.top = top
+  style.width = 100
+  style.height = 50
+}
+
+const setupGrid = (scene, rows, columns) => {
+  const group = scene.createNode('box')
+  const cells = []
+
+  group.waypoint = new SpatialWaypoint()
+
+  for (let row = 0; row < rows; row++) {
+    cells.push([])
+
+    for (let column = 0; column < columns; column++) {
+      const cell = scene.createNode('box')
+
+      cell.focusable = true
+      setBox(cell, column * 110, row * 60)
+      group.appendChild(cell)
+      cells[row].push(cell)
+    }
+  }
+
+  scene.root.appendChild(group)
+  cells[1][1].focus()
+
+  return { group, cells }
+}
@@ -23,7 +23,10 @@ describe('waypoint()', () => {
   it('should return a waypoint when given a "vertical" tag', () => {
     assert.equal(waypoint('vertical').tag, 'vertical')
   })
-  it('should throw Error when tag is not "vertical" or "horizontal"', () => {
+  it('should return a waypoint when given a "spatial" tag', () => {
+    assert.equal(waypoint('spatial').tag, 'spatial')
+  })
+  it('should throw Error when tag is not "vertical", "horizontal" or "spatial"', () => {
     for (const input of ['test', '', null, undefined, {}, 3]) {
       assert.throws(() => waypoint(input))
     }
@@ -123,6 +123,19 @@ describe('SystemManager', () => {
         assert.throws(() => system.$createGraphicsContext({ height }))
       }
     })
+    it('should pass renderer to plugin', () => {
+      system.$createGraphicsContext({ renderer: 'software' })
+      assert.equal(plugin.createGraphicsContextSpy.firstCall.args[0].renderer, 'software')
+      plugin.createGraphicsContextSpy.resetHistory()
+
+      system.$createGraphicsContext({ renderer: 'auto' })
+      assert.equal(plugin.createGraphicsContextSpy.firstCall.args[0].renderer, '')
+    })
+    it('should throw error for invalid renderer', () => {
+      for (const renderer of ['gl', null, '', [], {}, NaN]) {
+        assert.throws(() => system.$createGraphicsContext({ renderer }))
+      }
+    })
   })
   describe('$destroy()', () => {
     it('should clear displays after destroy', () => {
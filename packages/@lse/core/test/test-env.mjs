@@ -64,6 +64,14 @@ export const beforeSceneTest = () => {
   return test.scene
 }
 
+export const createBox = (scene, left, top, width, height) => {
+  const node = scene.createNode('box')
+
+  Object.assign(node.style, { position: 'absolute', left, top, width, height })
+
+  return node
+}
+
 export const afterSceneTest = () => {
   // TODO: active node should be cleaned up automatically
   test.scene.$setActiveNode(null)
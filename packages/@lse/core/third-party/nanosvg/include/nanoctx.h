@@ -18,6 +18,10 @@
 typedef void* nctx;
 
 // Expose a Canvas Context2D like API.
+//
+// Paths are built from sub-paths. A sub-path starts with move_to and is committed to the current path with
+// close_path or end_path. fill and stroke turn the committed sub-paths into a shape using the current paint
+// attributes. Colors are 0xBBGGRR (nanosvg byte order) with opacity specified separately.
 
 nctx nctx_new(int32_t width, int32_t height);
 void nctx_delete(nctx ctx);
@@ -27,10 +31,15 @@ void nctx_line_to(nctx ctx, float x, float y);
 void nctx_cubic_bezier_to(nctx ctx, float cp1x, float cp1y, float cp2x, float cp2y, float x, float y);
 void nctx_begin_path(nctx ctx);
 void nctx_close_path(nctx ctx);
+void nctx_end_path(nctx ctx);
 void nctx_fill(nctx ctx);
 void nctx_stroke(nctx ctx);
 void nctx_set_fill_color(nctx ctx, uint32_t color);
 void nctx_set_fill_opacity(nctx ctx, float opacity);
 void nctx_set_stroke_opacity(nctx ctx, float opacity);
 void nctx_set_stroke_color(nctx ctx, uint32_t color);
-void nctx_set_stroke_width(nctx ctx, uint32_t color);
+void nctx_set_stroke_width(nctx ctx, float width);
+void nctx_set_stroke_line_cap(nctx ctx, int32_t lineCap);
+void nctx_set_stroke_line_join(nctx ctx, int32_t lineJoin);
+void nctx_set_stroke_miter_limit(nctx ctx, float miterLimit);
+void nctx_set_fill_rule(nctx ctx, int32_t fillRule);
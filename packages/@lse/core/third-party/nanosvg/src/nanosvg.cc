@@ -65,7 +65,12 @@ void nctx_render(nctx ctx, uint8_t* data, int32_t width, int32_t height, int32_t
 
 void nctx_move_to(nctx ctx, float x, float y) {
   if (ctx) {
-    nsvg__moveTo(static_cast<NSVGparser*>(ctx), x, y);
+    auto parser{static_cast<NSVGparser*>(ctx)};
+
+    // commit the pending sub-path, if any, before starting a new one
+    nsvg__addPath(parser, 0);
+    nsvg__resetPath(parser);
+    nsvg__moveTo(parser, x, y);
   }
 }
 
@@ -89,7 +94,19 @@ void nctx_begin_path(nctx ctx) {
 
 void nctx_close_path(nctx ctx) {
   if (ctx) {
-    nsvg__addPath(static_cast<NSVGparser*>(ctx), 1);
+    auto parser{static_cast<NSVGparser*>(ctx)};
+
+    nsvg__addPath(parser, 1);
+    nsvg__resetPath(parser);
+  }
+}
+
+void nctx_end_path(nctx ctx) {
+  if (ctx) {
+    auto parser{static_cast<NSVGparser*>(ctx)};
+
+    nsvg__addPath(parser, 0);
+    nsvg__resetPath(parser);
   }
 }
 
@@ -133,7 +150,7 @@ void nctx_set_fill_opacity(nctx ctx, float opacity) {
 
 void nctx_set_stroke_opacity(nctx ctx, float opacity) {
   if (ctx) {
-    nsvg__getAttr(static_cast<NSVGparser*>(ctx))->fillOpacity = opacity;
+    nsvg__getAttr(static_cast<NSVGparser*>(ctx))->strokeOpacity = opacity;
   }
 }
 
@@ -143,8 +160,32 @@ void nctx_set_stroke_color(nctx ctx, uint32_t color) {
   }
 }
 
-void nctx_set_stroke_width(nctx ctx, uint32_t color) {
+void nctx_set_stroke_width(nctx ctx, float width) {
+  if (ctx) {
+    nsvg__getAttr(static_cast<NSVGparser*>(ctx))->strokeWidth = width;
+  }
+}
+
+void nctx_set_stroke_line_cap(nctx ctx, int32_t lineCap) {
+  if (ctx) {
+    nsvg__getAttr(static_cast<NSVGparser*>(ctx))->strokeLineCap = static_cast<char>(lineCap);
+  }
+}
+
+void nctx_set_stroke_line_join(nctx ctx, int32_t lineJoin) {
+  if (ctx) {
+    nsvg__getAttr(static_cast<NSVGparser*>(ctx))->strokeLineJoin = static_cast<char>(lineJoin);
+  }
+}
+
+void nctx_set_stroke_miter_limit(nctx ctx, float miterLimit) {
+  if (ctx) {
+    nsvg__getAttr(static_cast<NSVGparser*>(ctx))->miterLimit = miterLimit;
+  }
+}
+
+void nctx_set_fill_rule(nctx ctx, int32_t fillRule) {
   if (ctx) {
-    nsvg__getAttr(static_cast<NSVGparser*>(ctx))->strokeWidth = color;
+    nsvg__getAttr(static_cast<NSVGparser*>(ctx))->fillRule = static_cast<char>(fillRule);
   }
 }